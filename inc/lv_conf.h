@@ -153,15 +153,43 @@ typedef void * lv_anim_user_data_t;
 #endif
 
 /* 1: Enable shadow drawing on rectangles*/
-#define LV_USE_SHADOW           0
+#define LV_USE_SHADOW           1
 #if LV_USE_SHADOW
 /* Allow buffering some shadow calculation
  * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
  * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
-#define LV_SHADOW_CACHE_SIZE    0
+ * Caching has 2 * shadow size^2 RAM cost for every buffered shadow*/
+#define LV_SHADOW_CACHE_SIZE    64
+
+/* Number of different shadows to buffer.
+ * The least recently used shadow is dropped to make room for a new one*/
+#define LV_SHADOW_CACHE_NUM     4
 #endif
 
+/* Buffer the anti-aliased corner coverage of rounded rectangles.
+ * LV_RADIUS_MASK_CACHE_SIZE is the RAM (in bytes) the cached corners can use together.
+ * A corner with `radius` costs `radius^2` bytes. 0: disable the caching*/
+#define LV_RADIUS_MASK_CACHE_SIZE    4096
+
+/* Buffer the corners of rectangles' background, border and outline as nine-slices.
+ * LV_RECT_SLICE_CACHE_SIZE is the RAM (in bytes) the slices can use together.
+ * A slice costs `2 * radius * max(radius, border_width)` bytes. 0: disable the caching*/
+#define LV_RECT_SLICE_CACHE_SIZE    8192
+
+/* Buffer the colors of gradients between the frames.
+ * LV_GRAD_CACHE_SIZE is the RAM (in bytes) the buffered gradients can use together.
+ * A gradient costs its length (width or height of the object) * `sizeof(lv_color_t)` bytes
+ * (+ 6 bytes per pixel with LV_GRAD_DITHER). 0: calculate the gradients on every draw*/
+#define LV_GRAD_CACHE_SIZE    2048
+
+/*1: Use ordered dithering on gradients to avoid banding with 16 bit color depth*/
+#define LV_GRAD_DITHER        0
+
+/* Buffer which pixels of arcs' rings are covered in each line so only those are masked and blended.
+ * LV_ARC_SPAN_CACHE_SIZE is the RAM (in bytes) the buffered rings can use together.
+ * A ring costs `radius * 8` bytes. 0: mask the whole lines of the rings*/
+#define LV_ARC_SPAN_CACHE_SIZE    4096
+
 /*1: enable outline drawing on rectangles*/
 #define LV_USE_OUTLINE  1
 
@@ -178,7 +206,7 @@ typedef void * lv_anim_user_data_t;
 #define LV_USE_OPA_SCALE        0
 
 /* 1: Use image zoom and rotation*/
-#define LV_USE_IMG_TRANSFORM    0
+#define LV_USE_IMG_TRANSFORM    1
 
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
@@ -207,10 +235,30 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #define LV_USE_GPU_NXP_VG_LITE   0
 
 /* 1: Enable file system (might be required for images */
-#define LV_USE_FILESYSTEM       0
+#define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_fs_drv_user_data_t;
+
+/* 1: Register a driver for POSIX files in `lv_init()`.
+ * E.g. "S:folder/file.png" opens LV_FS_POSIX_PATH "folder/file.png" */
+#define LV_USE_FS_POSIX         1
+#if LV_USE_FS_POSIX
+#  define LV_FS_POSIX_LETTER        'S'
+#  define LV_FS_POSIX_PATH          "/"
+/* Size of the read-ahead buffer of the files opened for reading [bytes].
+ * Smaller reads are served from it with one large read. 0: don't buffer the reads*/
+#  define LV_FS_POSIX_CACHE_SIZE    (4U * 1024U)
+/* Number of files kept open after closing them so opening them again needs no system call.
+ * Call `lv_fs_posix_cache_clean()` if the files are changed by other means than `lv_fs`. 0: close the files*/
+#  define LV_FS_POSIX_HANDLE_CACHE  4
+/* 1: Let `lv_fs_map()` map the files with mmap() to use them without copying*/
+#  if defined(__3DS__) || defined(_WIN32)
+#    define LV_FS_POSIX_MMAP        0
+#  else
+#    define LV_FS_POSIX_MMAP        1
+#  endif
+#endif
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -239,7 +287,27 @@ typedef void * lv_fs_drv_user_data_t;
  * With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  * However the opened images might consume additional RAM.
  * Set it to 0 to disable caching */
-#define LV_IMG_CACHE_DEF_SIZE       0
+#define LV_IMG_CACHE_DEF_SIZE       16
+
+/* RAM (in bytes) the cached images can use together. The images are dropped with regard to
+ * how long ago they were used and how long it took to open them (`time_to_open`).
+ * Images larger than this are opened on every draw. 0: limit only the number of images */
+#define LV_IMG_CACHE_MEM_SIZE       (256U * 1024U)
+
+/* Keep transformed (zoomed/rotated) copies of images which are drawn with the same zoom and angle repeatedly.
+ * LV_IMG_TRANSFORM_CACHE_SIZE is the RAM (in bytes) the transformed copies can use together.
+ * A copy costs 3 bytes per pixel of the transformed area. 0: transform the images in every redraw*/
+#define LV_IMG_TRANSFORM_CACHE_SIZE (64U * 1024U)
+
+/* 1: Enable the PNG decoder. It opens "*.png" files and `LV_IMG_CF_RAW...` variables containing PNG data.
+ * The rows are decoded when they are drawn so only the inflate state (at most 32 kB) is kept in the RAM.
+ * The whole image is decoded when it's opened if it fits into the image cache's RAM budget*/
+#define LV_USE_PNG                  1
+
+/* 1: Enable the RLE image decoder. It opens "*.rle" files and `LV_IMG_CF_RAW...` variables converted by `tools/img_rle_conv.c`.
+ * Any row can be decoded directly so only the row offset table is kept in the RAM.
+ * The whole image is decoded when it's opened if it fits into the image cache's RAM budget*/
+#define LV_USE_RLE                  1
 
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
@@ -436,6 +504,36 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  */
 #define LV_USE_FONT_COMPRESSED 1
 
+/* RAM budget of the decompressed glyph cache of each compressed font [bytes].
+ * The most recently used glyphs are kept decompressed. 0: disable the cache*/
+#define LV_FONT_GLYPH_CACHE_SIZE    (16U * 1024U)
+
+/* Look up the glyphs of the Basic Multilingual Plane (U+0000..U+FFFF) in a table
+ * instead of searching the cmaps. It's built for each font on the first use,
+ * one 512 byte page for every 256 letters used.*/
+#define LV_USE_FONT_CMAP_TABLE      1
+
+/* Cache the kerning values of the fonts with kerning pairs (the fonts with
+ * kerning classes look them up directly).
+ * LV_FONT_KERN_CACHE_SIZE: number of recently used glyph pairs (power of 2, 0: disable)
+ * LV_FONT_KERN_ASCII_TABLE: 1: keep a 95 x 95 table of the printable ASCII pairs*/
+#define LV_FONT_KERN_CACHE_SIZE     256
+#define LV_FONT_KERN_ASCII_TABLE    1
+
+/* Measure the printable ASCII letters with a table of their widths built on
+ * the first use (95 bytes per font or 95 x 95 bytes if the font has kerning)*/
+#define LV_FONT_ASCII_WIDTHS        1
+
+/* Remember which font of the fallback chain (`lv_font_t.fallback`) has the
+ * recently used letters. Number of letters (power of 2, 0: search every time)*/
+#define LV_FONT_FALLBACK_CACHE_SIZE 256
+
+/* Fonts loaded with `lv_font_load_lazy()` keep the glyph bitmaps in the file
+ * and read them in pages on demand. Set the page size and the RAM budget
+ * of the page cache of one font [bytes].*/
+#define LV_FONT_LAZY_PAGE_SIZE      (1U * 1024U)
+#define LV_FONT_LAZY_CACHE_SIZE     (32U * 1024U)
+
 /* Enable subpixel rendering */
 #define LV_USE_FONT_SUBPX 1
 #if LV_USE_FONT_SUBPX
@@ -650,8 +748,14 @@ typedef void * lv_obj_user_data_t;
 /*Enable selecting text of the label */
 #  define LV_LABEL_TEXT_SEL               0
 
-/*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
-#  define LV_LABEL_LONG_TXT_HINT          0
+/*Keep a line table (byte offset and width of each line) in labels so redraws and
+ * letter position queries don't measure the text again. Costs 8 bytes per line*/
+#  define LV_LABEL_LONG_TXT_HINT          1
+
+/*Memory budget [bytes] of the pre-rendered texts of labels with `lv_label_set_cache(label, true)`.
+ * The least recently used texts are freed to stay in it but not the ones drawn in the same refresh:
+ * the texts which don't fit next to them are drawn without the cache. 0: disable*/
+#  define LV_LABEL_CACHE_SIZE             (64U * 1024U)
 #endif
 
 /*LED (dependencies: -)*/
@@ -401,7 +401,7 @@
 /* Allow buffering some shadow calculation
  * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
  * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ * Caching has 2 * shadow size^2 RAM cost for every buffered shadow*/
 #ifndef LV_SHADOW_CACHE_SIZE
 #  ifdef CONFIG_LV_SHADOW_CACHE_SIZE
 #    define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -409,6 +409,72 @@
 #    define  LV_SHADOW_CACHE_SIZE    0
 #  endif
 #endif
+
+/* Number of different shadows to buffer if LV_SHADOW_CACHE_SIZE > 0.
+ * The least recently used shadow is dropped to make room for a new one*/
+#ifndef LV_SHADOW_CACHE_NUM
+#  ifdef CONFIG_LV_SHADOW_CACHE_NUM
+#    define LV_SHADOW_CACHE_NUM CONFIG_LV_SHADOW_CACHE_NUM
+#  else
+#    define  LV_SHADOW_CACHE_NUM    4
+#  endif
+#endif
+#endif
+
+/* Buffer the anti-aliased corner coverage of rounded rectangles.
+ * LV_RADIUS_MASK_CACHE_SIZE is the RAM (in bytes) the cached corners can use together.
+ * A corner with `radius` costs `radius^2` bytes. The least recently used corners are dropped
+ * to make room for new ones. 0: disable the caching*/
+#ifndef LV_RADIUS_MASK_CACHE_SIZE
+#  ifdef CONFIG_LV_RADIUS_MASK_CACHE_SIZE
+#    define LV_RADIUS_MASK_CACHE_SIZE CONFIG_LV_RADIUS_MASK_CACHE_SIZE
+#  else
+#    define  LV_RADIUS_MASK_CACHE_SIZE    4096
+#  endif
+#endif
+
+/* Buffer the corners of rectangles' background, border and outline as nine-slices.
+ * The corners are rendered once per radius and border width and reused by rectangles with any size and color.
+ * LV_RECT_SLICE_CACHE_SIZE is the RAM (in bytes) the slices can use together.
+ * A slice costs `2 * radius * max(radius, border_width)` bytes. 0: disable the caching*/
+#ifndef LV_RECT_SLICE_CACHE_SIZE
+#  ifdef CONFIG_LV_RECT_SLICE_CACHE_SIZE
+#    define LV_RECT_SLICE_CACHE_SIZE CONFIG_LV_RECT_SLICE_CACHE_SIZE
+#  else
+#    define  LV_RECT_SLICE_CACHE_SIZE    8192
+#  endif
+#endif
+
+/* Buffer the colors of gradients between the frames.
+ * LV_GRAD_CACHE_SIZE is the RAM (in bytes) the buffered gradients can use together.
+ * A gradient costs its length (width or height of the object) * `sizeof(lv_color_t)` bytes
+ * (+ 6 bytes per pixel with LV_GRAD_DITHER). 0: calculate the gradients on every draw*/
+#ifndef LV_GRAD_CACHE_SIZE
+#  ifdef CONFIG_LV_GRAD_CACHE_SIZE
+#    define LV_GRAD_CACHE_SIZE CONFIG_LV_GRAD_CACHE_SIZE
+#  else
+#    define  LV_GRAD_CACHE_SIZE    2048
+#  endif
+#endif
+
+/*1: Use ordered dithering on gradients to avoid banding with 16 bit color depth*/
+#ifndef LV_GRAD_DITHER
+#  ifdef CONFIG_LV_GRAD_DITHER
+#    define LV_GRAD_DITHER CONFIG_LV_GRAD_DITHER
+#  else
+#    define  LV_GRAD_DITHER    0
+#  endif
+#endif
+
+/* Buffer which pixels of arcs' rings are covered in each line so only those are masked and blended.
+ * LV_ARC_SPAN_CACHE_SIZE is the RAM (in bytes) the buffered rings can use together.
+ * A ring costs `radius * 8` bytes. 0: mask the whole lines of the rings*/
+#ifndef LV_ARC_SPAN_CACHE_SIZE
+#  ifdef CONFIG_LV_ARC_SPAN_CACHE_SIZE
+#    define LV_ARC_SPAN_CACHE_SIZE CONFIG_LV_ARC_SPAN_CACHE_SIZE
+#  else
+#    define  LV_ARC_SPAN_CACHE_SIZE    4096
+#  endif
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -542,6 +608,58 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #endif
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
+
+/* 1: Register a driver for POSIX files in `lv_init()`.
+ * E.g. "S:folder/file.png" opens LV_FS_POSIX_PATH "folder/file.png" */
+#ifndef LV_USE_FS_POSIX
+#  ifdef CONFIG_LV_USE_FS_POSIX
+#    define LV_USE_FS_POSIX CONFIG_LV_USE_FS_POSIX
+#  else
+#    define  LV_USE_FS_POSIX         0
+#  endif
+#endif
+#if LV_USE_FS_POSIX
+#ifndef LV_FS_POSIX_LETTER
+#  ifdef CONFIG_LV_FS_POSIX_LETTER
+#    define LV_FS_POSIX_LETTER CONFIG_LV_FS_POSIX_LETTER
+#  else
+#    define  LV_FS_POSIX_LETTER        'S'
+#  endif
+#endif
+#ifndef LV_FS_POSIX_PATH
+#  ifdef CONFIG_LV_FS_POSIX_PATH
+#    define LV_FS_POSIX_PATH CONFIG_LV_FS_POSIX_PATH
+#  else
+#    define  LV_FS_POSIX_PATH          "/"
+#  endif
+#endif
+/* Size of the read-ahead buffer of the files opened for reading [bytes].
+ * Smaller reads are served from it with one large read. 0: don't buffer the reads*/
+#ifndef LV_FS_POSIX_CACHE_SIZE
+#  ifdef CONFIG_LV_FS_POSIX_CACHE_SIZE
+#    define LV_FS_POSIX_CACHE_SIZE CONFIG_LV_FS_POSIX_CACHE_SIZE
+#  else
+#    define  LV_FS_POSIX_CACHE_SIZE    (4U * 1024U)
+#  endif
+#endif
+/* Number of files kept open after closing them so opening them again needs no system call.
+ * Call `lv_fs_posix_cache_clean()` if the files are changed by other means than `lv_fs`. 0: close the files*/
+#ifndef LV_FS_POSIX_HANDLE_CACHE
+#  ifdef CONFIG_LV_FS_POSIX_HANDLE_CACHE
+#    define LV_FS_POSIX_HANDLE_CACHE CONFIG_LV_FS_POSIX_HANDLE_CACHE
+#  else
+#    define  LV_FS_POSIX_HANDLE_CACHE  4
+#  endif
+#endif
+/* 1: Let `lv_fs_map()` map the files with mmap() to use them without copying*/
+#ifndef LV_FS_POSIX_MMAP
+#  ifdef CONFIG_LV_FS_POSIX_MMAP
+#    define LV_FS_POSIX_MMAP CONFIG_LV_FS_POSIX_MMAP
+#  else
+#    define  LV_FS_POSIX_MMAP          0
+#  endif
+#endif
+#endif
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -614,6 +732,50 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* RAM (in bytes) the cached images can use together. The images are dropped with regard to
+ * how long ago they were used and how long it took to open them (`time_to_open`).
+ * Images larger than this are opened on every draw. 0: limit only the number of images */
+#ifndef LV_IMG_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_IMG_CACHE_MEM_SIZE
+#    define LV_IMG_CACHE_MEM_SIZE CONFIG_LV_IMG_CACHE_MEM_SIZE
+#  else
+#    define  LV_IMG_CACHE_MEM_SIZE       0
+#  endif
+#endif
+
+/* Keep transformed (zoomed/rotated) copies of images which are drawn with the same zoom and angle repeatedly.
+ * LV_IMG_TRANSFORM_CACHE_SIZE is the RAM (in bytes) the transformed copies can use together.
+ * A copy costs 3 bytes per pixel of the transformed area. 0: transform the images in every redraw*/
+#ifndef LV_IMG_TRANSFORM_CACHE_SIZE
+#  ifdef CONFIG_LV_IMG_TRANSFORM_CACHE_SIZE
+#    define LV_IMG_TRANSFORM_CACHE_SIZE CONFIG_LV_IMG_TRANSFORM_CACHE_SIZE
+#  else
+#    define  LV_IMG_TRANSFORM_CACHE_SIZE (64U * 1024U)
+#  endif
+#endif
+
+/* 1: Enable the PNG decoder. It opens "*.png" files and `LV_IMG_CF_RAW...` variables containing PNG data.
+ * The rows are decoded when they are drawn so only the inflate state (at most 32 kB) is kept in the RAM.
+ * The whole image is decoded when it's opened if it fits into the image cache's RAM budget*/
+#ifndef LV_USE_PNG
+#  ifdef CONFIG_LV_USE_PNG
+#    define LV_USE_PNG CONFIG_LV_USE_PNG
+#  else
+#    define  LV_USE_PNG                  0
+#  endif
+#endif
+
+/* 1: Enable the RLE image decoder. It opens "*.rle" files and `LV_IMG_CF_RAW...` variables converted by `tools/img_rle_conv.c`.
+ * Any row can be decoded directly so only the row offset table is kept in the RAM.
+ * The whole image is decoded when it's opened if it fits into the image cache's RAM budget*/
+#ifndef LV_USE_RLE
+#  ifdef CONFIG_LV_USE_RLE
+#    define LV_USE_RLE CONFIG_LV_USE_RLE
+#  else
+#    define  LV_USE_RLE                  0
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -1116,6 +1278,84 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* RAM budget of the decompressed glyph cache of each compressed font [bytes].
+ * The most recently used glyphs are kept decompressed. 0: disable the cache*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#    define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#  else
+#    define  LV_FONT_GLYPH_CACHE_SIZE    (16U * 1024U)
+#  endif
+#endif
+
+/* Look up the glyphs of the Basic Multilingual Plane (U+0000..U+FFFF) in a table
+ * instead of searching the cmaps. It's built for each font on the first use,
+ * one 512 byte page for every 256 letters used.*/
+#ifndef LV_USE_FONT_CMAP_TABLE
+#  ifdef CONFIG_LV_USE_FONT_CMAP_TABLE
+#    define LV_USE_FONT_CMAP_TABLE CONFIG_LV_USE_FONT_CMAP_TABLE
+#  else
+#    define  LV_USE_FONT_CMAP_TABLE      1
+#  endif
+#endif
+
+/* Cache the kerning values of the fonts with kerning pairs (the fonts with
+ * kerning classes look them up directly).
+ * LV_FONT_KERN_CACHE_SIZE: number of recently used glyph pairs (power of 2, 0: disable)
+ * LV_FONT_KERN_ASCII_TABLE: 1: keep a 95 x 95 table of the printable ASCII pairs*/
+#ifndef LV_FONT_KERN_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_KERN_CACHE_SIZE
+#    define LV_FONT_KERN_CACHE_SIZE CONFIG_LV_FONT_KERN_CACHE_SIZE
+#  else
+#    define  LV_FONT_KERN_CACHE_SIZE     256
+#  endif
+#endif
+#ifndef LV_FONT_KERN_ASCII_TABLE
+#  ifdef CONFIG_LV_FONT_KERN_ASCII_TABLE
+#    define LV_FONT_KERN_ASCII_TABLE CONFIG_LV_FONT_KERN_ASCII_TABLE
+#  else
+#    define  LV_FONT_KERN_ASCII_TABLE    1
+#  endif
+#endif
+
+/* Measure the printable ASCII letters with a table of their widths built on
+ * the first use (95 bytes per font or 95 x 95 bytes if the font has kerning)*/
+#ifndef LV_FONT_ASCII_WIDTHS
+#  ifdef CONFIG_LV_FONT_ASCII_WIDTHS
+#    define LV_FONT_ASCII_WIDTHS CONFIG_LV_FONT_ASCII_WIDTHS
+#  else
+#    define  LV_FONT_ASCII_WIDTHS        1
+#  endif
+#endif
+
+/* Remember which font of the fallback chain (`lv_font_t.fallback`) has the
+ * recently used letters. Number of letters (power of 2, 0: search every time)*/
+#ifndef LV_FONT_FALLBACK_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_FALLBACK_CACHE_SIZE
+#    define LV_FONT_FALLBACK_CACHE_SIZE CONFIG_LV_FONT_FALLBACK_CACHE_SIZE
+#  else
+#    define  LV_FONT_FALLBACK_CACHE_SIZE 256
+#  endif
+#endif
+
+/* Fonts loaded with `lv_font_load_lazy()` keep the glyph bitmaps in the file
+ * and read them in pages on demand. Set the page size and the RAM budget
+ * of the page cache of one font [bytes].*/
+#ifndef LV_FONT_LAZY_PAGE_SIZE
+#  ifdef CONFIG_LV_FONT_LAZY_PAGE_SIZE
+#    define LV_FONT_LAZY_PAGE_SIZE CONFIG_LV_FONT_LAZY_PAGE_SIZE
+#  else
+#    define  LV_FONT_LAZY_PAGE_SIZE      (1U * 1024U)
+#  endif
+#endif
+#ifndef LV_FONT_LAZY_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_LAZY_CACHE_SIZE
+#    define LV_FONT_LAZY_CACHE_SIZE CONFIG_LV_FONT_LAZY_CACHE_SIZE
+#  else
+#    define  LV_FONT_LAZY_CACHE_SIZE     (32U * 1024U)
+#  endif
+#endif
+
 /* Enable subpixel rendering */
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1670,7 +1910,8 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
-/*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
+/*Keep a line table (byte offset and width of each line) in labels so redraws and
+ * letter position queries don't measure the text again. Costs 8 bytes per line*/
 #ifndef LV_LABEL_LONG_TXT_HINT
 #  ifdef CONFIG_LV_LABEL_LONG_TXT_HINT
 #    define LV_LABEL_LONG_TXT_HINT CONFIG_LV_LABEL_LONG_TXT_HINT
@@ -1678,6 +1919,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Memory budget [bytes] of the pre-rendered texts of labels with `lv_label_set_cache(label, true)`.
+ * The least recently used texts are freed to stay in it but not the ones drawn in the same refresh:
+ * the texts which don't fit next to them are drawn without the cache. 0: disable*/
+#ifndef LV_LABEL_CACHE_SIZE
+#  ifdef CONFIG_LV_LABEL_CACHE_SIZE
+#    define LV_LABEL_CACHE_SIZE CONFIG_LV_LABEL_CACHE_SIZE
+#  else
+#    define  LV_LABEL_CACHE_SIZE             (32U * 1024U)
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -18,6 +18,7 @@
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_async.h"
 #include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_fs_posix.h"
 #include "../lv_misc/lv_gc.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
@@ -177,6 +178,9 @@ void lv_init(void)
 
 #if LV_USE_FILESYSTEM
     _lv_fs_init();
+#if LV_USE_FS_POSIX
+    lv_fs_posix_init();
+#endif
 #endif
 
 #if LV_USE_ANIMATION
@@ -272,6 +272,9 @@ void _lv_disp_refr_task(lv_task_t * task)
 
     _lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
+#if LV_USE_LABEL && LV_LABEL_CACHE_SIZE
+    _lv_draw_label_cache_refr_ready();
+#endif
 
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     static lv_obj_t * perf_label = NULL;
@@ -18,6 +18,8 @@ extern "C" {
 #include "../lv_core/lv_style.h"
 #include "../lv_misc/lv_txt.h"
 #include "lv_img_decoder.h"
+#include "lv_img_png.h"
+#include "lv_img_rle.h"
 
 #include "lv_draw_rect.h"
 #include "lv_draw_label.h"
@@ -9,6 +9,8 @@ CSRCS += lv_draw_triangle.c
 CSRCS += lv_img_decoder.c
 CSRCS += lv_img_cache.c
 CSRCS += lv_img_buf.c
+CSRCS += lv_img_png.c
+CSRCS += lv_img_rle.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_draw
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_draw
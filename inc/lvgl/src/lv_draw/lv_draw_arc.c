@@ -9,17 +9,56 @@
 #include "lv_draw_arc.h"
 #include "lv_draw_rect.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_blend.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_lru.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define SPLIT_RADIUS_LIMIT 10  /*With radius greater then this the arc will drawn in quarters. A quarter is drawn only if there is arc in it */
 #define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define RING_CACHE_ENTRY_NUM  8   /*Max. number of rings (radius and width) whose spans are buffered*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+
+/**
+ * The covered pixels in a line of a ring's left side. Relative to the left side of the ring.
+ * Between `x_solid1` and `x_solid2` both masks of the ring fully cover the pixels
+ * so only the other masks (e.g. the angle mask) need to be applied there.
+ */
+typedef struct {
+    lv_coord_t x_out;       /*The first covered pixel. -1 if the line is not calculated yet*/
+    lv_coord_t x_solid1;    /*The first fully covered pixel*/
+    lv_coord_t x_solid2;    /*The last fully covered pixel. Less than `x_solid1` if there are no such pixels*/
+    lv_coord_t x_in;        /*The last covered pixel. Less than `x_out` if no pixels are covered*/
+} ring_span_t;
+
+/**
+ * The spans of a ring in the lines of its top half.
+ * The bottom half and the right side are mirrored.
+ */
+typedef struct {
+    lv_lru_entry_t lru;
+    ring_span_t * spans;    /*`radius` elements. Calculated when the line is drawn first*/
+    lv_draw_mask_radius_param_t mask_rin_param;     /*The masks of a ring placed to (0;0)*/
+    lv_draw_mask_radius_param_t mask_rout_param;
+    lv_coord_t radius;      /*0: unused entry*/
+    lv_coord_t width;
+} ring_cache_entry_t;
+
+typedef struct {
+    const lv_area_t * area;     /*Outer area of the ring*/
+    lv_draw_mask_radius_param_t * mask_rin;     /*The masks of the ring. Applied after the added masks*/
+    lv_draw_mask_radius_param_t * mask_rout;
+    ring_cache_entry_t * spans; /*Spans of the ring or NULL to process the whole lines*/
+    lv_color_t color;
+    lv_opa_t opa;
+    lv_blend_mode_t blend_mode;
+} ring_draw_dsc_t;
+
 typedef struct {
     lv_coord_t center_x;
     lv_coord_t center_y;
@@ -29,8 +68,7 @@ typedef struct {
     uint16_t start_quarter;
     uint16_t end_quarter;
     lv_coord_t width;
-    lv_draw_rect_dsc_t * draw_dsc;
-    const lv_area_t * draw_area;
+    const ring_draw_dsc_t * ring;
     const lv_area_t * clip_area;
 } quarter_draw_dsc_t;
 
@@ -42,10 +80,23 @@ static void draw_quarter_1(quarter_draw_dsc_t * q);
 static void draw_quarter_2(quarter_draw_dsc_t * q);
 static void draw_quarter_3(quarter_draw_dsc_t * q);
 static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
+#if LV_ARC_SPAN_CACHE_SIZE
+static ring_cache_entry_t * ring_spans_get(lv_coord_t radius, lv_coord_t width);
+static uint32_t ring_cache_size(const void * entry);
+static void ring_cache_free(void * entry);
+#endif
+static const ring_span_t * ring_span_get(ring_cache_entry_t * e, lv_coord_t y);
+static void draw_ring(const ring_draw_dsc_t * ring, const lv_area_t * clip_area);
+static void draw_ring_span(const ring_draw_dsc_t * ring, const lv_area_t * clip_area, const lv_area_t * draw_area,
+                           lv_coord_t x1, lv_coord_t x2, lv_coord_t y, bool solid, lv_opa_t * mask_buf);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_ARC_SPAN_CACHE_SIZE
+static ring_cache_entry_t ring_cache_entries[RING_CACHE_ENTRY_NUM];
+static lv_lru_t ring_cache = _LV_LRU_INIT(ring_cache_entries, LV_ARC_SPAN_CACHE_SIZE, ring_cache_size, ring_cache_free);
+#endif
 
 /**********************
  *      MACROS
@@ -105,6 +156,33 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
 
     int16_t mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
 
+    /* Use the same masks as `lv_draw_rect` would use for the border
+     * but apply them only where the ring is not fully covered*/
+    lv_area_t area_in;
+    area_in.x1 = area.x1 + width;
+    area_in.y1 = area.y1 + width;
+    area_in.x2 = area.x2 - width;
+    area_in.y2 = area.y2 - width;
+
+    lv_draw_mask_radius_param_t mask_rin_param;
+    lv_draw_mask_radius_init(&mask_rin_param, &area_in, radius - width, true);
+
+    lv_draw_mask_radius_param_t mask_rout_param;
+    lv_draw_mask_radius_init(&mask_rout_param, &area, radius, false);
+
+    ring_draw_dsc_t ring;
+    ring.area = &area;
+    ring.mask_rin = &mask_rin_param;
+    ring.mask_rout = &mask_rout_param;
+#if LV_ARC_SPAN_CACHE_SIZE
+    ring.spans = ring_spans_get(radius, width);
+#else
+    ring.spans = NULL;
+#endif
+    ring.color = dsc->color;
+    ring.opa = dsc->opa;
+    ring.blend_mode = dsc->blend_mode;
+
     int32_t angle_gap;
     if(end_angle > start_angle) {
         angle_gap = 360 - (end_angle - start_angle);
@@ -123,8 +201,7 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
         q_dsc.start_quarter = (start_angle / 90) & 0x3;
         q_dsc.end_quarter = (end_angle / 90) & 0x3;
         q_dsc.width = width;
-        q_dsc.draw_dsc =  &cir_dsc;
-        q_dsc.draw_area = &area;
+        q_dsc.ring = &ring;
         q_dsc.clip_area = clip_area;
 
         draw_quarter_0(&q_dsc);
@@ -133,7 +210,7 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius,  uin
         draw_quarter_3(&q_dsc);
     }
     else {
-        lv_draw_rect(&area, clip_area, &cir_dsc);
+        draw_ring(&ring, clip_area);
     }
     lv_draw_mask_remove_id(mask_angle_id);
 
@@ -183,7 +260,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
     else if(q->start_quarter == 0 || q->end_quarter == 0) {
         /*Start and/or end arcs here*/
@@ -195,7 +272,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
         if(q->end_quarter == 0) {
             quarter_area.x2 = q->center_x + q->radius;
@@ -205,7 +282,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
             quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 0 && q->end_angle < q->start_angle) ||
@@ -219,7 +296,7 @@ static void draw_quarter_0(quarter_draw_dsc_t * q)
         quarter_area.y2 = q->center_y + q->radius;
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
 }
 
@@ -236,7 +313,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
     else if(q->start_quarter == 1 || q->end_quarter == 1) {
         /*Start and/or end arcs here*/
@@ -248,7 +325,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
         if(q->end_quarter == 1) {
             quarter_area.x2 = q->center_x - 1;
@@ -258,7 +335,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
             quarter_area.x1 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 1 && q->end_angle < q->start_angle) ||
@@ -272,7 +349,7 @@ static void draw_quarter_1(quarter_draw_dsc_t * q)
         quarter_area.y2 = q->center_y + q->radius;
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
 }
 
@@ -289,7 +366,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         quarter_area.x2 = q->center_x + ((_lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
     else if(q->start_quarter == 2 || q->end_quarter == 2) {
         /*Start and/or end arcs here*/
@@ -301,7 +378,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
         if(q->end_quarter == 2) {
             quarter_area.x1 = q->center_x - q->radius;
@@ -311,7 +388,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
             quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 2 && q->end_angle < q->start_angle) ||
@@ -325,7 +402,7 @@ static void draw_quarter_2(quarter_draw_dsc_t * q)
         quarter_area.y2 = q->center_y - 1;
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
 }
 
@@ -342,7 +419,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
     else if(q->start_quarter == 3 || q->end_quarter == 3) {
         /*Start and/or end arcs here*/
@@ -354,7 +431,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             quarter_area.y1 = q->center_y + ((_lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
         if(q->end_quarter == 3) {
             quarter_area.x1 = q->center_x;
@@ -364,7 +441,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
             quarter_area.y2 = q->center_y + ((_lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
 
             bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-            if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+            if(ok) draw_ring(q->ring, &quarter_area);
         }
     }
     else if((q->start_quarter == q->end_quarter && q->start_quarter != 3 && q->end_angle < q->start_angle) ||
@@ -378,7 +455,7 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
         quarter_area.y2 = q->center_y - 1;
 
         bool ok = _lv_area_intersect(&quarter_area, &quarter_area, q->clip_area);
-        if(ok) lv_draw_rect(q->draw_area, &quarter_area, q->draw_dsc);
+        if(ok) draw_ring(q->ring, &quarter_area);
     }
 }
 
@@ -419,3 +496,219 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness
         res_area->y2 = cir_y + thick_half - thick_corr;
     }
 }
+
+#if LV_ARC_SPAN_CACHE_SIZE
+/**
+ * Get the buffered spans of a ring. Allocate a new entry if the ring is not buffered yet.
+ * @param radius outer radius of the ring
+ * @param width width of the ring
+ * @return the cache entry of the ring or NULL if it can't be buffered
+ */
+static ring_cache_entry_t * ring_spans_get(lv_coord_t radius, lv_coord_t width)
+{
+    uint32_t i;
+    for(i = 0; i < RING_CACHE_ENTRY_NUM; i++) {
+        if(ring_cache_entries[i].radius == radius && ring_cache_entries[i].width == width) {
+            _lv_lru_use(&ring_cache, &ring_cache_entries[i]);
+            return &ring_cache_entries[i];
+        }
+    }
+
+    uint32_t size = radius * sizeof(ring_span_t);
+    ring_cache_entry_t * e = _lv_lru_get_free(&ring_cache, size);
+    if(e == NULL) return NULL;
+
+    e->spans = lv_mem_alloc(size);
+    if(e->spans == NULL) return NULL;
+
+    /* The lines are calculated only when they are drawn first
+     * so a ring which is drawn in parts (e.g. with a small display buffer) doesn't calculate all lines at once*/
+    for(i = 0; i < (uint32_t)radius; i++) e->spans[i].x_out = -1;
+
+    /*Use the same masks as the drawing but on a ring placed to (0;0)*/
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, radius * 2 - 1, radius * 2 - 1);
+    lv_area_t area_in;
+    lv_area_set(&area_in, width, width, radius * 2 - 1 - width, radius * 2 - 1 - width);
+    lv_draw_mask_radius_init(&e->mask_rin_param, &area_in, radius - width, true);
+    lv_draw_mask_radius_init(&e->mask_rout_param, &area, radius, false);
+
+    e->radius = radius;
+    e->width = width;
+    _lv_lru_add(&ring_cache, e);
+
+    return e;
+}
+
+/**
+ * Get the size of the buffered spans of a ring
+ * @param entry pointer to a `ring_cache_entry_t`
+ * @return the size of the spans in bytes. 0: unused entry
+ */
+static uint32_t ring_cache_size(const void * entry)
+{
+    const ring_cache_entry_t * e = entry;
+    return e->radius * sizeof(ring_span_t);
+}
+
+/**
+ * Free the buffered spans of a ring
+ * @param entry pointer to a `ring_cache_entry_t`
+ */
+static void ring_cache_free(void * entry)
+{
+    ring_cache_entry_t * e = entry;
+    lv_mem_free(e->spans);
+    e->spans = NULL;
+    e->radius = 0;
+}
+#endif
+
+/**
+ * Get the span of a line in the top half of a ring. Calculate it if it's not calculated yet.
+ * @param e pointer to the cache entry of the ring
+ * @param y the line relative to the top of the ring (0..radius-1)
+ * @return the span of the line
+ */
+static const ring_span_t * ring_span_get(ring_cache_entry_t * e, lv_coord_t y)
+{
+    ring_span_t * span = &e->spans[y];
+    if(span->x_out >= 0) return span;
+
+    lv_coord_t radius = e->radius;
+    lv_opa_t * rin_buf = _lv_mem_buf_get(radius);
+    lv_opa_t * rout_buf = _lv_mem_buf_get(radius);
+    lv_opa_t * ring_buf = _lv_mem_buf_get(radius);
+
+    /*The masks one by one and the outer mask applied on the inner one as in `draw_ring_span`*/
+    _lv_memset_ff(rin_buf, radius);
+    if(e->mask_rin_param.dsc.cb(rin_buf, 0, y, radius, &e->mask_rin_param) == LV_DRAW_MASK_RES_TRANSP) {
+        _lv_memset_00(rin_buf, radius);
+    }
+    _lv_memset_ff(rout_buf, radius);
+    if(e->mask_rout_param.dsc.cb(rout_buf, 0, y, radius, &e->mask_rout_param) == LV_DRAW_MASK_RES_TRANSP) {
+        _lv_memset_00(rout_buf, radius);
+    }
+    _lv_memcpy_small(ring_buf, rin_buf, radius);
+    if(e->mask_rout_param.dsc.cb(ring_buf, 0, y, radius, &e->mask_rout_param) == LV_DRAW_MASK_RES_TRANSP) {
+        _lv_memset_00(ring_buf, radius);
+    }
+
+    /* Out of the covered pixels there is nothing to draw because the other masks can only reduce the opacity.
+     * Where both masks are 0xFF they don't change the opacity.*/
+    span->x_out = radius;
+    span->x_in = -1;
+    span->x_solid1 = radius;
+    span->x_solid2 = -1;
+    lv_coord_t x;
+    for(x = 0; x < radius; x++) {
+        if(ring_buf[x]) {
+            if(span->x_out > x) span->x_out = x;
+            span->x_in = x;
+        }
+
+        /*Keep the first fully covered run*/
+        if(rin_buf[x] == LV_OPA_COVER && rout_buf[x] == LV_OPA_COVER) {
+            if(span->x_solid2 < span->x_solid1) span->x_solid1 = span->x_solid2 = x;
+            else if(span->x_solid2 == x - 1) span->x_solid2 = x;
+        }
+    }
+
+    _lv_mem_buf_release(ring_buf);
+    _lv_mem_buf_release(rout_buf);
+    _lv_mem_buf_release(rin_buf);
+
+    return span;
+}
+
+/**
+ * Draw a ring with the currently added masks and the masks of the ring.
+ * Apply the masks of the ring only on the not fully covered spans.
+ * @param ring pointer to a ring descriptor
+ * @param clip_area the ring will be drawn only in this area
+ */
+static void draw_ring(const ring_draw_dsc_t * ring, const lv_area_t * clip_area)
+{
+    lv_area_t draw_area;
+    if(_lv_area_intersect(&draw_area, ring->area, clip_area) == false) return;
+
+    const lv_area_t * area = ring->area;
+    lv_coord_t radius = lv_area_get_width(area) / 2;
+
+    lv_opa_t * mask_buf = _lv_mem_buf_get(lv_area_get_width(&draw_area));
+
+    lv_coord_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        if(ring->spans == NULL) {
+            draw_ring_span(ring, clip_area, &draw_area, area->x1, area->x2, y, false, mask_buf);
+            continue;
+        }
+
+        /*The bottom half is the mirror of the top half*/
+        lv_coord_t y_ofs = y - area->y1;
+        if(y_ofs >= radius) y_ofs = radius * 2 - 1 - y_ofs;
+        const ring_span_t * s = ring_span_get(ring->spans, y_ofs);
+        if(s->x_out > s->x_in) continue;
+
+        /*The left side and its mirror on the right side*/
+        if(s->x_solid1 > s->x_solid2) {
+            draw_ring_span(ring, clip_area, &draw_area, area->x1 + s->x_out, area->x1 + s->x_in, y, false, mask_buf);
+            draw_ring_span(ring, clip_area, &draw_area, area->x2 - s->x_in, area->x2 - s->x_out, y, false, mask_buf);
+        }
+        else {
+            draw_ring_span(ring, clip_area, &draw_area, area->x1 + s->x_out, area->x1 + s->x_solid1 - 1, y, false, mask_buf);
+            draw_ring_span(ring, clip_area, &draw_area, area->x1 + s->x_solid1, area->x1 + s->x_solid2, y, true, mask_buf);
+            draw_ring_span(ring, clip_area, &draw_area, area->x1 + s->x_solid2 + 1, area->x1 + s->x_in, y, false, mask_buf);
+
+            draw_ring_span(ring, clip_area, &draw_area, area->x2 - s->x_in, area->x2 - s->x_solid2 - 1, y, false, mask_buf);
+            draw_ring_span(ring, clip_area, &draw_area, area->x2 - s->x_solid2, area->x2 - s->x_solid1, y, true, mask_buf);
+            draw_ring_span(ring, clip_area, &draw_area, area->x2 - s->x_solid1 + 1, area->x2 - s->x_out, y, false, mask_buf);
+        }
+    }
+
+    _lv_mem_buf_release(mask_buf);
+}
+
+/**
+ * Draw a span of a line of a ring
+ * @param ring pointer to a ring descriptor
+ * @param clip_area the ring will be drawn only in this area
+ * @param draw_area the ring's area clipped to `clip_area`
+ * @param x1 the first pixel of the span
+ * @param x2 the last pixel of the span
+ * @param y the line to draw
+ * @param solid true: both masks of the ring fully cover the span so skip them
+ * @param mask_buf a buffer for the mask with `draw_area`'s width
+ */
+static void draw_ring_span(const ring_draw_dsc_t * ring, const lv_area_t * clip_area, const lv_area_t * draw_area,
+                           lv_coord_t x1, lv_coord_t x2, lv_coord_t y, bool solid, lv_opa_t * mask_buf)
+{
+    lv_area_t fill_area;
+    fill_area.x1 = LV_MATH_MAX(x1, draw_area->x1);
+    fill_area.x2 = LV_MATH_MIN(x2, draw_area->x2);
+    fill_area.y1 = y;
+    fill_area.y2 = y;
+    if(fill_area.x1 > fill_area.x2) return;
+
+    lv_coord_t len = lv_area_get_width(&fill_area);
+    _lv_memset_ff(mask_buf, len);
+    lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, fill_area.x1, y, len);
+
+    /*Apply the masks of the ring the same way as if they were added after the others*/
+    if(solid == false && mask_res != LV_DRAW_MASK_RES_TRANSP) {
+        lv_draw_mask_res_t res_in = ring->mask_rin->dsc.cb(mask_buf, fill_area.x1, y, len, ring->mask_rin);
+        lv_draw_mask_res_t res_out = LV_DRAW_MASK_RES_TRANSP;
+        if(res_in != LV_DRAW_MASK_RES_TRANSP) {
+            res_out = ring->mask_rout->dsc.cb(mask_buf, fill_area.x1, y, len, ring->mask_rout);
+        }
+
+        if(res_in == LV_DRAW_MASK_RES_TRANSP || res_out == LV_DRAW_MASK_RES_TRANSP) {
+            mask_res = LV_DRAW_MASK_RES_TRANSP;
+        }
+        else if(res_in == LV_DRAW_MASK_RES_CHANGED || res_out == LV_DRAW_MASK_RES_CHANGED) {
+            mask_res = LV_DRAW_MASK_RES_CHANGED;
+        }
+    }
+
+    _lv_blend_fill(clip_area, &fill_area, ring->color, mask_buf, mask_res, ring->opa, ring->blend_mode);
+}
@@ -24,6 +24,7 @@
  *      DEFINES
  *********************/
 #define GPU_SIZE_LIMIT      240
+#define SPAN_MAX_NUM        8
 
 /**********************
  *      TYPEDEFS
@@ -181,6 +182,55 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
 #endif
 }
 
+/**
+ * Fill a line in the display buffer like `_lv_blend_fill` but split it to spans according to the mask.
+ * The transparent parts are skipped and the fully covered parts are filled without a mask.
+ * @param clip_area clip the fill to this area  (absolute coordinates)
+ * @param fill_area fill this area  (absolute coordinates). Its height has to be 1.
+ * @param color fill color
+ * @param mask a mask to apply on the fill (uint8_t array with 0x00..0xff values).
+ *             Relative to fill area but its width is truncated to clip area.
+ * @param mask_res LV_MASK_RES_COVER: the mask has only 0xff values (no mask),
+ *                 LV_MASK_RES_TRANSP: the mask has only 0x00 values (full transparent),
+ *                 LV_MASK_RES_CHANGED: the mask has mixed values
+ * @param opa overall opacity in 0x00..0xff range
+ * @param mode blend mode from `lv_blend_mode_t`
+ */
+LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill_spans(const lv_area_t * clip_area, const lv_area_t * fill_area,
+                                                lv_color_t color, lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_opa_t opa,
+                                                lv_blend_mode_t mode)
+{
+    if(mask_res != LV_DRAW_MASK_RES_CHANGED) {
+        _lv_blend_fill(clip_area, fill_area, color, mask, mask_res, opa, mode);
+        return;
+    }
+
+    /*Do not draw transparent things*/
+    if(opa < LV_OPA_MIN) return;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, clip_area, fill_area)) return;
+
+    lv_draw_mask_span_t spans[SPAN_MAX_NUM];
+    uint16_t span_cnt = lv_draw_mask_get_spans(mask, lv_area_get_width(&draw_area), spans, SPAN_MAX_NUM);
+
+    lv_area_t span_area;
+    span_area.y1 = draw_area.y1;
+    span_area.y2 = draw_area.y2;
+
+    uint16_t i;
+    for(i = 0; i < span_cnt; i++) {
+        span_area.x1 = draw_area.x1 + spans[i].x;
+        span_area.x2 = span_area.x1 + spans[i].len - 1;
+        if(spans[i].res == LV_DRAW_MASK_RES_FULL_COVER) {
+            _lv_blend_fill(&draw_area, &span_area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, mode);
+        }
+        else {
+            _lv_blend_fill(&draw_area, &span_area, color, mask + spans[i].x, LV_DRAW_MASK_RES_CHANGED, opa, mode);
+        }
+    }
+}
+
 /**
  * Copy a map (image) to a display buffer.
  * @param clip_area clip the map to this area (absolute coordinates)
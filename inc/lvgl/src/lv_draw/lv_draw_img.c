@@ -39,6 +39,8 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
                                               const lv_draw_img_dsc_t * draw_dsc,
                                               bool chroma_key, bool alpha_byte);
 
+LV_ATTRIBUTE_FAST_MEM static lv_res_t draw_lines(const lv_area_t * coords, const lv_area_t * clip_area,
+                                                 lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc);
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg);
 static void draw_cleanup(lv_img_cache_entry_t * cache);
 
@@ -274,6 +276,29 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
             return LV_RES_OK;
         }
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_TRANSFORM_CACHE_SIZE
+        /*Draw the cached transformed copy of the image as a simple ARGB image if there is any*/
+        if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+            lv_area_t trans_area;
+            const uint8_t * trans_map = _lv_img_cache_get_transformed(cdsc, draw_dsc->angle, draw_dsc->zoom,
+                                                                      &draw_dsc->pivot, draw_dsc->antialias, &trans_area);
+            if(trans_map) {
+                lv_draw_img_dsc_t trans_draw_dsc;
+                _lv_memcpy_small(&trans_draw_dsc, draw_dsc, sizeof(lv_draw_img_dsc_t));
+                trans_draw_dsc.angle = 0;
+                trans_draw_dsc.zoom = LV_IMG_ZOOM_NONE;
+
+                trans_area.x1 += coords->x1;
+                trans_area.y1 += coords->y1;
+                trans_area.x2 += coords->x1;
+                trans_area.y2 += coords->y1;
+                lv_draw_map(&trans_area, &mask_com, trans_map, &trans_draw_dsc, false, true);
+                draw_cleanup(cdsc);
+                return LV_RES_OK;
+            }
+        }
+#endif
+
         lv_draw_map(coords, &mask_com, cdsc->dec_dsc.img_data, draw_dsc, chroma_keyed, alpha_byte);
     }
     /* The whole uncompressed image is not available. Try to read it line-by-line*/
@@ -287,38 +312,12 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
             return LV_RES_OK;
         }
 
-        int32_t width = lv_area_get_width(&mask_com);
-
-        uint8_t  * buf = _lv_mem_buf_get(lv_area_get_width(&mask_com) *
-                                         LV_IMG_PX_SIZE_ALPHA_BYTE);  /*+1 because of the possible alpha byte*/
-
-        lv_area_t line;
-        lv_area_copy(&line, &mask_com);
-        lv_area_set_height(&line, 1);
-        int32_t x = mask_com.x1 - coords->x1;
-        int32_t y = mask_com.y1 - coords->y1;
-        int32_t row;
-        lv_res_t read_res;
-        for(row = mask_com.y1; row <= mask_com.y2; row++) {
-            lv_area_t mask_line;
-            union_ok = _lv_area_intersect(&mask_line, clip_area, &line);
-            if(union_ok == false) continue;
-
-            read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
-            if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
-                LV_LOG_WARN("Image draw can't read the line");
-                _lv_mem_buf_release(buf);
-                draw_cleanup(cdsc);
-                return LV_RES_INV;
-            }
-
-            lv_draw_map(&line, &mask_line, buf, draw_dsc, chroma_keyed, alpha_byte);
-            line.y1++;
-            line.y2++;
-            y++;
+        lv_res_t read_res = draw_lines(coords, &mask_com, &cdsc->dec_dsc, draw_dsc);
+        if(read_res != LV_RES_OK) {
+            LV_LOG_WARN("Image draw can't read the line");
+            _lv_img_cache_drop(cdsc);
+            return LV_RES_INV;
         }
-        _lv_mem_buf_release(buf);
     }
 
     draw_cleanup(cdsc);
@@ -362,6 +361,45 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
         _lv_blend_map(clip_area, map_area, (lv_color_t *)map_p, NULL, LV_DRAW_MASK_RES_FULL_COVER, draw_dsc->opa,
                       draw_dsc->blend_mode);
     }
+    /*Chroma keyed image without masking and transformations: blend the pixels directly and mask out the keyed ones*/
+    else if(other_mask_cnt == 0 && draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE &&
+            chroma_key == true && alpha_byte == false && draw_dsc->recolor_opa == LV_OPA_TRANSP &&
+            LV_USE_GPU_NXP_PXP == 0) {
+        int32_t map_w = lv_area_get_width(map_area);
+        int32_t draw_area_w = lv_area_get_width(clip_area);
+        uint32_t hor_res = (uint32_t) lv_disp_get_hor_res(disp);
+        uint32_t mask_buf_size = lv_area_get_size(clip_area) > hor_res ? hor_res : lv_area_get_size(clip_area);
+        lv_opa_t * mask_buf = _lv_mem_buf_get(mask_buf_size);
+
+        const lv_color_t * map_row = (const lv_color_t *)map_p;
+        map_row += map_w * (clip_area->y1 - map_area->y1) + (clip_area->x1 - map_area->x1);
+
+        lv_area_t blend_area;
+        lv_area_copy(&blend_area, clip_area);
+        blend_area.y2 = blend_area.y1 - 1;
+
+        bool keyed = false;
+        uint32_t px_i = 0;
+        lv_coord_t y;
+        for(y = clip_area->y1; y <= clip_area->y2; y++) {
+            keyed |= _lv_img_buf_chroma_key_row(map_row, draw_area_w, &mask_buf[px_i]);
+            map_row += map_w;
+            px_i += draw_area_w;
+            blend_area.y2 = y;
+            if(px_i + draw_area_w <= mask_buf_size && y != clip_area->y2) continue;
+
+            /*The mask is relative to `blend_area` while the map is used directly*/
+            _lv_blend_map(&blend_area, map_area, (const lv_color_t *)map_p, keyed ? mask_buf : NULL,
+                          keyed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER, draw_dsc->opa,
+                          draw_dsc->blend_mode);
+
+            blend_area.y1 = y + 1;
+            px_i = 0;
+            keyed = false;
+        }
+
+        _lv_mem_buf_release(mask_buf);
+    }
 #if LV_USE_GPU_NXP_PXP
     /* Simple case without masking and transformations */
     else if(other_mask_cnt == 0 && draw_dsc->angle == 0 && draw_dsc->zoom == LV_IMG_ZOOM_NONE && alpha_byte == false &&
@@ -527,60 +565,52 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
 
 #if LV_USE_IMG_TRANSFORM
                 int32_t rot_x = disp_area->x1 + draw_area.x1 - map_area->x1;
-#endif
-                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
 
-#if LV_USE_IMG_TRANSFORM
-                    if(transform) {
-
-                        /*Transform*/
-                        bool ret;
-                        ret = _lv_img_buf_transform(&trans_dsc, rot_x + x, rot_y + y);
-                        if(ret == false) {
-                            mask_buf[px_i] = LV_OPA_TRANSP;
-                            continue;
-                        }
-                        else {
-                            mask_buf[px_i] = trans_dsc.res.opa;
-                            c.full = trans_dsc.res.color.full;
+                /*Transform the whole row at once and recolor only the visible pixels*/
+                if(transform) {
+                    _lv_img_buf_transform_row(&trans_dsc, rot_x, rot_y + y, draw_area_w, &map2[px_i], &mask_buf[px_i]);
+                    if(draw_dsc->recolor_opa != 0) {
+                        for(x = 0; x < draw_area_w; x++) {
+                            if(mask_buf[px_i + x] == LV_OPA_TRANSP) continue;
+                            map2[px_i + x] = lv_color_mix_premult(recolor_premult, map2[px_i + x], recolor_opa_inv);
                         }
                     }
-                    /*No transform*/
-                    else
+                    px_i += draw_area_w;
+                }
+                else
 #endif
-                    {
-                        if(alpha_byte) {
-                            lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-                            mask_buf[px_i] = px_opa;
-                            if(px_opa == 0) {
+                for(x = 0; x < draw_area_w; x++, map_px += px_size_byte, px_i++) {
+                    if(alpha_byte) {
+                        lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                        mask_buf[px_i] = px_opa;
+                        if(px_opa == 0) {
 #if LV_COLOR_DEPTH == 32
-                                map2[px_i].full = 0;
+                            map2[px_i].full = 0;
 #endif
-                                continue;
-                            }
-                        }
-                        else {
-                            mask_buf[px_i] = 0xFF;
+                            continue;
                         }
+                    }
+                    else {
+                        mask_buf[px_i] = 0xFF;
+                    }
 
 #if LV_COLOR_DEPTH == 1
-                        c.full = map_px[0];
+                    c.full = map_px[0];
 #elif LV_COLOR_DEPTH == 8
-                        c.full =  map_px[0];
+                    c.full =  map_px[0];
 #elif LV_COLOR_DEPTH == 16
-                        c.full =  map_px[0] + (map_px[1] << 8);
+                    c.full =  map_px[0] + (map_px[1] << 8);
 #elif LV_COLOR_DEPTH == 32
-                        c.full =  *((uint32_t *)map_px);
-                        c.ch.alpha = 0xFF;
+                    c.full =  *((uint32_t *)map_px);
+                    c.ch.alpha = 0xFF;
 #endif
-                        if(chroma_key) {
-                            if(c.full == chroma_keyed_color.full) {
-                                mask_buf[px_i] = LV_OPA_TRANSP;
+                    if(chroma_key) {
+                        if(c.full == chroma_keyed_color.full) {
+                            mask_buf[px_i] = LV_OPA_TRANSP;
 #if LV_COLOR_DEPTH == 32
-                                map2[px_i].full = 0;
+                            map2[px_i].full = 0;
 #endif
-                                continue;
-                            }
+                            continue;
                         }
                     }
 
@@ -639,6 +669,95 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_map(const lv_area_t * map_area, const
     }
 }
 
+/**
+ * Draw an image which can be read only line-by-line.
+ * The lines are decoded into ready to blend colors and opacities and blended in blocks.
+ * @param coords the coordinates of the image
+ * @param clip_area the visible part of the image (inside `coords`)
+ * @param dec_dsc the opened image
+ * @param draw_dsc pointer to an initialized `lv_draw_img_dsc_t` variable
+ * @return LV_RES_OK: the lines were read; LV_RES_INV: the decoder failed
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_res_t draw_lines(const lv_area_t * coords, const lv_area_t * clip_area,
+                                                 lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc)
+{
+    lv_img_cf_t cf = dec_dsc->header.cf;
+    bool alpha_only = cf >= LV_IMG_CF_ALPHA_1BIT && cf <= LV_IMG_CF_ALPHA_8BIT;
+    bool opaque = cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_RAW;
+    uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
+
+    uint16_t recolor_premult[3] = {0};
+    lv_opa_t recolor_opa_inv = 255 - draw_dsc->recolor_opa;
+    if(draw_dsc->recolor_opa != 0) {
+        lv_color_premult(draw_dsc->recolor, draw_dsc->recolor_opa, recolor_premult);
+    }
+
+    /*The images with only alpha are the same color everywhere so they are simply a masked fill*/
+    lv_color_t fill_color = dec_dsc->color;
+    if(alpha_only && draw_dsc->recolor_opa != 0) {
+        fill_color = lv_color_mix_premult(recolor_premult, fill_color, recolor_opa_inv);
+    }
+
+    /*Decode as many lines into the buffers as possible before blending them*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    uint32_t hor_res = (uint32_t) lv_disp_get_hor_res(disp);
+    int32_t w = lv_area_get_width(clip_area);
+    uint32_t buf_size = lv_area_get_size(clip_area) > hor_res ? hor_res : lv_area_get_size(clip_area);
+    if(buf_size < (uint32_t)w) buf_size = w;
+    lv_color_t * color_buf = alpha_only ? NULL : _lv_mem_buf_get(buf_size * sizeof(lv_color_t));
+    lv_opa_t * opa_buf = _lv_mem_buf_get(buf_size);
+
+    lv_area_t blend_area;
+    blend_area.x1 = clip_area->x1;
+    blend_area.x2 = clip_area->x2;
+    blend_area.y1 = clip_area->y1;
+    blend_area.y2 = clip_area->y1 - 1;
+
+    lv_res_t res = LV_RES_OK;
+    uint32_t px_i = 0;
+    lv_coord_t y;
+    for(y = clip_area->y1; y <= clip_area->y2; y++) {
+        res = _lv_img_decoder_read_line_split(dec_dsc, clip_area->x1 - coords->x1, y - coords->y1, w,
+                                              alpha_only ? NULL : &color_buf[px_i], &opa_buf[px_i]);
+        if(res != LV_RES_OK) break;
+
+        if(draw_dsc->recolor_opa != 0 && !alpha_only) {
+            int32_t x;
+            for(x = px_i; x < (int32_t)px_i + w; x++) {
+                if(opa_buf[x] == LV_OPA_TRANSP) continue;
+                color_buf[x] = lv_color_mix_premult(recolor_premult, color_buf[x], recolor_opa_inv);
+            }
+        }
+
+        if(other_mask_cnt) {
+            lv_draw_mask_res_t mask_res_sub = lv_draw_mask_apply(&opa_buf[px_i], clip_area->x1, y, w);
+            if(mask_res_sub == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(&opa_buf[px_i], w);
+        }
+
+        px_i += w;
+        blend_area.y2 = y;
+        if(px_i + w <= buf_size && y != clip_area->y2) continue;
+
+        /*The opacities are not needed if the image has no transparent pixels*/
+        lv_opa_t * mask = (opaque && other_mask_cnt == 0) ? NULL : opa_buf;
+        lv_draw_mask_res_t mask_res = mask ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+        if(alpha_only) {
+            _lv_blend_fill(clip_area, &blend_area, fill_color, mask, mask_res, draw_dsc->opa, draw_dsc->blend_mode);
+        }
+        else {
+            _lv_blend_map(clip_area, &blend_area, color_buf, mask, mask_res, draw_dsc->opa, draw_dsc->blend_mode);
+        }
+
+        blend_area.y1 = y + 1;
+        px_i = 0;
+    }
+
+    _lv_mem_buf_release(opa_buf);
+    if(color_buf) _lv_mem_buf_release(color_buf);
+
+    return res;
+}
+
 static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, const char * msg)
 {
     lv_draw_rect_dsc_t rect_dsc;
@@ -653,10 +772,6 @@ static void show_error(const lv_area_t * coords, const lv_area_t * clip_area, co
 
 static void draw_cleanup(lv_img_cache_entry_t * cache)
 {
-    /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
-#endif
+    /*Automatically close images which are not kept in the cache*/
+    _lv_img_cache_release(cache);
 }
@@ -12,12 +12,14 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_bidi.h"
 #include "../lv_misc/lv_debug.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
-#define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LABEL_HINT_FLAG_MASK (LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT) /*Flags affecting line breaks*/
+#define LABEL_HINT_LINES_INIT 8
 
 /**********************
  *      TYPEDEFS
@@ -29,6 +31,27 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+#if LV_LABEL_CACHE_SIZE
+/*Pre-rendered coverage map of a text. The map is stored right after this header*/
+typedef struct _lv_draw_label_cache_t {
+    struct _lv_draw_label_cache_t * prev;   /*Toward the more recently used*/
+    struct _lv_draw_label_cache_t * next;   /*Toward the less recently used*/
+    lv_draw_label_hint_t * hint;            /*The hint owning the cache*/
+
+    /*The parameters the map was rendered with. The line table's key has the others*/
+    lv_coord_t coords_w;
+    lv_coord_t coords_h;
+    lv_style_int_t line_space;
+    lv_txt_flag_t flag;
+    lv_bidi_dir_t bidi_dir;
+
+    lv_area_t area;     /*The rendered pixels relative to the label's coordinates*/
+    uint32_t size;      /*Size of the allocation*/
+    uint32_t refr;      /*The last refresh (`cache_refr`) the map was drawn in*/
+    uint8_t px_size;    /*Bytes per pixel. 3 with sub-pixel rendered fonts: one opacity for each sub-pixel*/
+} lv_draw_label_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -41,11 +64,63 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
 static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g, const lv_area_t * clip_area,
                               const uint8_t * map_p, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 
+#if LV_USE_FONT_SUBPX
+LV_ATTRIBUTE_FAST_MEM static inline lv_color_t subpx_mix(const uint8_t * txt_rgb, const uint8_t * font_rgb, lv_color_t bg);
+#endif
+
+static bool glyph_direct_blend_ok(lv_blend_mode_t blend_mode);
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal_4bpp(lv_coord_t pos_x, lv_coord_t pos_y, const lv_font_glyph_dsc_t * g,
+                                                          int32_t col_start, int32_t col_end, int32_t row_start, int32_t row_end,
+                                                          const uint8_t * map_p, lv_color_t color, const lv_opa_t * bpp_opa_table_p, lv_opa_t opa);
+#if LV_USE_FONT_SUBPX
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_subpx_4bpp(lv_coord_t pos_x, lv_coord_t pos_y, const lv_font_glyph_dsc_t * g,
+                                                         int32_t col_start, int32_t col_end, int32_t row_start, int32_t row_end,
+                                                         const uint8_t * map_p, lv_color_t color, lv_opa_t opa);
+#endif
+
 static uint8_t hex_char_to_num(char hex);
 
+#if LV_LABEL_CACHE_SIZE
+static bool label_cache_draw(const lv_area_t * coords, const lv_area_t * mask, const lv_draw_label_dsc_t * dsc,
+                             const char * txt, lv_draw_label_hint_t * hint);
+static lv_draw_label_cache_t * label_cache_render(const lv_area_t * coords, const lv_draw_label_dsc_t * dsc,
+                                                  const char * txt, lv_draw_label_hint_t * hint);
+static void label_cache_free(lv_draw_label_hint_t * hint);
+static void label_cache_use(lv_draw_label_cache_t * cache);
+#if LV_USE_FONT_SUBPX
+LV_ATTRIBUTE_FAST_MEM static void label_cache_blend_subpx(const lv_area_t * draw_area, const lv_area_t * area,
+                                                          const lv_draw_label_cache_t * cache, const lv_draw_label_dsc_t * dsc);
+#endif
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_cov(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                  const lv_area_t * clip_area, const uint8_t * map_p);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*The mixed colors of the 4 bpp shades on the last background color.
+ *Text is mostly drawn with the same color on the same background.*/
+static struct {
+    lv_color_t color;
+    lv_color_t bg;
+    lv_opa_t opa;
+    uint16_t valid;         /*A bit for every shade of `res`*/
+    lv_color_t res[16];
+} shade_cache;
+
+#if LV_LABEL_CACHE_SIZE
+static lv_draw_label_cache_t * cache_head;  /*Most recently used*/
+static lv_draw_label_cache_t * cache_tail;  /*Least recently used*/
+static uint32_t cache_used;
+static uint32_t cache_refr;         /*Counts the refreshes*/
+static uint32_t cache_refr_used;    /*Size of the maps drawn in the current refresh. They are not freed for new maps*/
+
+/*If set the letters are rendered into this coverage map instead of the display*/
+static lv_opa_t * cov_buf;
+static lv_area_t cov_area;
+static uint8_t cov_px_size;
+static bool cov_measure;    /*If set the letters only add their area to `cov_area`*/
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -108,8 +183,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label_dsc_init(lv_draw_label_dsc_t * dsc)
  * @param mask the label will be drawn only in this area
  * @param dsc pointer to draw descriptor
  * @param txt `\0` terminated text to write
- * @param hint pointer to a `lv_draw_label_hint_t` variable.
- * It is managed by the drawer to speed up the drawing of very long texts (thousands of lines).
+ * @param hint pointer to a `lv_draw_label_hint_t` variable or `NULL`.
+ * Its line table (and pre-rendered text if enabled) is built and reused by the drawer
+ * to not measure (and render) the text on every redraw.
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask,
                                          const lv_draw_label_dsc_t * dsc,
@@ -128,12 +204,37 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
+#if LV_LABEL_CACHE_SIZE
+    /*Blend the pre-rendered text if possible*/
+    if(hint && hint->cache_en && cov_buf == NULL && cov_measure == false) {
+        if(label_cache_draw(coords, mask, dsc, txt, hint)) return;
+    }
+#endif
+
     if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
     else {
-        /*If EXAPND is enabled then not limit the text's width to the object's width*/
+        w = LV_COORD_MAX;
+    }
+
+    /*Use the line table of the hint if it can be built*/
+    const lv_draw_label_line_t * lines = NULL;
+    uint32_t line_cnt = 0;
+    if(hint && _lv_draw_label_hint_update(hint, txt, font, dsc->letter_space, w, dsc->flag)) {
+        lines = hint->lines;
+        line_cnt = hint->line_cnt;
+    }
+
+#if LV_USE_BIDI
+    /*Take the lines in visual order from the hint too to not process them again*/
+    bool bidi_hint = lines && _lv_draw_label_hint_update_bidi(hint, dsc->bidi_dir);
+#endif
+
+    /*If EXAPND is enabled then not limit the text's width to the object's width.
+     *The line table already has the line breaks so it's required only without it.*/
+    if((dsc->flag & LV_TXT_FLAG_EXPAND) && lines == NULL) {
         lv_point_t p;
         _lv_txt_get_size(&p, txt, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX,
                          dsc->flag);
@@ -155,53 +256,51 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     y_ofs = dsc->ofs_y;
     pos.y += y_ofs;
 
-    uint32_t line_start     = 0;
-    int32_t last_line_start = -1;
+    uint32_t line_start = 0;
+    uint32_t line_end;
+    uint32_t line_id = 0;
 
-    /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
-        /*If the label changed too much recalculate the hint.*/
-        if(LV_MATH_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
-            hint->line_start = -1;
+    if(lines) {
+        /*Jump to the first visible line*/
+        if(pos.y + line_height_font < mask->y1) {
+            if(line_height > 0) {
+                line_id = (mask->y1 - pos.y - line_height_font + line_height - 1) / line_height;
+                pos.y += (int32_t)line_id * line_height;
+            }
+            else {
+                line_id = line_cnt;
+            }
+            if(line_id >= line_cnt) return;
         }
-        last_line_start = hint->line_start;
-    }
-
-    /*Use the hint if it's valid*/
-    if(hint && last_line_start >= 0) {
-        line_start = last_line_start;
-        pos.y += hint->y;
+        line_start = lines[line_id].start;
+        line_end = lines[line_id + 1].start;
     }
+    else {
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
-
-    /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
-        /*Go to next line*/
-        line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
-        pos.y += line_height;
+        /*Go the first visible line*/
+        while(pos.y + line_height_font < mask->y1) {
+            /*Go to next line*/
+            line_start = line_end;
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+            pos.y += line_height;
 
-        /*Save at the threshold coordinate*/
-        if(hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && hint->line_start < 0) {
-            hint->line_start = line_start;
-            hint->y          = pos.y - coords->y1;
-            hint->coord_y    = coords->y1;
+            if(txt[line_start] == '\0') return;
         }
-
-        if(txt[line_start] == '\0') return;
     }
 
     /*Align to middle*/
     if(dsc->flag & LV_TXT_FLAG_CENTER) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = lines ? lines[line_id].width :
+                     _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = lines ? lines[line_id].width :
+                     _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -229,6 +328,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     uint32_t par_start = 0;
     lv_color_t recolor;
     int32_t letter_w;
+    const lv_font_ascii_widths_t * ascii_widths = _lv_font_get_ascii_widths(font);
 
     lv_draw_rect_dsc_t draw_dsc_sel;
     lv_draw_rect_dsc_init(&draw_dsc_sel);
@@ -243,8 +343,18 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         cmd_state = CMD_STATE_WAIT;
         i         = 0;
 #if LV_USE_BIDI
-        char * bidi_txt = _lv_mem_buf_get(line_end - line_start + 1);
-        _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, dsc->bidi_dir, NULL, 0);
+        char * bidi_buf = NULL;
+        const char * bidi_txt;
+        const uint16_t * bidi_pos = NULL;
+        if(bidi_hint) {
+            bidi_txt = hint->bidi_txt ? &hint->bidi_txt[line_start] : &txt[line_start];
+            if(hint->bidi_pos) bidi_pos = &hint->bidi_pos[line_start];
+        }
+        else {
+            bidi_buf = _lv_mem_buf_get(line_end - line_start + 1);
+            _lv_bidi_process_paragraph(txt + line_start, bidi_buf, line_end - line_start, dsc->bidi_dir, NULL, 0);
+            bidi_txt = bidi_buf;
+        }
 #else
         const char * bidi_txt = txt + line_start;
 #endif
@@ -254,15 +364,28 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
 #if LV_USE_BIDI
                 logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start);
-                uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
-                logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, dsc->bidi_dir, t, NULL);
+                if(bidi_pos) {
+                    logical_char_pos += bidi_pos[i] & ~LV_DRAW_LABEL_BIDI_POS_RTL;
+                }
+                else if(bidi_hint) {
+                    logical_char_pos += _lv_txt_encoded_get_char_id(bidi_txt, i);
+                }
+                else {
+                    uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
+                    logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, dsc->bidi_dir, t, NULL);
+                }
 #else
                 logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start + i);
 #endif
             }
 
-            uint32_t letter      = _lv_txt_encoded_next(bidi_txt, &i);
-            uint32_t letter_next = _lv_txt_encoded_next(&bidi_txt[i], NULL);
+            /*The printable ASCII letters are their own code*/
+            uint32_t letter;
+            uint32_t letter_next;
+            if((uint32_t)(uint8_t)bidi_txt[i] - LV_FONT_ASCII_FIRST < LV_FONT_ASCII_CNT) letter = (uint8_t)bidi_txt[i++];
+            else letter = _lv_txt_encoded_next(bidi_txt, &i);
+            if((uint32_t)(uint8_t)bidi_txt[i] - LV_FONT_ASCII_FIRST < LV_FONT_ASCII_CNT) letter_next = (uint8_t)bidi_txt[i];
+            else letter_next = _lv_txt_encoded_next(&bidi_txt[i], NULL);
 
             /*Handle the re-color command*/
             if((dsc->flag & LV_TXT_FLAG_RECOLOR) != 0) {
@@ -308,7 +431,8 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
             if(cmd_state == CMD_STATE_IN) color = recolor;
 
-            letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            letter_w = ascii_widths ? _lv_font_get_ascii_width(ascii_widths, letter, letter_next) : -1;
+            if(letter_w < 0) letter_w = lv_font_get_glyph_width(font, letter, letter_next);
 
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
                 if(logical_char_pos >= sel_start && logical_char_pos < sel_end) {
@@ -350,26 +474,32 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         }
 
 #if LV_USE_BIDI
-        _lv_mem_buf_release(bidi_txt);
-        bidi_txt = NULL;
+        if(bidi_buf) _lv_mem_buf_release(bidi_buf);
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(lines) {
+            line_id++;
+            if(line_id >= line_cnt) break;
+            line_end = lines[line_id + 1].start;
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(dsc->flag & LV_TXT_FLAG_CENTER) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = lines ? lines[line_id].width :
+                         _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = lines ? lines[line_id].width :
+                         _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -382,6 +512,198 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+/**
+ * Be sure the line table of a hint belongs to the given text and parameters.
+ * Rebuild it if any of them has changed.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ * @param txt `\0` terminated text
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w max. width of the lines
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the line table is valid; false: out of memory
+ */
+bool _lv_draw_label_hint_update(lv_draw_label_hint_t * hint, const char * txt, const lv_font_t * font,
+                                lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    /*Only these flags change the line breaks and the widths. The width doesn't matter without wrapping*/
+    flag &= LABEL_HINT_FLAG_MASK;
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_w = LV_COORD_MAX;
+
+    if(hint->lines && hint->txt == txt && hint->font == font && hint->letter_space == letter_space &&
+       hint->max_w == max_w && hint->flag == flag) {
+        return true;
+    }
+
+    _lv_draw_label_hint_invalidate(hint);
+
+    uint32_t size = LABEL_HINT_LINES_INIT;
+    lv_draw_label_line_t * lines = lv_mem_alloc(size * sizeof(lv_draw_label_line_t));
+    if(lines == NULL) return false;
+
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    lv_coord_t max_line_w = 0;
+    while(txt[line_start] != '\0') {
+        /*Keep place for the closing line too*/
+        if(line_cnt + 1 >= size) {
+            size *= 2;
+            lv_draw_label_line_t * new_lines = lv_mem_realloc(lines, size * sizeof(lv_draw_label_line_t));
+            if(new_lines == NULL) {
+                lv_mem_free(lines);
+                return false;
+            }
+            lines = new_lines;
+        }
+
+        uint32_t line_len = _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+        lines[line_cnt].start = line_start;
+        lines[line_cnt].width = _lv_txt_get_width(&txt[line_start], line_len, font, letter_space, flag);
+        max_line_w = LV_MATH_MAX(max_line_w, lines[line_cnt].width);
+        line_cnt++;
+        line_start += line_len;
+    }
+
+    lines[line_cnt].start = line_start;
+    lines[line_cnt].width = 0;
+
+    hint->lines = lines;
+    hint->line_cnt = line_cnt;
+    hint->max_line_w = max_line_w;
+    hint->txt = txt;
+    hint->font = font;
+    hint->letter_space = letter_space;
+    hint->max_w = max_w;
+    hint->flag = flag;
+
+    return true;
+}
+
+#if LV_USE_BIDI
+/**
+ * Be sure the visual order of the lines of a hint belongs to the given base direction.
+ * Rebuild it if the direction has changed. The line table needs to be up to date.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable with line table
+ * @param base_dir base direction of the text
+ * @return true: `bidi_txt` and `bidi_pos` are valid; false: out of memory
+ */
+bool _lv_draw_label_hint_update_bidi(lv_draw_label_hint_t * hint, lv_bidi_dir_t base_dir)
+{
+    if(hint->lines == NULL) return false;
+    if(hint->bidi_valid && hint->bidi_dir == base_dir) return true;
+
+    if(hint->bidi_txt) lv_mem_free(hint->bidi_txt);
+    if(hint->bidi_pos) lv_mem_free(hint->bidi_pos);
+    hint->bidi_txt = NULL;
+    hint->bidi_pos = NULL;
+    hint->bidi_valid = 0;
+
+    const char * txt = hint->txt;
+    uint32_t txt_len = hint->lines[hint->line_cnt].start;
+    char * bidi_txt = lv_mem_alloc(txt_len + 1);
+    uint16_t * bidi_pos = lv_mem_alloc((txt_len + 1) * sizeof(uint16_t));
+    if(bidi_txt == NULL || bidi_pos == NULL) {
+        if(bidi_txt) lv_mem_free(bidi_txt);
+        if(bidi_pos) lv_mem_free(bidi_pos);
+        return false;
+    }
+
+    bool reordered = false;
+    uint32_t line_id;
+    for(line_id = 0; line_id < hint->line_cnt; line_id++) {
+        uint32_t line_start = hint->lines[line_id].start;
+        uint32_t line_len = hint->lines[line_id + 1].start - line_start;
+
+        uint32_t char_cnt = 0;
+        uint32_t i = 0;
+        while(i < line_len) {
+            _lv_txt_encoded_next(&txt[line_start], &i);
+            char_cnt++;
+        }
+
+        uint16_t * pos_conv = _lv_mem_buf_get(char_cnt * sizeof(uint16_t));
+        if(pos_conv == NULL) {
+            lv_mem_free(bidi_txt);
+            lv_mem_free(bidi_pos);
+            return false;
+        }
+
+        /*It also closes the line with '\0' which is overwritten by the next line*/
+        _lv_bidi_process_paragraph(&txt[line_start], &bidi_txt[line_start], line_len, base_dir, pos_conv, char_cnt);
+
+        /*Store the logical position at every byte of the visual characters*/
+        uint32_t c;
+        i = 0;
+        for(c = 0; c < char_cnt && i < line_len; c++) {
+            uint32_t char_start = i;
+            _lv_txt_encoded_next(&bidi_txt[line_start], &i);
+            if(i > line_len) i = line_len;     /*Invalid UTF-8 at the end of the line*/
+            for(; char_start < i; char_start++) bidi_pos[line_start + char_start] = pos_conv[c];
+            if(pos_conv[c] != c) reordered = true;
+        }
+
+        _lv_mem_buf_release(pos_conv);
+    }
+
+    /*The end of the text is after the last character of the last line*/
+    bidi_txt[txt_len] = '\0';
+    bidi_pos[txt_len] = 0;
+    if(hint->line_cnt > 0) {
+        uint32_t last_start = hint->lines[hint->line_cnt - 1].start;
+        bidi_pos[txt_len] = _lv_txt_encoded_get_char_id(&txt[last_start], txt_len - last_start);
+    }
+
+    /*Don't keep a copy of the text if it's not reordered (e.g. no right-to-left characters)*/
+    if(reordered == false && memcmp(bidi_txt, txt, txt_len) == 0) {
+        lv_mem_free(bidi_txt);
+        lv_mem_free(bidi_pos);
+    }
+    else {
+        hint->bidi_txt = bidi_txt;
+        hint->bidi_pos = bidi_pos;
+    }
+
+    hint->bidi_dir = base_dir;
+    hint->bidi_valid = 1;
+
+    return true;
+}
+#endif
+
+/**
+ * Free the line table, the visual order and the pre-rendered text of a hint. They will be built again on next use.
+ * Required if the text was modified in place.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ */
+void _lv_draw_label_hint_invalidate(lv_draw_label_hint_t * hint)
+{
+    if(hint->lines) lv_mem_free(hint->lines);
+#if LV_USE_BIDI
+    if(hint->bidi_txt) lv_mem_free(hint->bidi_txt);
+    if(hint->bidi_pos) lv_mem_free(hint->bidi_pos);
+#endif
+#if LV_LABEL_CACHE_SIZE
+    if(hint->cache) label_cache_free(hint);
+#endif
+
+    /*Keep the settings*/
+    uint8_t cache_en = hint->cache_en;
+    _lv_memset_00(hint, sizeof(lv_draw_label_hint_t));
+    hint->cache_en = cache_en;
+}
+
+#if LV_LABEL_CACHE_SIZE
+/**
+ * Tell the cache of the pre-rendered texts that a refresh is ready.
+ * The texts drawn in it can be freed again for new ones.
+ */
+void _lv_draw_label_cache_refr_ready(void)
+{
+    cache_refr++;
+    cache_refr_used = 0;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -433,12 +755,34 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
         return;
     }
 
-    const uint8_t * map_p = lv_font_get_glyph_bitmap(font_p, letter);
+#if LV_LABEL_CACHE_SIZE
+    /*Only measure the area of the whole letter (also out of the mask) as `draw_letter_cov` will render it*/
+    if(cov_measure) {
+        int32_t px_w = g.box_w / cov_px_size;
+        if(px_w == 0) return;
+        if(pos_x < cov_area.x1) cov_area.x1 = pos_x;
+        if(pos_y < cov_area.y1) cov_area.y1 = pos_y;
+        if(pos_x + px_w - 1 > cov_area.x2) cov_area.x2 = pos_x + px_w - 1;
+        if(pos_y + g.box_h - 1 > cov_area.y2) cov_area.y2 = pos_y + g.box_h - 1;
+        return;
+    }
+#endif
+
+    /*The glyph might be in a fallback font*/
+    font_p = g.resolved_font;
+    const uint8_t * map_p = font_p->get_glyph_bitmap(font_p, letter);
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
         return;
     }
 
+#if LV_LABEL_CACHE_SIZE
+    if(cov_buf) {
+        draw_letter_cov(pos_x, pos_y, &g, clip_area, map_p);
+        return;
+    }
+#endif
+
     if(font_p->subpx) {
         draw_letter_subpx(pos_x, pos_y, &g, clip_area, map_p, color, opa, blend_mode);
     }
@@ -510,6 +854,12 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
     int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
 
+    /*Blend the most common 4 bpp glyphs directly if there is nothing else to apply*/
+    if(bpp == 4 && glyph_direct_blend_ok(blend_mode)) {
+        draw_letter_normal_4bpp(pos_x, pos_y, g, col_start, col_end, row_start, row_end, map_p, color, bpp_opa_table_p, opa);
+        return;
+    }
+
     /*Move on the map too*/
     uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
     map_p += bit_ofs >> 3;
@@ -646,6 +996,12 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
     int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
     int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
 
+    /*Blend 4 bpp glyphs directly if there is nothing else to apply*/
+    if(bpp == 4 && glyph_direct_blend_ok(blend_mode)) {
+        draw_letter_subpx_4bpp(pos_x, pos_y, g, col_start, col_end, row_start, row_end, map_p, color, opa);
+        return;
+    }
+
     /*Move on the map too*/
     int32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
     map_p += bit_ofs >> 3;
@@ -716,35 +1072,7 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
             if(subpx_cnt == 3) {
                 subpx_cnt = 0;
 
-                lv_color_t res_color;
-#if LV_COLOR_16_SWAP == 0
-                uint8_t bg_rgb[3] = {vdb_buf_tmp->ch.red, vdb_buf_tmp->ch.green, vdb_buf_tmp->ch.blue};
-#else
-                uint8_t bg_rgb[3] = {vdb_buf_tmp->ch.red,
-                                     (vdb_buf_tmp->ch.green_h << 3) + vdb_buf_tmp->ch.green_l,
-                                     vdb_buf_tmp->ch.blue
-                                    };
-#endif
-
-#if LV_FONT_SUBPX_BGR
-                res_color.ch.blue = (uint32_t)((uint32_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8;
-                res_color.ch.red = (uint32_t)((uint32_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8;
-#else
-                res_color.ch.red = (uint32_t)((uint16_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8;
-                res_color.ch.blue = (uint32_t)((uint16_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8;
-#endif
-
-#if LV_COLOR_16_SWAP == 0
-                res_color.ch.green = (uint32_t)((uint32_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8;
-#else
-                uint8_t green = (uint32_t)((uint32_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8;
-                res_color.ch.green_h = green >> 3;
-                res_color.ch.green_l = green & 0x7;
-#endif
-
-#if LV_COLOR_DEPTH == 32
-                res_color.ch.alpha =  0xff;
-#endif
+                lv_color_t res_color = subpx_mix(txt_rgb, font_rgb, *vdb_buf_tmp);
 
                 if(font_rgb[0] == 0 && font_rgb[1] == 0 && font_rgb[2] == 0) mask_buf[mask_p] = LV_OPA_TRANSP;
                 else mask_buf[mask_p] = LV_OPA_COVER;
@@ -812,6 +1140,248 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
 #endif
 }
 
+#if LV_USE_FONT_SUBPX
+/**
+ * Mix the text color into a background pixel by sub-pixels
+ * @param txt_rgb red, green and blue components of the text color
+ * @param font_rgb opacity of the sub-pixels in the order of the glyph's bitmap
+ * @param bg color of the background pixel
+ * @return the mixed color
+ */
+LV_ATTRIBUTE_FAST_MEM static inline lv_color_t subpx_mix(const uint8_t * txt_rgb, const uint8_t * font_rgb, lv_color_t bg)
+{
+    lv_color_t res_color;
+#if LV_COLOR_16_SWAP == 0
+    uint8_t bg_rgb[3] = {bg.ch.red, bg.ch.green, bg.ch.blue};
+#else
+    uint8_t bg_rgb[3] = {bg.ch.red, (bg.ch.green_h << 3) + bg.ch.green_l, bg.ch.blue};
+#endif
+
+#if LV_FONT_SUBPX_BGR
+    res_color.ch.blue = (uint32_t)((uint32_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8;
+    res_color.ch.red = (uint32_t)((uint32_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8;
+#else
+    res_color.ch.red = (uint32_t)((uint16_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8;
+    res_color.ch.blue = (uint32_t)((uint16_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8;
+#endif
+
+#if LV_COLOR_16_SWAP == 0
+    res_color.ch.green = (uint32_t)((uint32_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8;
+#else
+    uint8_t green = (uint32_t)((uint32_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8;
+    res_color.ch.green_h = green >> 3;
+    res_color.ch.green_l = green & 0x7;
+#endif
+
+#if LV_COLOR_DEPTH == 32
+    res_color.ch.alpha =  0xff;
+#endif
+
+    return res_color;
+}
+#endif
+
+/**
+ * Tell whether a glyph can be blended directly into the display buffer.
+ * The other masks, `set_px_cb`, the blend modes and the rounding without anti-aliasing need the normal blending.
+ * @param blend_mode blend mode of the glyph
+ * @return true: the direct kernels can be used
+ */
+static bool glyph_direct_blend_ok(lv_blend_mode_t blend_mode)
+{
+    if(blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(lv_draw_mask_get_cnt() != 0) return false;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver.set_px_cb) return false;
+    if(disp->driver.antialiasing == 0) return false;
+#if LV_COLOR_SCREEN_TRANSP
+    if(disp->driver.screen_transp) return false;
+#endif
+
+    if(disp->driver.gpu_wait_cb) disp->driver.gpu_wait_cb(&disp->driver);
+
+    return true;
+}
+
+/**
+ * Blend a shade of a 4 bpp glyph on a pixel like `_lv_blend_fill` does with a mask
+ * @param px_p pointer to the pixel in the display buffer
+ * @param shade 1..15 value of the glyph's pixel
+ * @param color color of the glyph
+ * @param bpp_opa_table_p opacity of the shades
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void blend_shade(lv_color_t * px_p, uint32_t shade, lv_color_t color,
+                                                     const lv_opa_t * bpp_opa_table_p)
+{
+    if(px_p->full != shade_cache.bg.full) {
+        shade_cache.bg = *px_p;
+        shade_cache.valid = 0;
+    }
+
+    if((shade_cache.valid & (1 << shade)) == 0) {
+        lv_opa_t px_opa = bpp_opa_table_p[shade];
+        if(px_opa == LV_OPA_COVER) shade_cache.res[shade] = color;
+        else if(px_opa == LV_OPA_TRANSP) shade_cache.res[shade] = *px_p;
+        else shade_cache.res[shade] = lv_color_mix(color, *px_p, px_opa);
+        shade_cache.valid |= 1 << shade;
+    }
+
+    *px_p = shade_cache.res[shade];
+}
+
+/**
+ * Blend a 4 bpp glyph directly into the display buffer.
+ * A byte of the glyph is processed at once (2 pixels) and the transparent bytes are skipped.
+ * @param pos_x x coordinate of the glyph's bitmap
+ * @param pos_y y coordinate of the glyph's bitmap
+ * @param g descriptor of the glyph
+ * @param col_start first column to draw
+ * @param col_end column after the last column to draw
+ * @param row_start first row to draw
+ * @param row_end row after the last row to draw
+ * @param map_p bitmap of the glyph
+ * @param color color of the glyph
+ * @param bpp_opa_table_p opacity of the shades (already scaled with `opa`)
+ * @param opa opacity of the glyph
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal_4bpp(lv_coord_t pos_x, lv_coord_t pos_y, const lv_font_glyph_dsc_t * g,
+                                                          int32_t col_start, int32_t col_end, int32_t row_start, int32_t row_end,
+                                                          const uint8_t * map_p, lv_color_t color, const lv_opa_t * bpp_opa_table_p, lv_opa_t opa)
+{
+    if(shade_cache.color.full != color.full || shade_cache.opa != opa) {
+        shade_cache.color = color;
+        shade_cache.opa = opa;
+        shade_cache.valid = 0;
+    }
+
+    lv_disp_t * disp    = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    int32_t vdb_width   = lv_area_get_width(&vdb->area);
+    lv_color_t * vdb_buf_tmp = vdb->buf_act;
+    vdb_buf_tmp += (pos_y + row_start - vdb->area.y1) * vdb_width + pos_x - vdb->area.x1;
+
+    /*The rows are not byte aligned so count the pixels (nibbles) from the start of the bitmap*/
+    int32_t box_w = g->box_w;
+    int32_t row;
+    for(row = row_start; row < row_end; row++) {
+        uint32_t px_i = row * box_w + col_start;
+        int32_t col = col_start;
+
+        /*Leading pixel in the low nibble*/
+        if((px_i & 0x1) && col < col_end) {
+            uint32_t shade = map_p[px_i >> 1] & 0x0F;
+            if(shade) blend_shade(&vdb_buf_tmp[col], shade, color, bpp_opa_table_p);
+            px_i++;
+            col++;
+        }
+
+        /*2 pixels in a byte*/
+        const uint8_t * byte_p = &map_p[px_i >> 1];
+        for(; col + 1 < col_end; col += 2) {
+            uint32_t byte = *byte_p;
+            byte_p++;
+            if(byte == 0) continue;
+
+            if(byte == 0xFF && bpp_opa_table_p[0xF] == LV_OPA_COVER) {
+                vdb_buf_tmp[col] = color;
+                vdb_buf_tmp[col + 1] = color;
+                continue;
+            }
+
+            if(byte >> 4) blend_shade(&vdb_buf_tmp[col], byte >> 4, color, bpp_opa_table_p);
+            if(byte & 0x0F) blend_shade(&vdb_buf_tmp[col + 1], byte & 0x0F, color, bpp_opa_table_p);
+        }
+
+        /*Trailing pixel in the high nibble*/
+        if(col < col_end) {
+            uint32_t shade = *byte_p >> 4;
+            if(shade) blend_shade(&vdb_buf_tmp[col], shade, color, bpp_opa_table_p);
+        }
+
+        vdb_buf_tmp += vdb_width;
+    }
+}
+
+#if LV_USE_FONT_SUBPX
+/**
+ * Blend a 4 bpp sub-pixel rendered glyph directly into the display buffer like `draw_letter_subpx` does.
+ * 3 bytes of the glyph are processed at once (2 pixels) and the transparent ones are skipped.
+ * @param pos_x x coordinate of the glyph's bitmap
+ * @param pos_y y coordinate of the glyph's bitmap
+ * @param g descriptor of the glyph
+ * @param col_start first sub-pixel column to draw
+ * @param col_end sub-pixel column after the last column to draw
+ * @param row_start first row to draw
+ * @param row_end row after the last row to draw
+ * @param map_p bitmap of the glyph
+ * @param color color of the glyph
+ * @param opa opacity of the glyph
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_subpx_4bpp(lv_coord_t pos_x, lv_coord_t pos_y, const lv_font_glyph_dsc_t * g,
+                                                         int32_t col_start, int32_t col_end, int32_t row_start, int32_t row_end,
+                                                         const uint8_t * map_p, lv_color_t color, lv_opa_t opa)
+{
+#if LV_COLOR_16_SWAP == 0
+    uint8_t txt_rgb[3] = {color.ch.red, color.ch.green, color.ch.blue};
+#else
+    uint8_t txt_rgb[3] = {color.ch.red, (color.ch.green_h << 3) + color.ch.green_l, color.ch.blue};
+#endif
+
+    /*Opacity of the shades*/
+    lv_opa_t shade_opa[16];
+    uint32_t i;
+    for(i = 0; i < 16; i++) {
+        shade_opa[i] = opa == LV_OPA_COVER ? _lv_bpp4_opa_table[i] : (uint32_t)((uint32_t)_lv_bpp4_opa_table[i] * opa) >> 8;
+    }
+
+    /*Without other masks only the opacity is applied on the mixed colors*/
+    bool opa_cover = opa > LV_OPA_MAX;
+
+    lv_disp_t * disp    = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    int32_t vdb_width   = lv_area_get_width(&vdb->area);
+    lv_color_t * vdb_buf_tmp = vdb->buf_act;
+    vdb_buf_tmp += (pos_y + row_start - vdb->area.y1) * vdb_width + pos_x + col_start / 3 - vdb->area.x1;
+
+    int32_t box_w = g->box_w;
+    int32_t px_cnt = (col_end - col_start) / 3;
+    int32_t row;
+    for(row = row_start; row < row_end; row++) {
+        uint32_t subpx_i = row * box_w + col_start;
+        int32_t x = 0;
+        while(x < px_cnt) {
+            uint8_t font_rgb[3];
+
+            /*2 pixels in 3 bytes if they are byte aligned*/
+            if((subpx_i & 0x1) == 0 && x + 1 < px_cnt) {
+                const uint8_t * byte_p = &map_p[subpx_i >> 1];
+                if((byte_p[0] | byte_p[1] | byte_p[2]) == 0) {
+                    x += 2;
+                    subpx_i += 6;
+                    continue;
+                }
+            }
+
+            font_rgb[0] = shade_opa[(map_p[subpx_i >> 1] >> ((subpx_i & 0x1) ? 0 : 4)) & 0x0F];
+            subpx_i++;
+            font_rgb[1] = shade_opa[(map_p[subpx_i >> 1] >> ((subpx_i & 0x1) ? 0 : 4)) & 0x0F];
+            subpx_i++;
+            font_rgb[2] = shade_opa[(map_p[subpx_i >> 1] >> ((subpx_i & 0x1) ? 0 : 4)) & 0x0F];
+            subpx_i++;
+
+            if(font_rgb[0] != 0 || font_rgb[1] != 0 || font_rgb[2] != 0) {
+                lv_color_t res_color = subpx_mix(txt_rgb, font_rgb, vdb_buf_tmp[x]);
+                vdb_buf_tmp[x] = opa_cover ? res_color : lv_color_mix(res_color, vdb_buf_tmp[x], opa);
+            }
+            x++;
+        }
+
+        vdb_buf_tmp += vdb_width;
+    }
+}
+#endif
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -854,3 +1424,409 @@ static uint8_t hex_char_to_num(char hex)
 
     return result;
 }
+
+#if LV_LABEL_CACHE_SIZE
+/**
+ * Draw a text by blending its pre-rendered coverage map with the text color.
+ * Render the map first if it's not available yet or the parameters have changed.
+ * @param coords coordinates of the label
+ * @param mask the label will be drawn only in this area
+ * @param dsc pointer to draw descriptor
+ * @param txt `\0` terminated text to write
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ * @return true: the text is drawn; false: the text can't be cached, draw it normally
+ */
+static bool label_cache_draw(const lv_area_t * coords, const lv_area_t * mask, const lv_draw_label_dsc_t * dsc,
+                             const char * txt, lv_draw_label_hint_t * hint)
+{
+    /*Only single colored, still texts can be pre-rendered*/
+    if(dsc->ofs_x != 0 || dsc->ofs_y != 0) return false;
+    if(dsc->flag & LV_TXT_FLAG_RECOLOR) return false;
+    if(dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) return false;
+    if(dsc->decor != LV_TEXT_DECOR_NONE) return false;
+#if LV_USE_FONT_SUBPX == 0
+    if(dsc->font->subpx) return false;
+#endif
+    /*The map stores either sub-pixels or pixels so all fonts of the fallback chain need the same layout*/
+    const lv_font_t * fallback;
+    for(fallback = dsc->font->fallback; fallback != NULL; fallback = fallback->fallback) {
+        if(fallback->subpx != dsc->font->subpx) return false;
+    }
+
+    /*Be sure the map belongs to the current text. Rebuilding the line table drops the map too.*/
+    lv_coord_t max_w = (dsc->flag & LV_TXT_FLAG_EXPAND) ? LV_COORD_MAX : lv_area_get_width(coords);
+    if(_lv_draw_label_hint_update(hint, txt, dsc->font, dsc->letter_space, max_w, dsc->flag) == false) return false;
+
+    lv_draw_label_cache_t * cache = hint->cache;
+    if(cache) {
+        if(cache->coords_w != lv_area_get_width(coords) || cache->coords_h != lv_area_get_height(coords) ||
+           cache->line_space != dsc->line_space || cache->flag != dsc->flag || cache->bidi_dir != dsc->bidi_dir) {
+            label_cache_free(hint);
+            cache = NULL;
+        }
+    }
+
+    if(cache == NULL) {
+        cache = label_cache_render(coords, dsc, txt, hint);
+        if(cache == NULL) return false;
+    }
+    /*Move to the head of the LRU list*/
+    else if(cache != cache_head) {
+        cache->prev->next = cache->next;
+        if(cache->next) cache->next->prev = cache->prev;
+        else cache_tail = cache->prev;
+
+        cache->prev = NULL;
+        cache->next = cache_head;
+        cache_head->prev = cache;
+        cache_head = cache;
+    }
+    label_cache_use(cache);
+
+    lv_area_t area;
+    area.x1 = coords->x1 + cache->area.x1;
+    area.y1 = coords->y1 + cache->area.y1;
+    area.x2 = coords->x1 + cache->area.x2;
+    area.y2 = coords->y1 + cache->area.y2;
+
+    lv_area_t draw_area;
+    if(_lv_area_intersect(&draw_area, &area, mask) == false) return true;
+
+    if(cache->px_size == 3) {
+#if LV_USE_FONT_SUBPX
+        label_cache_blend_subpx(&draw_area, &area, cache, dsc);
+#endif
+        return true;
+    }
+
+    int32_t map_w = lv_area_get_width(&area);
+    int32_t draw_w = lv_area_get_width(&draw_area);
+    const lv_opa_t * map_p = (const lv_opa_t *)(cache + 1);
+    map_p += (draw_area.y1 - area.y1) * map_w + (draw_area.x1 - area.x1);
+
+    lv_opa_t opa = dsc->opa > LV_OPA_MAX ? LV_OPA_COVER : dsc->opa;
+    uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
+    lv_opa_t * mask_buf = _lv_mem_buf_get(draw_w);
+
+    lv_area_t fill_area;
+    fill_area.x1 = draw_area.x1;
+    fill_area.x2 = draw_area.x2;
+
+    int32_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        /*The blending might modify the mask so always use a copy*/
+        _lv_memcpy(mask_buf, map_p, draw_w);
+        map_p += map_w;
+
+        /*Apply masks if any*/
+        if(other_mask_cnt) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, draw_area.x1, y, draw_w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) continue;
+        }
+
+        fill_area.y1 = y;
+        fill_area.y2 = y;
+        _lv_blend_fill_spans(&draw_area, &fill_area, dsc->color, mask_buf, LV_DRAW_MASK_RES_CHANGED, opa,
+                             dsc->blend_mode);
+    }
+
+    _lv_mem_buf_release(mask_buf);
+
+    return true;
+}
+
+#if LV_USE_FONT_SUBPX
+/**
+ * Blend a pre-rendered sub-pixel coverage map like `draw_letter_subpx` blends the letters
+ * @param draw_area the area to draw. It has to be inside `area`.
+ * @param area absolute coordinates of the map
+ * @param cache the cache entry with the map
+ * @param dsc pointer to draw descriptor
+ */
+LV_ATTRIBUTE_FAST_MEM static void label_cache_blend_subpx(const lv_area_t * draw_area, const lv_area_t * area,
+                                                          const lv_draw_label_cache_t * cache, const lv_draw_label_dsc_t * dsc)
+{
+    int32_t map_w = lv_area_get_width(area) * 3;
+    int32_t draw_w = lv_area_get_width(draw_area);
+    const lv_opa_t * map_p = (const lv_opa_t *)(cache + 1);
+    map_p += (draw_area->y1 - area->y1) * map_w + (draw_area->x1 - area->x1) * 3;
+
+    lv_opa_t opa = dsc->opa > LV_OPA_MAX ? LV_OPA_COVER : dsc->opa;
+    lv_color_t color = dsc->color;
+#if LV_COLOR_16_SWAP == 0
+    uint8_t txt_rgb[3] = {color.ch.red, color.ch.green, color.ch.blue};
+#else
+    uint8_t txt_rgb[3] = {color.ch.red, (color.ch.green_h << 3) + color.ch.green_l, color.ch.blue};
+#endif
+
+    lv_disp_t * disp    = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    int32_t vdb_width   = lv_area_get_width(&vdb->area);
+    const lv_color_t * vdb_buf_tmp = vdb->buf_act;
+    vdb_buf_tmp += (draw_area->y1 - vdb->area.y1) * vdb_width + draw_area->x1 - vdb->area.x1;
+
+    uint8_t other_mask_cnt = lv_draw_mask_get_cnt();
+    lv_opa_t * mask_buf = _lv_mem_buf_get(draw_w);
+    lv_color_t * color_buf = _lv_mem_buf_get(draw_w * sizeof(lv_color_t));
+
+    lv_area_t row_area;
+    row_area.x1 = draw_area->x1;
+    row_area.x2 = draw_area->x2;
+
+    int32_t x, y;
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        const lv_opa_t * px_p = map_p;
+        for(x = 0; x < draw_w; x++) {
+            uint8_t font_rgb[3];
+            if(opa == LV_OPA_COVER) {
+                font_rgb[0] = px_p[0];
+                font_rgb[1] = px_p[1];
+                font_rgb[2] = px_p[2];
+            }
+            else {
+                font_rgb[0] = (uint32_t)((uint32_t)px_p[0] * opa) >> 8;
+                font_rgb[1] = (uint32_t)((uint32_t)px_p[1] * opa) >> 8;
+                font_rgb[2] = (uint32_t)((uint32_t)px_p[2] * opa) >> 8;
+            }
+            px_p += 3;
+
+            if(font_rgb[0] == 0 && font_rgb[1] == 0 && font_rgb[2] == 0) {
+                mask_buf[x] = LV_OPA_TRANSP;
+            }
+            else {
+                mask_buf[x] = LV_OPA_COVER;
+                color_buf[x] = subpx_mix(txt_rgb, font_rgb, vdb_buf_tmp[x]);
+            }
+        }
+        map_p += map_w;
+        vdb_buf_tmp += vdb_width;
+
+        /*Apply masks if any*/
+        if(other_mask_cnt) {
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, draw_area->x1, y, draw_w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) continue;
+        }
+
+        row_area.y1 = y;
+        row_area.y2 = y;
+        _lv_blend_map(draw_area, &row_area, color_buf, mask_buf, LV_DRAW_MASK_RES_CHANGED, opa, dsc->blend_mode);
+    }
+
+    _lv_mem_buf_release(mask_buf);
+    _lv_mem_buf_release(color_buf);
+}
+#endif
+
+/**
+ * Render the coverage map of a text and add it to the cache.
+ * The map has the area of the letters visible in the label's area, including the parts reaching out of it.
+ * Less recently used maps are freed to keep the cache in `LV_LABEL_CACHE_SIZE`.
+ * @param coords coordinates of the label
+ * @param dsc pointer to draw descriptor
+ * @param txt `\0` terminated text to write
+ * @param hint pointer to a `lv_draw_label_hint_t` variable with up to date line table
+ * @return the new cache entry or NULL if the text is too large or out of memory
+ */
+static lv_draw_label_cache_t * label_cache_render(const lv_area_t * coords, const lv_draw_label_dsc_t * dsc,
+                                                  const char * txt, lv_draw_label_hint_t * hint)
+{
+    int32_t w = lv_area_get_width(coords);
+    int32_t h = lv_area_get_height(coords);
+    if(w <= 0 || h <= 0) return NULL;
+
+    uint8_t px_size = dsc->font->subpx ? 3 : 1;
+
+    lv_draw_label_dsc_t cov_dsc;
+    _lv_memcpy_small(&cov_dsc, dsc, sizeof(lv_draw_label_dsc_t));
+    cov_dsc.opa = LV_OPA_COVER;
+
+    /*Measure the letters first with the normal drawer to allocate only their area*/
+    cov_area.x1 = LV_COORD_MAX;
+    cov_area.y1 = LV_COORD_MAX;
+    cov_area.x2 = LV_COORD_MIN;
+    cov_area.y2 = LV_COORD_MIN;
+    cov_px_size = px_size;
+    cov_measure = true;
+    lv_draw_label(coords, coords, &cov_dsc, txt, hint);
+    cov_measure = false;
+
+    lv_area_t area;
+    if(cov_area.x1 <= cov_area.x2) {
+        area.x1 = cov_area.x1 - coords->x1;
+        area.y1 = cov_area.y1 - coords->y1;
+        area.x2 = cov_area.x2 - coords->x1;
+        area.y2 = cov_area.y2 - coords->y1;
+    }
+    /*Nothing is visible (e.g. only spaces). Keep an empty entry to not render it again*/
+    else {
+        area.x1 = 0;
+        area.y1 = 0;
+        area.x2 = -1;
+        area.y2 = -1;
+    }
+
+    uint32_t map_size = (uint32_t)lv_area_get_width(&area) * lv_area_get_height(&area) * px_size;
+    uint32_t size = sizeof(lv_draw_label_cache_t) + map_size;
+
+    /* The maps drawn in this refresh are not freed, else the labels of a screen larger than the cache
+     * would free each other's maps in every refresh. Don't render the text if it doesn't fit next to them.*/
+    if(cache_refr_used + size > LV_LABEL_CACHE_SIZE) return NULL;
+
+    /*Free the least recently used maps to fit into the cache (the ones drawn in this refresh are the most recent)*/
+    while(cache_tail && cache_tail->refr != cache_refr && cache_used + size > LV_LABEL_CACHE_SIZE) {
+        label_cache_free(cache_tail->hint);
+    }
+
+    lv_draw_label_cache_t * cache = NULL;
+    if(cache_used + size <= LV_LABEL_CACHE_SIZE) cache = lv_mem_alloc(size);
+    if(cache == NULL) return NULL;
+
+    /*Render with the normal drawer. The letters will be written to the map*/
+    if(map_size) {
+        lv_opa_t * map_p = (lv_opa_t *)(cache + 1);
+        _lv_memset_00(map_p, map_size);
+        cov_buf = map_p;
+        lv_draw_label(coords, &cov_area, &cov_dsc, txt, hint);
+        cov_buf = NULL;
+    }
+
+    cache->hint = hint;
+    cache->coords_w = w;
+    cache->coords_h = h;
+    cache->line_space = dsc->line_space;
+    cache->flag = dsc->flag;
+    cache->bidi_dir = dsc->bidi_dir;
+    lv_area_copy(&cache->area, &area);
+    cache->size = size;
+    cache->px_size = px_size;
+    cache->refr = cache_refr - 1;
+
+    cache->prev = NULL;
+    cache->next = cache_head;
+    if(cache_head) cache_head->prev = cache;
+    else cache_tail = cache;
+    cache_head = cache;
+    cache_used += size;
+
+    hint->cache = cache;
+
+    return cache;
+}
+
+/**
+ * Free the pre-rendered text of a hint and remove it from the cache
+ * @param hint pointer to a `lv_draw_label_hint_t` variable with cache
+ */
+static void label_cache_free(lv_draw_label_hint_t * hint)
+{
+    lv_draw_label_cache_t * cache = hint->cache;
+
+    if(cache->prev) cache->prev->next = cache->next;
+    else cache_head = cache->next;
+    if(cache->next) cache->next->prev = cache->prev;
+    else cache_tail = cache->prev;
+
+    cache_used -= cache->size;
+    if(cache->refr == cache_refr) cache_refr_used -= cache->size;
+    lv_mem_free(cache);
+    hint->cache = NULL;
+}
+
+/**
+ * Mark a pre-rendered text as drawn in the current refresh
+ * @param cache pointer to a cache entry
+ */
+static void label_cache_use(lv_draw_label_cache_t * cache)
+{
+    if(cache->refr == cache_refr) return;
+
+    cache->refr = cache_refr;
+    cache_refr_used += cache->size;
+}
+
+/**
+ * Add the coverage of a letter to `cov_buf`
+ * @param pos_x x coordinate of the letter's bitmap
+ * @param pos_y y coordinate of the letter's bitmap
+ * @param g descriptor of the letter
+ * @param clip_area render only this area. It has to be inside `cov_area`.
+ * @param map_p bitmap of the letter
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_cov(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
+                                                  const lv_area_t * clip_area, const uint8_t * map_p)
+{
+    const uint8_t * bpp_opa_table_p;
+    uint32_t bitmask_init;
+    uint32_t bpp = g->bpp;
+    if(bpp == 3) bpp = 4;
+
+    switch(bpp) {
+        case 1:
+            bpp_opa_table_p = _lv_bpp1_opa_table;
+            bitmask_init  = 0x80;
+            break;
+        case 2:
+            bpp_opa_table_p = _lv_bpp2_opa_table;
+            bitmask_init  = 0xC0;
+            break;
+        case 4:
+            bpp_opa_table_p = _lv_bpp4_opa_table;
+            bitmask_init  = 0xF0;
+            break;
+        case 8:
+            bpp_opa_table_p = _lv_bpp8_opa_table;
+            bitmask_init  = 0xFF;
+            break;
+        default:
+            LV_LOG_WARN("lv_draw_letter: invalid bpp");
+            return; /*Invalid bpp. Can't render the letter*/
+    }
+
+    int32_t col, row;
+    int32_t box_w = g->box_w;
+    int32_t box_h = g->box_h;
+    int32_t width_bit = box_w * bpp; /*Letter width in bits*/
+
+    /* Calculate the col/row start/end on the map.
+     * With sub-pixel fonts a column is a sub-pixel and the incomplete last pixel is dropped like in `draw_letter_subpx`*/
+    int32_t px_size = cov_px_size;
+    int32_t px_w = box_w / px_size;
+    int32_t col_start = pos_x >= clip_area->x1 ? 0 : (clip_area->x1 - pos_x) * px_size;
+    int32_t col_end   = pos_x + px_w <= clip_area->x2 ? px_w * px_size : (clip_area->x2 - pos_x + 1) * px_size;
+    int32_t row_start = pos_y >= clip_area->y1 ? 0 : clip_area->y1 - pos_y;
+    int32_t row_end   = pos_y + box_h <= clip_area->y2 ? box_h : clip_area->y2 - pos_y + 1;
+
+    int32_t cov_w = lv_area_get_width(&cov_area) * px_size;
+    lv_opa_t * cov_p = cov_buf + (pos_y + row_start - cov_area.y1) * cov_w + (pos_x - cov_area.x1) * px_size + col_start;
+
+    uint32_t col_bit_max = 8 - bpp;
+    for(row = row_start; row < row_end; row++) {
+        uint32_t bit_ofs = (row * width_bit) + (col_start * bpp);
+        const uint8_t * row_p = map_p + (bit_ofs >> 3);
+        uint32_t col_bit = bit_ofs & 0x7;
+        uint32_t bitmask = bitmask_init >> col_bit;
+        lv_opa_t * px_p = cov_p;
+
+        for(col = col_start; col < col_end; col++) {
+            uint8_t letter_px = (*row_p & bitmask) >> (col_bit_max - col_bit);
+            if(letter_px) {
+                /*Overlapping letters cover each other like blending them one by one*/
+                lv_opa_t px_opa = bpp_opa_table_p[letter_px];
+                *px_p = *px_p + px_opa - LV_MATH_UDIV255(*px_p * px_opa);
+            }
+
+            if(col_bit < col_bit_max) {
+                col_bit += bpp;
+                bitmask = bitmask >> bpp;
+            }
+            else {
+                col_bit = 0;
+                bitmask = bitmask_init;
+                row_p++;
+            }
+            px_p++;
+        }
+        cov_p += cov_w;
+    }
+}
+#endif
@@ -44,21 +44,49 @@ typedef struct {
     lv_blend_mode_t blend_mode;
 } lv_draw_label_dsc_t;
 
-/** Store some info to speed up drawing of very large texts
- * It takes a lot of time to get the first visible character because
- * all the previous characters needs to be checked to calculate the positions.
- * This structure stores an earlier (e.g. at -1000 px) coordinate and the index of that line.
- * Therefore the calculations can start from here.*/
+/** Set in `lv_draw_label_hint_t.bidi_pos` for the characters of right-to-left runs*/
+#define LV_DRAW_LABEL_BIDI_POS_RTL 0x8000
+
+/** A line of a text in a `lv_draw_label_hint_t` line table*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the first character of the line*/
+    lv_coord_t width;   /**< Width of the line in pixels*/
+} lv_draw_label_line_t;
+
+/** Store the line breaks of a text to speed up its drawing.
+ * Finding the lines requires measuring every character before them, so
+ * the line table is built once and reused while the text, the font, the letter space,
+ * the max. width and the line breaking flags are the same.
+ * Build it with `_lv_draw_label_hint_update` and free it with `_lv_draw_label_hint_invalidate`.*/
 typedef struct {
-    /** Index of the line at `y` coordinate*/
-    int32_t line_start;
+    /** `line_cnt + 1` lines. The last one is the end of the text. `NULL` if not built yet*/
+    lv_draw_label_line_t * lines;
+    uint32_t line_cnt;
+
+    /** Width of the longest line*/
+    lv_coord_t max_line_w;
+
+    /*The parameters the table was built with*/
+    const char * txt;
+    const lv_font_t * font;
+    lv_coord_t max_w;
+    lv_style_int_t letter_space;
+    lv_txt_flag_t flag;
 
-    /** Give the `y` coordinate of the first letter at `line start` index. Relative to the label's coordinates*/
-    int32_t y;
+#if LV_USE_BIDI
+    /** The lines in visual order at the same byte index as in `txt`.
+     * `NULL` if the visual order is the same as the logical order. Built by `_lv_draw_label_hint_update_bidi`*/
+    char * bidi_txt;
+    /** Logical character index in its line of the character at each byte of `bidi_txt`
+     * ORed with `LV_DRAW_LABEL_BIDI_POS_RTL` in right-to-left runs*/
+    uint16_t * bidi_pos;
+    lv_bidi_dir_t bidi_dir;
+    uint8_t bidi_valid : 1;
+#endif
 
-    /** The 'y1' coordinate of the label when the hint was saved.
-     * Used to invalidate the hint if the label has moved too much. */
-    int32_t coord_y;
+    /** Pre-rendered coverage map of the text. Built only if `cache_en` is set. See `LV_LABEL_CACHE_SIZE`*/
+    struct _lv_draw_label_cache_t * cache;
+    uint8_t cache_en : 1;
 } lv_draw_label_hint_t;
 
 /**********************
@@ -75,13 +103,54 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label_dsc_init(lv_draw_label_dsc_t * dsc);
  * @param mask the label will be drawn only in this area
  * @param dsc pointer to draw descriptor
  * @param txt `\0` terminated text to write
- * @param hint pointer to a `lv_draw_label_hint_t` variable.
- * It is managed by the drawer to speed up the drawing of very long texts (thousands of lines).
+ * @param hint pointer to a `lv_draw_label_hint_t` variable or `NULL`.
+ * Its line table (and pre-rendered text if enabled) is built and reused by the drawer
+ * to not measure (and render) the text on every redraw.
  */
 LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask,
                                          const lv_draw_label_dsc_t * dsc,
                                          const char * txt, lv_draw_label_hint_t * hint);
 
+/**
+ * Be sure the line table of a hint belongs to the given text and parameters.
+ * Rebuild it if any of them has changed.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ * @param txt `\0` terminated text
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w max. width of the lines
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the line table is valid; false: out of memory
+ */
+bool _lv_draw_label_hint_update(lv_draw_label_hint_t * hint, const char * txt, const lv_font_t * font,
+                                lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
+
+#if LV_USE_BIDI
+/**
+ * Be sure the visual order of the lines of a hint belongs to the given base direction.
+ * Rebuild it if the direction has changed. The line table needs to be up to date.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable with line table
+ * @param base_dir base direction of the text
+ * @return true: `bidi_txt` and `bidi_pos` are valid; false: out of memory
+ */
+bool _lv_draw_label_hint_update_bidi(lv_draw_label_hint_t * hint, lv_bidi_dir_t base_dir);
+#endif
+
+/**
+ * Free the line table, the visual order and the pre-rendered text of a hint. They will be built again on next use.
+ * Required if the text was modified in place.
+ * @param hint pointer to a `lv_draw_label_hint_t` variable
+ */
+void _lv_draw_label_hint_invalidate(lv_draw_label_hint_t * hint);
+
+#if LV_LABEL_CACHE_SIZE
+/**
+ * Tell the cache of the pre-rendered texts that a refresh is ready.
+ * The texts drawn in it can be freed again for new ones.
+ */
+void _lv_draw_label_cache_refr_ready(void);
+#endif
+
 //! @endcond
 /***********************
  * GLOBAL VARIABLES
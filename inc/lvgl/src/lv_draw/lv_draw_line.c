@@ -403,70 +403,29 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_skew(const lv_point_t * point1, cons
         mask_bottom_id = lv_draw_mask_add(&mask_bottom_param, NULL);
     }
 
-    lv_disp_t * disp    = _lv_refr_get_disp_refreshing();
-    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
-
-    const lv_area_t * disp_area = &vdb->area;
-
-    /*Store the coordinates of the `draw_a` relative to the VDB */
-    draw_area.x1 -= disp_area->x1;
-    draw_area.y1 -= disp_area->y1;
-    draw_area.x2 -= disp_area->x1;
-    draw_area.y2 -= disp_area->y1;
-
-    /* The real draw area is around the line.
-     * It's easy to calculate with steep lines, but the area can be very wide with very flat lines.
-     * So deal with it only with steep lines. */
-    int32_t draw_area_w = lv_area_get_width(&draw_area);
-
-    /*Draw the background line by line*/
-    int32_t h;
-    uint32_t hor_res = (uint32_t)lv_disp_get_hor_res(disp);
-    size_t mask_buf_size = LV_MATH_MIN(lv_area_get_size(&draw_area), hor_res);
-    lv_opa_t * mask_buf = _lv_mem_buf_get(mask_buf_size);
+    /* The line can be very wide with flat lines so don't process the whole `draw_area`.
+     * Limit each row to the pixels which are kept by the line's own masks.*/
+    lv_opa_t * mask_buf = _lv_mem_buf_get(lv_area_get_width(&draw_area));
 
     lv_area_t fill_area;
-    fill_area.x1 = draw_area.x1 + disp_area->x1;
-    fill_area.x2 = draw_area.x2 + disp_area->x1;
-    fill_area.y1 = draw_area.y1 + disp_area->y1;
-    fill_area.y2 = fill_area.y1;
-
-    int32_t x = vdb->area.x1 + draw_area.x1;
-
-    uint32_t mask_p = 0;
-
-    _lv_memset_ff(mask_buf, mask_buf_size);
-    /*Fill the first row with 'color'*/
-    for(h = draw_area.y1 + disp_area->y1; h <= draw_area.y2 + disp_area->y1; h++) {
-
-        lv_draw_mask_res_t mask_res = lv_draw_mask_apply(&mask_buf[mask_p], x, h, draw_area_w);
-        if(mask_res == LV_DRAW_MASK_RES_TRANSP) {
-            _lv_memset_00(&mask_buf[mask_p], draw_area_w);
-        }
-
-        mask_p += draw_area_w;
-        if((uint32_t) mask_p + draw_area_w < mask_buf_size) {
-            fill_area.y2 ++;
-        }
-        else {
-            _lv_blend_fill(&fill_area, clip,
-                           dsc->color, mask_buf, LV_DRAW_MASK_RES_CHANGED, dsc->opa,
-                           dsc->blend_mode);
-
-            fill_area.y1 = fill_area.y2 + 1;
-            fill_area.y2 = fill_area.y1;
-            mask_p = 0;
-            _lv_memset_ff(mask_buf, mask_buf_size);
+    for(fill_area.y1 = draw_area.y1; fill_area.y1 <= draw_area.y2; fill_area.y1++) {
+        fill_area.y2 = fill_area.y1;
+        fill_area.x1 = draw_area.x1;
+        fill_area.x2 = draw_area.x2;
+        lv_draw_mask_line_limit_x(&mask_left_param, fill_area.y1, &fill_area.x1, &fill_area.x2);
+        lv_draw_mask_line_limit_x(&mask_right_param, fill_area.y1, &fill_area.x1, &fill_area.x2);
+        if(!dsc->raw_end) {
+            lv_draw_mask_line_limit_x(&mask_top_param, fill_area.y1, &fill_area.x1, &fill_area.x2);
+            lv_draw_mask_line_limit_x(&mask_bottom_param, fill_area.y1, &fill_area.x1, &fill_area.x2);
         }
-    }
+        if(fill_area.x1 > fill_area.x2) continue;
 
-    /*Flush the last part*/
-    if(fill_area.y1 != fill_area.y2) {
-        fill_area.y2--;
-        _lv_blend_fill(&fill_area, clip,
-                       dsc->color, mask_buf, LV_DRAW_MASK_RES_CHANGED, dsc->opa,
+        int32_t fill_w = lv_area_get_width(&fill_area);
+        _lv_memset_ff(mask_buf, fill_w);
+        lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, fill_area.x1, fill_area.y1, fill_w);
+        _lv_blend_fill(clip, &fill_area,
+                       dsc->color, mask_buf, mask_res, dsc->opa,
                        dsc->blend_mode);
-
     }
 
     _lv_mem_buf_release(mask_buf);
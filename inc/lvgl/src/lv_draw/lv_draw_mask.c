@@ -11,15 +11,98 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_lru.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
 
+/* The specialized mask kernels.
+ * Every row describes a mask stack which is common in the library:
+ * X(name, number of masks, type of 1st mask, type of 2nd mask, type of 3rd mask, type of 4th mask)
+ * The types are the ones applied by `lv_draw_rect` (radius, border/outline: radius + inverted radius),
+ * `lv_draw_arc` (angle + radius + inverted radius), `lv_draw_line` (2 or 4 lines)
+ * and `lv_draw_triangle` (3 lines). Every other combination uses `mask_kernel_generic`.*/
+#define MASK_KERNEL_LIST(X)                                          \
+    X(radius,              1, RADIUS, NONE,   NONE,   NONE)         \
+    X(radius_radius,       2, RADIUS, RADIUS, NONE,   NONE)         \
+    X(angle_radius_radius, 3, ANGLE,  RADIUS, RADIUS, NONE)         \
+    X(line_line,           2, LINE,   LINE,   NONE,   NONE)         \
+    X(line_line_line,      3, LINE,   LINE,   LINE,   NONE)         \
+    X(line_line_line_line, 4, LINE,   LINE,   LINE,   LINE)
+
+#define MASK_KERNEL_MAX_NUM  4
+
+/*Max. number of different corner radii to buffer (the RAM limit is `LV_RADIUS_MASK_CACHE_SIZE`)*/
+#define RADIUS_CACHE_ENTRY_NUM  8
+
+#define MASK_KERNEL_CB_NONE     NULL
+#define MASK_KERNEL_CB_LINE     lv_draw_mask_line
+#define MASK_KERNEL_CB_RADIUS   lv_draw_mask_radius
+#define MASK_KERNEL_CB_ANGLE    lv_draw_mask_angle
+
+#define MASK_KERNEL_PARAM_LINE      lv_draw_mask_line_param_t
+#define MASK_KERNEL_PARAM_RADIUS    lv_draw_mask_radius_param_t
+#define MASK_KERNEL_PARAM_ANGLE     lv_draw_mask_angle_param_t
+
+/*Apply the `i`th mask of a kernel. Calls the mask function directly so it can be inlined.*/
+#define MASK_KERNEL_STEP(type, i)   MASK_KERNEL_STEP_##type(type, i)
+#define MASK_KERNEL_STEP_NONE(type, i)
+#define MASK_KERNEL_STEP_LINE(type, i)      MASK_KERNEL_CALL(type, i)
+#define MASK_KERNEL_STEP_RADIUS(type, i)    MASK_KERNEL_CALL(type, i)
+#define MASK_KERNEL_STEP_ANGLE(type, i)     MASK_KERNEL_CALL(type, i)
+#define MASK_KERNEL_CALL(type, i)                                                                           \
+    res = MASK_KERNEL_CB_##type(mask_buf, abs_x, abs_y, len, (MASK_KERNEL_PARAM_##type *)kernel_param[i]);  \
+    if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;                                      \
+    else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+
+#define MASK_KERNEL_PROTO(name, cnt, t0, t1, t2, t3)                                                    \
+    LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_kernel_##name(lv_opa_t * mask_buf, lv_coord_t abs_x, \
+                                                                       lv_coord_t abs_y, lv_coord_t len);
+
+#define MASK_KERNEL_DEF(name, cnt, t0, t1, t2, t3)                                                      \
+    LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_kernel_##name(lv_opa_t * mask_buf, lv_coord_t abs_x, \
+                                                                       lv_coord_t abs_y, lv_coord_t len) \
+    {                                                                                                   \
+        bool changed = false;                                                                           \
+        lv_draw_mask_res_t res;                                                                         \
+        MASK_KERNEL_STEP(t0, 0)                                                                         \
+        MASK_KERNEL_STEP(t1, 1)                                                                         \
+        MASK_KERNEL_STEP(t2, 2)                                                                         \
+        MASK_KERNEL_STEP(t3, 3)                                                                         \
+        return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;                        \
+    }
+
+#define MASK_KERNEL_DSC(name, cnt, t0, t1, t2, t3)                                                      \
+    {mask_kernel_##name, cnt, {(lv_draw_mask_xcb_t)MASK_KERNEL_CB_##t0, (lv_draw_mask_xcb_t)MASK_KERNEL_CB_##t1, \
+                               (lv_draw_mask_xcb_t)MASK_KERNEL_CB_##t2, (lv_draw_mask_xcb_t)MASK_KERNEL_CB_##t3}},
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * A mask kernel applies the whole list of added masks on a line.
+ * The kernel is selected when the mask list changes so `lv_draw_mask_apply` doesn't need to
+ * walk the list and call the masks through function pointers on every line.
+ */
+typedef lv_draw_mask_res_t (*mask_kernel_t)(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len);
+
+#if LV_RADIUS_MASK_CACHE_SIZE
+/**
+ * The coverage of a rounded corner with a given radius.
+ * `buf` has `radius` rows with `radius` values each:
+ * the coverage of the top left corner starting from the top left pixel.
+ * The other corners and the inverted masks are derived from it.
+ */
+typedef struct {
+    lv_lru_entry_t lru;
+    lv_opa_t * buf;
+    lv_coord_t radius;  /*0: unused entry*/
+} radius_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -46,16 +129,53 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t line_mask_steep(lv_opa_t * mask_
                                                                 lv_coord_t len,
                                                                 lv_draw_mask_line_param_t * p);
 
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_calc(lv_opa_t * mask_buf, int32_t k, int32_t abs_y,
+                                                                   lv_coord_t len, int32_t w, int32_t h,
+                                                                   lv_draw_mask_radius_param_t * p);
+#if LV_RADIUS_MASK_CACHE_SIZE
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_from_cache(lv_opa_t * mask_buf, int32_t x, lv_coord_t len,
+                                                                         int32_t w, int32_t radius, bool outer,
+                                                                         const lv_opa_t * cov);
+static const lv_opa_t * radius_cache_get(int32_t radius);
+static uint32_t radius_cache_size(const void * entry);
+static void radius_cache_free(void * entry);
+#endif
+
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_res_t * ref, uint32_t x);
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t mask_word_get(const lv_opa_t * mask_buf);
+
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_kernel_none(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                 lv_coord_t abs_y, lv_coord_t len);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_kernel_generic(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                    lv_coord_t abs_y, lv_coord_t len);
+static void mask_kernel_select(void);
+
+MASK_KERNEL_LIST(MASK_KERNEL_PROTO)
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
-/**********************
- *      MACROS
- **********************/
+/*Dispatch table to find the kernel matching the callbacks of the added masks*/
+static const struct {
+    mask_kernel_t kernel;
+    uint8_t cnt;
+    lv_draw_mask_xcb_t cb[MASK_KERNEL_MAX_NUM];
+} kernel_dsc[] = {
+    MASK_KERNEL_LIST(MASK_KERNEL_DSC)
+};
+
+/*The kernel to use with the current mask list and the parameters of its masks*/
+static mask_kernel_t kernel_act = mask_kernel_none;
+static void * kernel_param[MASK_KERNEL_MAX_NUM];
+
+#if LV_RADIUS_MASK_CACHE_SIZE
+static radius_cache_entry_t radius_cache_entries[RADIUS_CACHE_ENTRY_NUM];
+static lv_lru_t radius_cache = _LV_LRU_INIT(radius_cache_entries, LV_RADIUS_MASK_CACHE_SIZE,
+                                            radius_cache_size, radius_cache_free);
+static uint8_t radius_cache_last;       /*The index of the last used entry. Checked first*/
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -83,6 +203,8 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
     LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
     LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
 
+    mask_kernel_select();
+
     return i;
 }
 
@@ -100,22 +222,110 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len)
 {
-    bool changed = false;
-    lv_draw_mask_common_dsc_t * dsc;
+    return kernel_act(mask_buf, abs_x, abs_y, len);
+}
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+/**
+ * Split a line of mask created by `lv_draw_mask_apply` to transparent, fully covered and partially covered spans.
+ * Used internally by the library's drawing routines to fill the covered parts without a mask.
+ * @param mask_buf a mask line
+ * @param len length of the line (in pixel count)
+ * @param spans store the non-transparent spans here
+ * @param span_max size of `spans`. If there are more spans the last one will contain the rest of the line.
+ * @return number of spans written to `spans`
+ */
+LV_ATTRIBUTE_FAST_MEM uint16_t lv_draw_mask_get_spans(const lv_opa_t * mask_buf, lv_coord_t len,
+                                                      lv_draw_mask_span_t * spans, uint16_t span_max)
+{
+    uint16_t cnt = 0;
+    lv_coord_t x = 0;
+
+    while(x < len) {
+        /*Skip the transparent pixels. Check 4 of them at once*/
+        while(x + 4 <= len && mask_word_get(&mask_buf[x]) == 0) x += 4;
+        while(x < len && mask_buf[x] == LV_OPA_TRANSP) x++;
+        if(x >= len) break;
+
+        /*Measure the fully covered run*/
+        lv_coord_t start = x;
+        while(x + 4 <= len && mask_word_get(&mask_buf[x]) == 0xFFFFFFFF) x += 4;
+        while(x < len && mask_buf[x] == LV_OPA_COVER) x++;
+
+        lv_draw_mask_res_t res;
+        if(x - start >= LV_DRAW_MASK_SPAN_MIN_COVER) {
+            res = LV_DRAW_MASK_RES_FULL_COVER;
+        }
+        else {
+            /*Collect the partially covered pixels until a transparent or a long enough covered run*/
+            res = LV_DRAW_MASK_RES_CHANGED;
+            while(x < len && mask_buf[x] != LV_OPA_TRANSP) {
+                if(mask_buf[x] == LV_OPA_COVER) {
+                    lv_coord_t cover_len = 1;
+                    while(x + cover_len < len && cover_len < LV_DRAW_MASK_SPAN_MIN_COVER &&
+                          mask_buf[x + cover_len] == LV_OPA_COVER) cover_len++;
+                    if(cover_len >= LV_DRAW_MASK_SPAN_MIN_COVER) break;
+                    x += cover_len;
+                }
+                else {
+                    x++;
+                }
+            }
+        }
 
-    while(m->param) {
-        dsc = m->param;
-        lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
-        res = dsc->cb(mask_buf, abs_x, abs_y, len, (void *)m->param);
-        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
-        else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+        /*Merge the rest of the line into the last span if there is no more space*/
+        if(cnt == span_max - 1 && x < len) {
+            spans[cnt].x = start;
+            spans[cnt].len = len - start;
+            spans[cnt].res = LV_DRAW_MASK_RES_CHANGED;
+            return cnt + 1;
+        }
 
-        m++;
+        spans[cnt].x = start;
+        spans[cnt].len = x - start;
+        spans[cnt].res = res;
+        cnt++;
     }
 
-    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    return cnt;
+}
+
+/**
+ * Limit a range of a line to the pixels where a line mask can keep something.
+ * Used internally by the library's drawing routines to skip the pixels the mask surely clears.
+ * @param param pointer to an initialized line mask parameter
+ * @param abs_y absolute Y coordinate of the line
+ * @param x1 pointer to the first X coordinate of the range. Increased if the mask clears the pixels before it.
+ * @param x2 pointer to the last X coordinate of the range. Decreased if the mask clears the pixels after it.
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_mask_line_limit_x(const lv_draw_mask_line_param_t * param, lv_coord_t abs_y,
+                                                     lv_coord_t * x1, lv_coord_t * x2)
+{
+    /*Horizontal and vertical lines are special cases in `lv_draw_mask_line`. Don't limit them.*/
+    if(param->steep == 0) return;
+
+    /* Where the line enters and leaves the pixel row. Calculated as in `line_mask_flat/steep` (in 1/256 px)
+     * but on 64 bit to not overflow far from the origo*/
+    int64_t y = abs_y - param->origo.y;
+    int64_t xs = ((y << 8) * param->xy_steep) >> 10;
+    int64_t xe = (((y + 1) << 8) * param->xy_steep) >> 10;
+    int64_t x_min = (LV_MATH_MIN(xs, xe) >> 8) + param->origo.x;
+    int64_t x_max = (LV_MATH_MAX(xs, xe) >> 8) + param->origo.x;
+
+    /* The anti-aliased pixels are at most 2 px away from the intersections.
+     * On flat lines the anti-aliasing goes to the right by `255 / spx` px.*/
+    if(param->inv) {
+        x_min -= 2;
+        if(x_min > *x1) *x1 = x_min > LV_COORD_MAX ? LV_COORD_MAX : x_min;
+    }
+    else {
+        if(param->flat) {
+            /*Very flat lines can be anti-aliased until the end of the line*/
+            if(param->spx == 0) return;
+            x_max += 255 / param->spx + 1;
+        }
+        x_max += 2;
+        if(x_max < *x2) *x2 = x_max < LV_COORD_MIN ? LV_COORD_MIN : x_max;
+    }
 }
 
 /**
@@ -132,6 +342,7 @@ void * lv_draw_mask_remove_id(int16_t id)
         p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
         LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
         LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        mask_kernel_select();
     }
 
     return p;
@@ -154,6 +365,7 @@ void * lv_draw_mask_remove_custom(void * custom_id)
             LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = NULL;
         }
     }
+    mask_kernel_select();
     return p;
 }
 
@@ -418,6 +630,78 @@ void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, const lv_area_t * c
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Select the mask kernel for the current mask list.
+ * Called every time when a mask is added or removed.
+ */
+static void mask_kernel_select(void)
+{
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+
+    /*Count the masks the same way as `mask_kernel_generic` walks them: until the first empty entry*/
+    uint8_t cnt = 0;
+    while(cnt < _LV_MASK_MAX_NUM && m[cnt].param) cnt++;
+
+    if(cnt == 0) {
+        kernel_act = mask_kernel_none;
+        return;
+    }
+
+    kernel_act = mask_kernel_generic;
+    if(cnt > MASK_KERNEL_MAX_NUM) return;
+
+    uint32_t k;
+    for(k = 0; k < sizeof(kernel_dsc) / sizeof(kernel_dsc[0]); k++) {
+        if(kernel_dsc[k].cnt != cnt) continue;
+
+        uint8_t i;
+        for(i = 0; i < cnt; i++) {
+            lv_draw_mask_common_dsc_t * dsc = m[i].param;
+            if(dsc->cb != kernel_dsc[k].cb[i]) break;
+        }
+
+        if(i == cnt) {
+            for(i = 0; i < cnt; i++) kernel_param[i] = m[i].param;
+            kernel_act = kernel_dsc[k].kernel;
+            return;
+        }
+    }
+}
+
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_kernel_none(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                 lv_coord_t abs_y, lv_coord_t len)
+{
+    LV_UNUSED(mask_buf);
+    LV_UNUSED(abs_x);
+    LV_UNUSED(abs_y);
+    LV_UNUSED(len);
+
+    return LV_DRAW_MASK_RES_FULL_COVER;
+}
+
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_kernel_generic(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                    lv_coord_t abs_y, lv_coord_t len)
+{
+    bool changed = false;
+    lv_draw_mask_common_dsc_t * dsc;
+
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+
+    while(m->param) {
+        dsc = m->param;
+        lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
+        res = dsc->cb(mask_buf, abs_x, abs_y, len, (void *)m->param);
+        if(res == LV_DRAW_MASK_RES_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+        else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
+
+        m++;
+    }
+
+    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+}
+
+MASK_KERNEL_LIST(MASK_KERNEL_DEF)
+
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_line(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                   lv_coord_t abs_y, lv_coord_t len,
                                                                   lv_draw_mask_line_param_t * p)
@@ -695,7 +979,8 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t line_mask_steep(lv_opa_t * mask_
 
             }
             else {
-                if(k > len) return LV_DRAW_MASK_RES_FULL_COVER;
+                /*The anti-aliased pixels might be already set at the end of the line*/
+                if(k > len) k = len;
                 if(k >= 0) _lv_memset_00(&mask_buf[k],  len - k);
             }
 
@@ -930,199 +1215,356 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
     abs_x -= rect.x1;
     abs_y -= rect.y1;
 
-    uint32_t r2 = p->cfg.radius * p->cfg.radius;
-
     /*Handle corner areas*/
     if(abs_y < radius || abs_y > h - radius - 1) {
+#if LV_RADIUS_MASK_CACHE_SIZE
+        const lv_opa_t * cov = radius_cache_get(radius);
+        if(cov) {
+            /*The corners are symmetric so the bottom rows use the rows of the top*/
+            int32_t row = abs_y < radius ? abs_y : h - abs_y - 1;
+            return radius_corner_from_cache(mask_buf, abs_x, len, w, radius, outer, &cov[row * radius]);
+        }
+#endif
+        return radius_corner_calc(mask_buf, k, abs_y, len, w, h, p);
+    }
 
-        uint32_t sqrt_mask;
-        if(radius <= 32) sqrt_mask = 0x200;
-        if(radius <= 256) sqrt_mask = 0x800;
-        else sqrt_mask = 0x8000;
-
-        lv_sqrt_res_t x0;
-        lv_sqrt_res_t x1;
-        /* y = 0 should mean the top of the circle */
-        int32_t y;
-        if(abs_y < radius) {
-            y = radius - abs_y;
-
-            /* Get the x intersection points for `abs_y` and `abs_y-1`
-             * Use the circle's equation x = sqrt(r^2 - y^2)
-             * Try to use the values from the previous run*/
-            if(y == p->y_prev) {
-                x0.f = p->y_prev_x.f;
-                x0.i = p->y_prev_x.i;
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Calculate the anti-aliased corners of a radius mask on a line
+ * @param mask_buf the mask buffer of the line
+ * @param k the first relevant coordinate on the mask (`rect.x1 - abs_x`)
+ * @param abs_y the y coordinate relative to the rectangle. Must be in the top or bottom `radius` rows
+ * @param len length of the line
+ * @param w width of the rectangle
+ * @param h height of the rectangle
+ * @param p the parameters of the mask
+ * @return LV_DRAW_MASK_RES_TRANSP or LV_DRAW_MASK_RES_CHANGED
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_calc(lv_opa_t * mask_buf, int32_t k, int32_t abs_y,
+                                                                   lv_coord_t len, int32_t w, int32_t h,
+                                                                   lv_draw_mask_radius_param_t * p)
+{
+    bool outer = p->cfg.outer;
+    int32_t radius = p->cfg.radius;
+    uint32_t r2 = p->cfg.radius * p->cfg.radius;
+
+    uint32_t sqrt_mask;
+    if(radius <= 32) sqrt_mask = 0x200;
+    if(radius <= 256) sqrt_mask = 0x800;
+    else sqrt_mask = 0x8000;
+
+    lv_sqrt_res_t x0;
+    lv_sqrt_res_t x1;
+    /* y = 0 should mean the top of the circle */
+    int32_t y;
+    if(abs_y < radius) {
+        y = radius - abs_y;
+
+        /* Get the x intersection points for `abs_y` and `abs_y-1`
+         * Use the circle's equation x = sqrt(r^2 - y^2)
+         * Try to use the values from the previous run*/
+        if(y == p->y_prev) {
+            x0.f = p->y_prev_x.f;
+            x0.i = p->y_prev_x.i;
+        }
+        else {
+            _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
+        }
+        _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
+        p->y_prev = y - 1;
+        p->y_prev_x.f = x1.f;
+        p->y_prev_x.i = x1.i;
+    }
+    else {
+        y = radius - (h - abs_y) + 1;
+
+        /* Get the x intersection points for `abs_y` and `abs_y-1`
+         * Use the circle's equation x = sqrt(r^2 - y^2)
+         * Try to use the values from the previous run*/
+        if((y - 1) == p->y_prev) {
+            x1.f = p->y_prev_x.f;
+            x1.i = p->y_prev_x.i;
+        }
+        else {
+            _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
+        }
+
+        _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
+        p->y_prev = y;
+        p->y_prev_x.f = x0.f;
+        p->y_prev_x.i = x0.i;
+    }
+
+    /* If x1 is on the next round coordinate (e.g. x0: 3.5, x1:4.0)
+     * then treat x1 as x1: 3.99 to handle them as they were on the same pixel*/
+    if(x0.i == x1.i - 1 && x1.f == 0) {
+        x1.i--;
+        x1.f = 0xFF;
+    }
+
+    /*If the two x intersections are on the same x then just get average of the fractions*/
+    if(x0.i == x1.i) {
+        lv_opa_t m = (x0.f + x1.f) >> 1;
+        if(outer) m = 255 - m;
+        int32_t ofs = radius - x0.i - 1;
+
+        /*Left corner*/
+        int32_t kl = k + ofs;
+
+        if(kl >= 0 && kl < len) {
+            mask_buf[kl] = mask_mix(mask_buf[kl], m);
+        }
+
+        /*Right corner*/
+        int32_t kr = k + (w - ofs - 1);
+        if(kr >= 0 && kr < len) {
+            mask_buf[kr] = mask_mix(mask_buf[kr], m);
+        }
+
+        /*Clear the unused parts*/
+        if(outer == false) {
+            kr++;
+            if(kl > len)  {
+                return LV_DRAW_MASK_RES_TRANSP;
             }
-            else {
-                _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
+            if(kl >= 0) {
+                _lv_memset_00(&mask_buf[0], kl);
+            }
+            if(kr < 0) {
+                return LV_DRAW_MASK_RES_TRANSP;
+            }
+            if(kr <= len) {
+                _lv_memset_00(&mask_buf[kr], len - kr);
             }
-            _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
-            p->y_prev = y - 1;
-            p->y_prev_x.f = x1.f;
-            p->y_prev_x.i = x1.i;
         }
         else {
-            y = radius - (h - abs_y) + 1;
-
-            /* Get the x intersection points for `abs_y` and `abs_y-1`
-             * Use the circle's equation x = sqrt(r^2 - y^2)
-             * Try to use the values from the previous run*/
-            if((y - 1) == p->y_prev) {
-                x1.f = p->y_prev_x.f;
-                x1.i = p->y_prev_x.i;
-            }
-            else {
-                _lv_sqrt(r2 - ((y - 1) * (y - 1)), &x1, sqrt_mask);
+            kl++;
+            int32_t first = kl;
+            if(first < 0) first = 0;
+
+            int32_t len_tmp = kr - first;
+            if(len_tmp + first > len) len_tmp = len - first;
+            if(first < len && len_tmp >= 0) {
+                _lv_memset_00(&mask_buf[first], len_tmp);
             }
+        }
+    }
+    /*Multiple pixels are affected. Get y intersection of the pixels*/
+    else {
+        int32_t ofs = radius - (x0.i + 1);
+        int32_t kl = k + ofs;
+        int32_t kr = k + (w - ofs - 1);
 
-            _lv_sqrt(r2 - (y * y), &x0, sqrt_mask);
-            p->y_prev = y;
-            p->y_prev_x.f = x0.f;
-            p->y_prev_x.i = x0.i;
+        if(outer) {
+            int32_t first = kl + 1;
+            if(first < 0) first = 0;
+
+            int32_t len_tmp = kr - first;
+            if(len_tmp + first > len) len_tmp = len - first;
+            if(first < len && len_tmp >= 0) {
+                _lv_memset_00(&mask_buf[first], len_tmp);
+            }
         }
 
-        /* If x1 is on the next round coordinate (e.g. x0: 3.5, x1:4.0)
-         * then treat x1 as x1: 3.99 to handle them as they were on the same pixel*/
-        if(x0.i == x1.i - 1 && x1.f == 0) {
-            x1.i--;
-            x1.f = 0xFF;
+        uint32_t i = x0.i + 1;
+        lv_opa_t m;
+        lv_sqrt_res_t y_prev;
+        lv_sqrt_res_t y_next;
+
+        _lv_sqrt(r2 - (x0.i * x0.i), &y_prev, sqrt_mask);
+
+        if(y_prev.f == 0) {
+            y_prev.i--;
+            y_prev.f = 0xFF;
         }
 
-        /*If the two x intersections are on the same x then just get average of the fractions*/
-        if(x0.i == x1.i) {
-            lv_opa_t m = (x0.f + x1.f) >> 1;
+        /*The first y intersection is special as it might be in the previous line*/
+        if(y_prev.i >= y) {
+            _lv_sqrt(r2 - (i * i), &y_next, sqrt_mask);
+            m = 255 - (((255 - x0.f) * (255 - y_next.f)) >> 9);
+
             if(outer) m = 255 - m;
-            int32_t ofs = radius - x0.i - 1;
+            if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+            if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            kl--;
+            kr++;
+            y_prev.f = y_next.f;
+            i++;
+        }
 
-            /*Left corner*/
-            int32_t kl = k + ofs;
+        /*Set all points which are crossed by the circle*/
+        for(; i <= x1.i; i++) {
+            /* These values are very close to each other. It's enough to approximate sqrt
+             * The non-approximated version is lv_sqrt(r2 - (i * i), &y_next, sqrt_mask); */
+            sqrt_approx(&y_next, &y_prev, r2 - (i * i));
 
-            if(kl >= 0 && kl < len) {
-                mask_buf[kl] = mask_mix(mask_buf[kl], m);
-            }
+            m = (y_prev.f + y_next.f) >> 1;
+            if(outer) m = 255 - m;
+            if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+            if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            kl--;
+            kr++;
+            y_prev.f = y_next.f;
+        }
 
-            /*Right corner*/
-            int32_t kr = k + (w - ofs - 1);
-            if(kr >= 0 && kr < len) {
-                mask_buf[kr] = mask_mix(mask_buf[kr], m);
-            }
+        /*If the last pixel was left in its middle therefore
+         * the circle still has parts on the next one*/
+        if(y_prev.f) {
+            m = (y_prev.f * x1.f) >> 9;
+            if(outer) m = 255 - m;
+            if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+            if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+            kl--;
+            kr++;
+        }
 
-            /*Clear the unused parts*/
-            if(outer == false) {
-                kr++;
-                if(kl > len)  {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kl >= 0) {
-                    _lv_memset_00(&mask_buf[0], kl);
-                }
-                if(kr < 0) {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kr <= len) {
-                    _lv_memset_00(&mask_buf[kr], len - kr);
-                }
+        if(outer == 0) {
+            kl++;
+            if(kl > len) {
+                return LV_DRAW_MASK_RES_TRANSP;
             }
-            else {
-                kl++;
-                int32_t first = kl;
-                if(first < 0) first = 0;
-
-                int32_t len_tmp = kr - first;
-                if(len_tmp + first > len) len_tmp = len - first;
-                if(first < len && len_tmp >= 0) {
-                    _lv_memset_00(&mask_buf[first], len_tmp);
-                }
+            if(kl >= 0) _lv_memset_00(&mask_buf[0], kl);
+
+            if(kr < 0) {
+                return LV_DRAW_MASK_RES_TRANSP;
             }
+            if(kr < len) _lv_memset_00(&mask_buf[kr], len - kr);
         }
-        /*Multiple pixels are affected. Get y intersection of the pixels*/
-        else {
-            int32_t ofs = radius - (x0.i + 1);
-            int32_t kl = k + ofs;
-            int32_t kr = k + (w - ofs - 1);
-
-            if(outer) {
-                int32_t first = kl + 1;
-                if(first < 0) first = 0;
-
-                int32_t len_tmp = kr - first;
-                if(len_tmp + first > len) len_tmp = len - first;
-                if(first < len && len_tmp >= 0) {
-                    _lv_memset_00(&mask_buf[first], len_tmp);
-                }
-            }
+    }
 
-            uint32_t i = x0.i + 1;
-            lv_opa_t m;
-            lv_sqrt_res_t y_prev;
-            lv_sqrt_res_t y_next;
+    return LV_DRAW_MASK_RES_CHANGED;
+}
 
-            _lv_sqrt(r2 - (x0.i * x0.i), &y_prev, sqrt_mask);
+#if LV_RADIUS_MASK_CACHE_SIZE
+/**
+ * Apply the cached coverage of a corner row on a line
+ * @param mask_buf the mask buffer of the line
+ * @param x the start of the line relative to the rectangle
+ * @param len length of the line
+ * @param w width of the rectangle
+ * @param radius radius of the corners
+ * @param outer true: inverted mask
+ * @param cov the coverage of the row in the top left corner (`radius` values)
+ * @return LV_DRAW_MASK_RES_TRANSP or LV_DRAW_MASK_RES_CHANGED
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_from_cache(lv_opa_t * mask_buf, int32_t x, lv_coord_t len,
+                                                                         int32_t w, int32_t radius, bool outer,
+                                                                         const lv_opa_t * cov)
+{
+    int32_t x_end = x + len;    /*The first pixel after the line*/
+    int32_t i;
+    int32_t first;
+    int32_t last;
 
-            if(y_prev.f == 0) {
-                y_prev.i--;
-                y_prev.f = 0xFF;
-            }
+    if(outer == false) {
+        if(x_end <= 0 || x >= w) return LV_DRAW_MASK_RES_TRANSP;
 
-            /*The first y intersection is special as it might be in the previous line*/
-            if(y_prev.i >= y) {
-                _lv_sqrt(r2 - (i * i), &y_next, sqrt_mask);
-                m = 255 - (((255 - x0.f) * (255 - y_next.f)) >> 9);
-
-                if(outer) m = 255 - m;
-                if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
-                if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
-                kl--;
-                kr++;
-                y_prev.f = y_next.f;
-                i++;
-            }
+        /*Remove the pixels on the left and on the right of the rectangle*/
+        if(x < 0) _lv_memset_00(mask_buf, -x);
+        if(x_end > w) _lv_memset_00(&mask_buf[w - x], x_end - w);
+    }
+    else {
+        /*Remove the middle part between the corners*/
+        first = LV_MATH_MAX(x, radius);
+        last = LV_MATH_MIN(x_end, w - radius);
+        if(first < last) _lv_memset_00(&mask_buf[first - x], last - first);
+    }
 
-            /*Set all points which are crossed by the circle*/
-            for(; i <= x1.i; i++) {
-                /* These values are very close to each other. It's enough to approximate sqrt
-                 * The non-approximated version is lv_sqrt(r2 - (i * i), &y_next, sqrt_mask); */
-                sqrt_approx(&y_next, &y_prev, r2 - (i * i));
-
-                m = (y_prev.f + y_next.f) >> 1;
-                if(outer) m = 255 - m;
-                if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
-                if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
-                kl--;
-                kr++;
-                y_prev.f = y_next.f;
-            }
+    /*Left corner*/
+    first = LV_MATH_MAX(x, 0);
+    last = LV_MATH_MIN(x_end, radius);
+    for(i = first; i < last; i++) {
+        lv_opa_t m = outer ? 255 - cov[i] : cov[i];
+        mask_buf[i - x] = mask_mix(mask_buf[i - x], m);
+    }
 
-            /*If the last pixel was left in its middle therefore
-             * the circle still has parts on the next one*/
-            if(y_prev.f) {
-                m = (y_prev.f * x1.f) >> 9;
-                if(outer) m = 255 - m;
-                if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
-                if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
-                kl--;
-                kr++;
-            }
+    /*Right corner, mirrored*/
+    first = LV_MATH_MAX(x, w - radius);
+    last = LV_MATH_MIN(x_end, w);
+    for(i = first; i < last; i++) {
+        lv_opa_t m = outer ? 255 - cov[w - 1 - i] : cov[w - 1 - i];
+        mask_buf[i - x] = mask_mix(mask_buf[i - x], m);
+    }
 
-            if(outer == 0) {
-                kl++;
-                if(kl > len) {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kl >= 0) _lv_memset_00(&mask_buf[0], kl);
+    return LV_DRAW_MASK_RES_CHANGED;
+}
 
-                if(kr < 0) {
-                    return LV_DRAW_MASK_RES_TRANSP;
-                }
-                if(kr < len) _lv_memset_00(&mask_buf[kr], len - kr);
-            }
+/**
+ * Get the coverage of the top left corner with a given radius.
+ * Calculate and buffer it if it's not buffered yet.
+ * @param radius radius of the corner
+ * @return `radius * radius` coverage values or NULL if the corner can't be buffered
+ */
+static const lv_opa_t * radius_cache_get(int32_t radius)
+{
+    radius_cache_entry_t * e = &radius_cache_entries[radius_cache_last];
+    if(e->radius == radius) {
+        _lv_lru_use(&radius_cache, e);
+        return e->buf;
+    }
+
+    uint32_t i;
+    for(i = 0; i < RADIUS_CACHE_ENTRY_NUM; i++) {
+        if(radius_cache_entries[i].radius == radius) {
+            radius_cache_last = i;
+            _lv_lru_use(&radius_cache, &radius_cache_entries[i]);
+            return radius_cache_entries[i].buf;
         }
     }
 
-    return LV_DRAW_MASK_RES_CHANGED;
+    uint32_t size = radius * radius;
+    e = _lv_lru_get_free(&radius_cache, size);
+    if(e == NULL) return NULL;
+
+    e->buf = lv_mem_alloc(size);
+    if(e->buf == NULL) return NULL;
+
+    /*Calculate the top left corner of a rectangle which is large enough to have separated corners*/
+    lv_draw_mask_radius_param_t p;
+    lv_area_t rect;
+    lv_area_set(&rect, 0, 0, radius * 2 + 1, radius * 2 + 1);
+    lv_draw_mask_radius_init(&p, &rect, radius, false);
+
+    int32_t y;
+    for(y = 0; y < radius; y++) {
+        lv_opa_t * row = &e->buf[y * radius];
+        _lv_memset_ff(row, radius);
+        radius_corner_calc(row, 0, y, radius, radius * 2 + 2, radius * 2 + 2, &p);
+    }
+
+    e->radius = radius;
+    _lv_lru_add(&radius_cache, e);
+    radius_cache_last = e - radius_cache_entries;
+
+    return e->buf;
+}
+
+/**
+ * Get the size of a buffered corner
+ * @param entry pointer to a `radius_cache_entry_t`
+ * @return the size of the coverage values in bytes. 0: unused entry
+ */
+static uint32_t radius_cache_size(const void * entry)
+{
+    const radius_cache_entry_t * e = entry;
+    return e->radius * e->radius;
 }
 
+/**
+ * Free a buffered corner
+ * @param entry pointer to a `radius_cache_entry_t`
+ */
+static void radius_cache_free(void * entry)
+{
+    radius_cache_entry_t * e = entry;
+    lv_mem_free(e->buf);
+    e->buf = NULL;
+    e->radius = 0;
+}
+#endif
+
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                   lv_coord_t abs_y, lv_coord_t len,
                                                                   lv_draw_mask_fade_param_t * p)
@@ -1230,3 +1672,15 @@ LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_
     q->i = d >> 4;
     q->f = (d & 0xF) << 4;
 }
+
+/**
+ * Get 4 opacity values of a mask line at once. The address doesn't need to be aligned.
+ * @param mask_buf pointer to the first opacity value
+ * @return the 4 values as a word, e.g. 0: all transparent, 0xFFFFFFFF: all covered
+ */
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t mask_word_get(const lv_opa_t * mask_buf)
+{
+    uint32_t w;
+    memcpy(&w, mask_buf, sizeof(w));
+    return w;
+}
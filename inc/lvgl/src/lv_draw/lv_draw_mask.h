@@ -23,6 +23,10 @@ extern "C" {
 #define LV_MASK_ID_INV  (-1)
 #define _LV_MASK_MAX_NUM     16
 
+/*Fully covered runs shorter than this are kept in the neighboring partial span
+ *because blending them with the mask is cheaper than starting a new fill*/
+#define LV_DRAW_MASK_SPAN_MIN_COVER  8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -165,6 +169,17 @@ typedef struct {
     void * custom_id;
 } _lv_draw_mask_saved_t;
 
+/**
+ * A run of pixels in a line of a mask with the same kind of coverage.
+ * Fully transparent runs are not stored.
+ */
+typedef struct {
+    lv_coord_t x;               /*First pixel of the span relative to the start of the mask buffer*/
+    lv_coord_t len;             /*Number of pixels in the span*/
+    lv_draw_mask_res_t res;     /*`LV_DRAW_MASK_RES_FULL_COVER`: every value is 0xFF,
+                                  `LV_DRAW_MASK_RES_CHANGED`: the values in the mask buffer should be used*/
+} lv_draw_mask_span_t;
+
 typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[_LV_MASK_MAX_NUM];
 
 /**********************
@@ -195,6 +210,29 @@ int16_t lv_draw_mask_add(void * param, void * custom_id);
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
                                                             lv_coord_t len);
 
+/**
+ * Split a line of mask created by `lv_draw_mask_apply` to transparent, fully covered and partially covered spans.
+ * Used internally by the library's drawing routines to fill the covered parts without a mask.
+ * @param mask_buf a mask line
+ * @param len length of the line (in pixel count)
+ * @param spans store the non-transparent spans here
+ * @param span_max size of `spans`. If there are more spans the last one will contain the rest of the line.
+ * @return number of spans written to `spans`
+ */
+LV_ATTRIBUTE_FAST_MEM uint16_t lv_draw_mask_get_spans(const lv_opa_t * mask_buf, lv_coord_t len,
+                                                      lv_draw_mask_span_t * spans, uint16_t span_max);
+
+/**
+ * Limit a range of a line to the pixels where a line mask can keep something.
+ * Used internally by the library's drawing routines to skip the pixels the mask surely clears.
+ * @param param pointer to an initialized line mask parameter
+ * @param abs_y absolute Y coordinate of the line
+ * @param x1 pointer to the first X coordinate of the range. Increased if the mask clears the pixels before it.
+ * @param x2 pointer to the last X coordinate of the range. Decreased if the mask clears the pixels after it.
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_mask_line_limit_x(const lv_draw_mask_line_param_t * param, lv_coord_t abs_y,
+                                                     lv_coord_t * x1, lv_coord_t * x2);
+
 //! @endcond
 
 /**
@@ -13,6 +13,7 @@
 #include "../lv_misc/lv_txt_ap.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_lru.h"
 
 /*********************
  *      DEFINES
@@ -21,9 +22,80 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+/*Max. number of different corner slices to buffer (the RAM limit is `LV_RECT_SLICE_CACHE_SIZE`)*/
+#define SLICE_CACHE_ENTRY_NUM   8
+
+/*Max. number of different gradients to buffer (the RAM limit is `LV_GRAD_CACHE_SIZE`)*/
+#define GRAD_CACHE_ENTRY_NUM    4
+
+/*RAM limit of the buffered shadow corners: `LV_SHADOW_CACHE_NUM` corners of the largest size*/
+#define SH_CACHE_MEM_SIZE       (LV_SHADOW_CACHE_NUM * LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 2)
+
+/*Dithering is used only with 16 bit colors where the banding is visible*/
+#define GRAD_DITHER             (LV_GRAD_DITHER && LV_COLOR_DEPTH == 16)
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if GRAD_DITHER
+/*The color channels of a gradient with 4 extra fractional bits for dithering*/
+typedef struct {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} grad_dither_color_t;
+#endif
+
+/**
+ * The colors of a gradient along its direction.
+ * Used as a buffered gradient in the gradient cache or as a temporary gradient.
+ */
+typedef struct {
+    lv_lru_entry_t lru;             /*Used in the gradient cache*/
+    lv_color_t * map;               /*`size` colors*/
+#if GRAD_DITHER
+    grad_dither_color_t * dither;   /*`size` colors with higher precision*/
+#endif
+    lv_color_t color;               /*The properties of the gradient*/
+    lv_color_t grad_color;
+    lv_style_int_t main_stop;
+    lv_style_int_t grad_stop;
+    lv_coord_t size;                /*0: unused entry*/
+    uint8_t cached : 1;             /*1: `map` is in the gradient cache; 0: `map` is a temporary buffer*/
+} grad_lut_t;
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/**
+ * A buffered shadow corner.
+ * `buf` has the `size * size` opacity values of the top right corner
+ * followed by the same corner mirrored horizontally (top left corner).
+ */
+typedef struct {
+    lv_lru_entry_t lru;
+    lv_opa_t * buf;
+    lv_coord_t sw;      /*Shadow width. 0: unused entry*/
+    lv_coord_t r;       /*Radius of the shadow*/
+    lv_coord_t w;       /*Width of small shadows. 0 for shadows whose corners don't affect each other*/
+    lv_coord_t h;       /*Height of small shadows. 0 for shadows whose corners don't affect each other*/
+} sh_cache_entry_t;
+#endif
+
+#if LV_RECT_SLICE_CACHE_SIZE
+/**
+ * The corners of a background, border or outline as the opacity of its pixels.
+ * Used as the corner parts of a nine-slice: the edges and the center are simple fills.
+ * `buf` has the `rows` lines of the top left corner followed by the `rows` lines of the top right corner.
+ * Every line is `rout` wide. The bottom corners use the lines of the top corners from the bottom.
+ */
+typedef struct {
+    lv_lru_entry_t lru;
+    lv_opa_t * buf;
+    lv_coord_t rout;            /*Outer radius. 0: unused entry*/
+    lv_coord_t rin;             /*Inner radius of borders*/
+    lv_coord_t border_width;    /*0: background*/
+    lv_coord_t rows;
+} slice_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -42,6 +114,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+static lv_opa_t * shadow_corner_get(const lv_area_t * sh_rect_area, lv_coord_t sw, lv_coord_t r, bool * cached);
+#if LV_SHADOW_CACHE_SIZE
+static uint32_t sh_cache_size(const void * entry);
+static void sh_cache_free(void * entry);
+#endif
 #endif
 
 #if LV_USE_PATTERN
@@ -54,14 +131,53 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * area_outer, const lv_area_t * clip,
                              lv_coord_t radius, bool radius_is_in, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
 LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i);
+static const grad_lut_t * grad_lut_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t size, grad_lut_t * tmp);
+static void grad_lut_release(const grad_lut_t * lut);
+#if LV_GRAD_CACHE_SIZE
+static uint32_t grad_cache_size(const void * entry);
+static void grad_cache_free(void * entry);
+#endif
+#if GRAD_DITHER
+LV_ATTRIBUTE_FAST_MEM static void grad_dither_line(const grad_lut_t * lut, lv_grad_dir_t dir, lv_coord_t x,
+                                                   lv_coord_t y, lv_coord_t y_ofs, lv_coord_t len, lv_color_t * line);
+#endif
+#if LV_RECT_SLICE_CACHE_SIZE
+static const slice_cache_entry_t * slice_cache_get(lv_coord_t rout, lv_coord_t rin, lv_coord_t border_width,
+                                                   lv_coord_t rows, const lv_area_t * coords);
+LV_ATTRIBUTE_FAST_MEM static void slice_blend_corners(const lv_area_t * clip, const slice_cache_entry_t * slice,
+                                                      const lv_area_t * coords, lv_coord_t y, lv_opa_t * mask_buf,
+                                                      lv_color_t color, lv_opa_t opa, bool opa_to_mask, lv_blend_mode_t mode);
+static uint32_t slice_cache_size(const void * entry);
+static void slice_cache_free(void * entry);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+    static sh_cache_entry_t sh_cache_entries[LV_SHADOW_CACHE_NUM];
+    static lv_lru_t sh_cache = _LV_LRU_INIT(sh_cache_entries, SH_CACHE_MEM_SIZE, sh_cache_size, sh_cache_free);
+#endif
+
+#if LV_GRAD_CACHE_SIZE
+    static grad_lut_t grad_cache_entries[GRAD_CACHE_ENTRY_NUM];
+    static lv_lru_t grad_cache = _LV_LRU_INIT(grad_cache_entries, LV_GRAD_CACHE_SIZE, grad_cache_size, grad_cache_free);
+#endif
+
+#if GRAD_DITHER
+    /*4x4 Bayer matrix for ordered dithering*/
+    static const uint8_t grad_dither_threshold[4][4] = {
+        { 0,  8,  2, 10},
+        {12,  4, 14,  6},
+        { 3, 11,  1,  9},
+        {15,  7, 13,  5}
+    };
+#endif
+
+#if LV_RECT_SLICE_CACHE_SIZE
+    static slice_cache_entry_t slice_cache_entries[SLICE_CACHE_ENTRY_NUM];
+    static lv_lru_t slice_cache = _LV_LRU_INIT(slice_cache_entries, LV_RECT_SLICE_CACHE_SIZE,
+                                               slice_cache_size, slice_cache_free);
 #endif
 
 /**********************
@@ -215,6 +331,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     bool simple_mode = true;
     if(other_mask_cnt) simple_mode = false;
     else if(grad_dir == LV_GRAD_DIR_HOR) simple_mode = false;
+#if GRAD_DITHER
+    else if(grad_dir == LV_GRAD_DIR_VER) simple_mode = false;   /*Dithered gradients are drawn from maps*/
+#endif
 
     int16_t mask_rout_id = LV_MASK_ID_INV;
 
@@ -245,20 +364,27 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
         lv_draw_mask_res_t mask_res = LV_DRAW_MASK_RES_FULL_COVER;
         lv_color_t grad_color = dsc->bg_color;
 
-        lv_color_t * grad_map = NULL;
-        /*In case of horizontal gradient pre-compute a line with a gradient*/
-        if(grad_dir == LV_GRAD_DIR_HOR) {
-            grad_map = _lv_mem_buf_get(coords_w * sizeof(lv_color_t));
+        /*Get the colors of the gradient along its direction*/
+        grad_lut_t grad_lut_tmp;
+        const grad_lut_t * grad_lut = NULL;
+        if(grad_dir == LV_GRAD_DIR_HOR) grad_lut = grad_lut_get(dsc, coords_w, &grad_lut_tmp);
+        else if(grad_dir == LV_GRAD_DIR_VER) grad_lut = grad_lut_get(dsc, coords_h, &grad_lut_tmp);
 
-            int32_t i;
-            for(i = 0; i < coords_w; i++) {
-                grad_map[i] = grad_get(dsc, coords_w, i);
-            }
-        }
+#if GRAD_DITHER
+        /*Dithered gradients are drawn line by line from a map*/
+        lv_color_t * grad_line = NULL;
+        if(grad_lut) grad_line = _lv_mem_buf_get(coords_w * sizeof(lv_color_t));
+#endif
 
         bool split = false;
         if(lv_area_get_width(&coords_bg) - 2 * rout > SPLIT_LIMIT) split = true;
 
+#if LV_RECT_SLICE_CACHE_SIZE
+        /*Draw the corners from the slice cache if no other mask needs to be applied*/
+        const slice_cache_entry_t * slice = NULL;
+        if(simple_mode && split && rout > 0) slice = slice_cache_get(rout, 0, 0, rout, &coords_bg);
+#endif
+
         lv_opa_t opa2;
 
         lv_area_t fill_area;
@@ -269,6 +395,27 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
         for(h = draw_area.y1; h <= draw_area.y2; h++) {
             int32_t y = h + vdb->area.y1;
 
+#if LV_RECT_SLICE_CACHE_SIZE
+            if(slice && (y < coords_bg.y1 + rout || y > coords_bg.y2 - rout)) {
+                if(grad_dir == LV_GRAD_DIR_VER) {
+                    grad_color = grad_lut->map[y - coords_bg.y1];
+
+                    lv_area_t fill_area2;
+                    fill_area2.x1 = coords_bg.x1 + rout;
+                    fill_area2.x2 = coords_bg.x2 - rout;
+                    fill_area2.y1 = y;
+                    fill_area2.y2 = y;
+                    _lv_blend_fill(clip, &fill_area2,
+                                   grad_color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, dsc->bg_blend_mode);
+                }
+
+                slice_blend_corners(clip, slice, &coords_bg, y, mask_buf, grad_color, opa, true, dsc->bg_blend_mode);
+                fill_area.y1++;
+                fill_area.y2++;
+                continue;
+            }
+#endif
+
             opa2 = opa;
 
             /*In not corner areas apply the mask only if required*/
@@ -291,9 +438,19 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
                 opa2 = LV_OPA_COVER;
             }
 
+#if GRAD_DITHER
+            if(grad_line) {
+                grad_dither_line(grad_lut, grad_dir, coords_bg.x1, y, y - coords_bg.y1, coords_w, grad_line);
+                _lv_blend_map(clip, &fill_area, grad_line, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                fill_area.y1++;
+                fill_area.y2++;
+                continue;
+            }
+#endif
+
             /*Get the current line color*/
             if(grad_dir == LV_GRAD_DIR_VER) {
-                grad_color = grad_get(dsc, lv_area_get_height(&coords_bg), y - coords_bg.y1);
+                grad_color = grad_lut->map[y - coords_bg.y1];
             }
 
             /* If there is not other mask and drawing the corner area split the drawing to corner and middle areas
@@ -332,15 +489,15 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
             }
             else {
                 if(grad_dir == LV_GRAD_DIR_HOR) {
-                    _lv_blend_map(clip, &fill_area, grad_map, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                    _lv_blend_map(clip, &fill_area, grad_lut->map, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
                 }
                 else if(grad_dir == LV_GRAD_DIR_VER) {
-                    _lv_blend_fill(clip, &fill_area,
-                                   grad_color, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                    _lv_blend_fill_spans(clip, &fill_area,
+                                         grad_color, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
                 }
                 else if(other_mask_cnt != 0 || !split) {
-                    _lv_blend_fill(clip, &fill_area,
-                                   grad_color, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
+                    _lv_blend_fill_spans(clip, &fill_area,
+                                         grad_color, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
                 }
             }
             fill_area.y1++;
@@ -374,7 +531,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
         }
 
-        if(grad_map) _lv_mem_buf_release(grad_map);
+        if(grad_lut) grad_lut_release(grad_lut);
+#if GRAD_DITHER
+        if(grad_line) _lv_mem_buf_release(grad_line);
+#endif
     }
 
     lv_draw_mask_remove_id(mask_rout_id);
@@ -487,7 +647,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_border(const lv_area_t * coords, const lv
                (bottom_only && fill_area.y1 >= coords->y2 - corner_size)) {
                 _lv_memset_ff(mask_buf, draw_area_w);
                 mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
-                _lv_blend_fill(clip, &fill_area, color, mask_buf, mask_res, opa, blend_mode);
+                _lv_blend_fill_spans(clip, &fill_area, color, mask_buf, mask_res, opa, blend_mode);
             }
             fill_area.y1++;
             fill_area.y2++;
@@ -514,6 +674,150 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
     return lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix);
 }
 
+/**
+ * Get the colors of a gradient. Use the gradient cache if possible.
+ * @param dsc the descriptor of the rectangle with the gradient's properties
+ * @param size length of the gradient
+ * @param tmp used to describe the gradient if it can't be buffered
+ * @return the colors of the gradient. Release with `grad_lut_release` when not used anymore.
+ */
+static const grad_lut_t * grad_lut_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t size, grad_lut_t * tmp)
+{
+#if GRAD_DITHER
+    uint32_t buf_size = size * (sizeof(lv_color_t) + sizeof(grad_dither_color_t));
+#else
+    uint32_t buf_size = size * sizeof(lv_color_t);
+#endif
+
+    grad_lut_t * lut = NULL;
+
+#if LV_GRAD_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < GRAD_CACHE_ENTRY_NUM; i++) {
+        grad_lut_t * e = &grad_cache_entries[i];
+        if(e->size == size && e->color.full == dsc->bg_color.full && e->grad_color.full == dsc->bg_grad_color.full &&
+           e->main_stop == dsc->bg_main_color_stop && e->grad_stop == dsc->bg_grad_color_stop) {
+            _lv_lru_use(&grad_cache, e);
+            return e;
+        }
+    }
+
+    lut = _lv_lru_get_free(&grad_cache, buf_size);
+    if(lut) {
+        lut->map = lv_mem_alloc(buf_size);
+        if(lut->map) lut->cached = 1;
+        else lut = NULL;
+    }
+#endif
+
+    /*Use a temporary buffer if the gradient can't be buffered*/
+    if(lut == NULL) {
+        lut = tmp;
+        lut->map = _lv_mem_buf_get(buf_size);
+        lut->cached = 0;
+    }
+
+    lut->color = dsc->bg_color;
+    lut->grad_color = dsc->bg_grad_color;
+    lut->main_stop = dsc->bg_main_color_stop;
+    lut->grad_stop = dsc->bg_grad_color_stop;
+    lut->size = size;
+#if LV_GRAD_CACHE_SIZE
+    if(lut->cached) _lv_lru_add(&grad_cache, lut);
+#endif
+
+    int32_t x;
+    for(x = 0; x < size; x++) {
+        lut->map[x] = grad_get(dsc, size, x);
+    }
+
+#if GRAD_DITHER
+    /*Calculate the same colors with 4 more bits precision*/
+    lut->dither = (grad_dither_color_t *)&lut->map[size];
+    int32_t min = (dsc->bg_main_color_stop * size) >> 8;
+    int32_t max = (dsc->bg_grad_color_stop * size) >> 8;
+    int32_t d = ((dsc->bg_grad_color_stop - dsc->bg_main_color_stop) * size) >> 8;
+    for(x = 0; x < size; x++) {
+        uint32_t mix;
+        if(x <= min) mix = 0;
+        else if(x >= max) mix = 255;
+        else mix = ((x - min) * 255) / d;
+
+        grad_dither_color_t * c = &lut->dither[x];
+        c->r = ((LV_COLOR_GET_R(dsc->bg_grad_color) * mix + LV_COLOR_GET_R(dsc->bg_color) * (255 - mix)) << 4) / 255;
+        c->g = ((LV_COLOR_GET_G(dsc->bg_grad_color) * mix + LV_COLOR_GET_G(dsc->bg_color) * (255 - mix)) << 4) / 255;
+        c->b = ((LV_COLOR_GET_B(dsc->bg_grad_color) * mix + LV_COLOR_GET_B(dsc->bg_color) * (255 - mix)) << 4) / 255;
+    }
+#endif
+
+    return lut;
+}
+
+/**
+ * Release the colors of a gradient got with `grad_lut_get`
+ * @param lut pointer to the gradient
+ */
+static void grad_lut_release(const grad_lut_t * lut)
+{
+    if(lut->cached == 0) _lv_mem_buf_release(lut->map);
+}
+
+#if LV_GRAD_CACHE_SIZE
+/**
+ * Get the size of a buffered gradient
+ * @param entry pointer to a `grad_lut_t` in the gradient cache
+ * @return the size of the colors in bytes. 0: unused entry
+ */
+static uint32_t grad_cache_size(const void * entry)
+{
+    const grad_lut_t * lut = entry;
+#if GRAD_DITHER
+    return lut->size * (sizeof(lv_color_t) + sizeof(grad_dither_color_t));
+#else
+    return lut->size * sizeof(lv_color_t);
+#endif
+}
+
+/**
+ * Free a buffered gradient
+ * @param entry pointer to a `grad_lut_t` in the gradient cache
+ */
+static void grad_cache_free(void * entry)
+{
+    grad_lut_t * lut = entry;
+    lv_mem_free(lut->map);
+    lut->map = NULL;
+    lut->size = 0;
+}
+#endif
+
+#if GRAD_DITHER
+/**
+ * Get a line of a gradient with ordered dithering
+ * @param lut the colors of the gradient
+ * @param dir direction of the gradient
+ * @param x the absolute x coordinate of the first pixel of the line (the left side of the rectangle)
+ * @param y the absolute y coordinate of the line
+ * @param y_ofs the y coordinate relative to the top of the rectangle
+ * @param len length of the line
+ * @param line store the colors here
+ */
+LV_ATTRIBUTE_FAST_MEM static void grad_dither_line(const grad_lut_t * lut, lv_grad_dir_t dir, lv_coord_t x,
+                                                   lv_coord_t y, lv_coord_t y_ofs, lv_coord_t len, lv_color_t * line)
+{
+    const uint8_t * threshold = grad_dither_threshold[y & 0x3];
+    const grad_dither_color_t * c = &lut->dither[y_ofs];
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        if(dir == LV_GRAD_DIR_HOR) c = &lut->dither[i];
+        uint32_t t = threshold[(x + i) & 0x3];
+        LV_COLOR_SET_R(line[i], (c->r + t) >> 4);
+        LV_COLOR_SET_G(line[i], (c->g + t) >> 4);
+        LV_COLOR_SET_B(line[i], (c->b + t) >> 4);
+    }
+}
+#endif
+
 #if LV_USE_SHADOW
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip,
                                               const lv_draw_rect_dsc_t * dsc)
@@ -583,30 +887,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 
     int32_t corner_size = sw  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = _lv_mem_buf_get(corner_size * corner_size);
-        _lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation */
-        sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if(corner_size * corner_size < sizeof(sh_cache)) {
-            _lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
-    }
-#else
-    sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
-    shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
-#endif
+    bool sh_buf_cached;
+    lv_opa_t * sh_buf = shadow_corner_get(&sh_rect_area, dsc->shadow_width, r_sh, &sh_buf_cached);
+    lv_opa_t * sh_buf_ori = sh_buf;
 
     lv_coord_t h_half = sh_area.y1 + lv_area_get_height(&sh_area) / 2;
     lv_coord_t w_half = sh_area.x1 + lv_area_get_width(&sh_area) / 2;
@@ -747,17 +1030,8 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
         }
     }
 
-    /*Invert the shadow corner buffer and draw the corners on the left*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = sh_buf_tmp[x];
-            sh_buf_tmp[x] = sh_buf_tmp[corner_size - x - 1];
-            sh_buf_tmp[corner_size - x - 1] = tmp;
-        }
-        sh_buf_tmp += corner_size;
-    }
+    /*Use the mirrored shadow corner to draw the corners on the left*/
+    sh_buf += corner_size * corner_size;
 
     /*Draw the top left corner*/
     a.x1 = sh_area.x1;
@@ -987,9 +1261,112 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 
     lv_draw_mask_remove_id(mask_rout_id);
     _lv_mem_buf_release(mask_buf);
-    _lv_mem_buf_release(sh_buf);
+    if(sh_buf_cached == false) _lv_mem_buf_release(sh_buf_ori);
+}
+
+/**
+ * Get the blurred top right corner of a shadow and its mirrored version.
+ * Use the buffered corner if possible, else calculate (and buffer) it.
+ * @param sh_rect_area the area of the shadow without blur (absolute coordinates)
+ * @param sw shadow width
+ * @param r radius of the shadow
+ * @param cached store whether the returned buffer is buffered.
+ *               If `false` it should be released with `_lv_mem_buf_release` when not used anymore.
+ * @return `(sw + r)^2` opacity values of the top right corner followed by
+ *         `(sw + r)^2` opacity values of the top left corner
+ */
+static lv_opa_t * shadow_corner_get(const lv_area_t * sh_rect_area, lv_coord_t sw, lv_coord_t r, bool * cached)
+{
+    int32_t size = sw + r;
+
+#if LV_SHADOW_CACHE_SIZE
+    /* The corner doesn't depend on the size of the shadow if the other corners are farther than `size`.
+     * Else the size is the part of the key too.*/
+    lv_coord_t w = lv_area_get_width(sh_rect_area);
+    lv_coord_t h = lv_area_get_height(sh_rect_area);
+    if(w >= 2 * size && h >= 2 * size) {
+        w = 0;
+        h = 0;
+    }
+
+    uint32_t i;
+    for(i = 0; i < LV_SHADOW_CACHE_NUM; i++) {
+        sh_cache_entry_t * e = &sh_cache_entries[i];
+        if(e->sw == sw && e->r == r && e->w == w && e->h == h) {
+            _lv_lru_use(&sh_cache, e);
+            *cached = true;
+            return e->buf;
+        }
+    }
+#endif
+
+    /*A larger buffer is required for calculation. Its second half will be the mirrored corner*/
+    lv_opa_t * sh_buf = _lv_mem_buf_get(size * size * sizeof(uint16_t));
+    shadow_draw_corner_buf(sh_rect_area, (uint16_t *)sh_buf, sw, r);
+
+    lv_opa_t * src = sh_buf;
+    lv_opa_t * dest = sh_buf + size * size;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < size; y++) {
+        for(x = 0; x < size; x++) {
+            dest[x] = src[size - x - 1];
+        }
+        src += size;
+        dest += size;
+    }
+
+#if LV_SHADOW_CACHE_SIZE
+    /*Buffer the corner if it's not too large. Replace the least recently used entry*/
+    if(size <= LV_SHADOW_CACHE_SIZE) {
+        sh_cache_entry_t * e = _lv_lru_get_free(&sh_cache, size * size * 2);
+        if(e) e->buf = lv_mem_alloc(size * size * 2);
+        if(e && e->buf) {
+            _lv_memcpy(e->buf, sh_buf, size * size * 2);
+            e->sw = sw;
+            e->r = r;
+            e->w = w;
+            e->h = h;
+            _lv_lru_add(&sh_cache, e);
+            _lv_mem_buf_release(sh_buf);
+            *cached = true;
+            return e->buf;
+        }
+    }
+#endif
+
+    *cached = false;
+    return sh_buf;
+}
+
+#if LV_SHADOW_CACHE_SIZE
+/**
+ * Get the RAM used by a buffered shadow corner
+ * @param entry pointer to a `sh_cache_entry_t`
+ * @return size of the corner and its mirrored version or 0 if the entry is unused
+ */
+static uint32_t sh_cache_size(const void * entry)
+{
+    const sh_cache_entry_t * e = entry;
+    if(e->sw == 0) return 0;
+
+    uint32_t size = e->sw + e->r;
+    return size * size * 2;
 }
 
+/**
+ * Free a buffered shadow corner
+ * @param entry pointer to a `sh_cache_entry_t`
+ */
+static void sh_cache_free(void * entry)
+{
+    sh_cache_entry_t * e = entry;
+    lv_mem_free(e->buf);
+    e->buf = NULL;
+    e->sw = 0;
+}
+#endif
+
 /**
  * Calculate a blurred corner
  * @param coords Coordinates of the shadow
@@ -1415,6 +1792,16 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
     lv_draw_mask_res_t mask_res;
     lv_area_t fill_area;
 
+#if LV_RECT_SLICE_CACHE_SIZE
+    /* Draw the corners from the slice cache if no other mask needs to be applied.
+     * The corners of the area have to be far enough from each other to not affect each other's slice.*/
+    const slice_cache_entry_t * slice = NULL;
+    if(simple_mode && rout > 0 &&
+       coords_out_w >= 2 * corner_size + 3 && coords_out_h >= 2 * corner_size + 3) {
+        slice = slice_cache_get(rout, rin, border_width, corner_size + 1, area_outer);
+    }
+#endif
+
     /*Apply some optimization if there is no other mask*/
     if(simple_mode) {
         /*Draw the upper corner area*/
@@ -1425,18 +1812,10 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
         fill_area.y1 = disp_area->y1 + draw_area.y1;
         fill_area.y2 = fill_area.y1;
         for(h = draw_area.y1; h <= upper_corner_end; h++) {
-            _lv_memset_ff(mask_buf, draw_area_w);
-            mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
-
             lv_area_t fill_area2;
             fill_area2.y1 = fill_area.y1;
             fill_area2.y2 = fill_area.y2;
 
-            fill_area2.x1 = area_outer->x1;
-            fill_area2.x2 = area_outer->x1 + rout - 1;
-
-            _lv_blend_fill(clip, &fill_area2, color, mask_buf, mask_res, opa, blend_mode);
-
             /*Draw the top horizontal line*/
             if(fill_area2.y2 < area_outer->y1 + border_width) {
                 fill_area2.x1 = area_outer->x1 + rout;
@@ -1445,6 +1824,23 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
                 _lv_blend_fill(clip, &fill_area2, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, blend_mode);
             }
 
+#if LV_RECT_SLICE_CACHE_SIZE
+            if(slice) {
+                slice_blend_corners(clip, slice, area_outer, fill_area.y1, mask_buf, color, opa, false, blend_mode);
+                fill_area.y1++;
+                fill_area.y2++;
+                continue;
+            }
+#endif
+
+            _lv_memset_ff(mask_buf, draw_area_w);
+            mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+
+            fill_area2.x1 = area_outer->x1;
+            fill_area2.x2 = area_outer->x1 + rout - 1;
+
+            _lv_blend_fill(clip, &fill_area2, color, mask_buf, mask_res, opa, blend_mode);
+
             fill_area2.x1 = area_outer->x2 - rout + 1;
             fill_area2.x2 = area_outer->x2;
 
@@ -1462,17 +1858,10 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
         fill_area.y1 = disp_area->y1 + lower_corner_end;
         fill_area.y2 = fill_area.y1;
         for(h = lower_corner_end; h <= draw_area.y2; h++) {
-            _lv_memset_ff(mask_buf, draw_area_w);
-            mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
-
             lv_area_t fill_area2;
-            fill_area2.x1 = area_outer->x1;
-            fill_area2.x2 = area_outer->x1 + rout - 1;
             fill_area2.y1 = fill_area.y1;
             fill_area2.y2 = fill_area.y2;
 
-            _lv_blend_fill(clip, &fill_area2, color, mask_buf, mask_res, opa, blend_mode);
-
             /*Draw the bottom horizontal line*/
             if(fill_area2.y2 > area_outer->y2 - border_width) {
                 fill_area2.x1 = area_outer->x1 + rout;
@@ -1480,6 +1869,24 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
 
                 _lv_blend_fill(clip, &fill_area2, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, blend_mode);
             }
+
+#if LV_RECT_SLICE_CACHE_SIZE
+            if(slice) {
+                slice_blend_corners(clip, slice, area_outer, fill_area.y1, mask_buf, color, opa, false, blend_mode);
+                fill_area.y1++;
+                fill_area.y2++;
+                continue;
+            }
+#endif
+
+            _lv_memset_ff(mask_buf, draw_area_w);
+            mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
+
+            fill_area2.x1 = area_outer->x1;
+            fill_area2.x2 = area_outer->x1 + rout - 1;
+
+            _lv_blend_fill(clip, &fill_area2, color, mask_buf, mask_res, opa, blend_mode);
+
             fill_area2.x1 = area_outer->x2 - rout + 1;
             fill_area2.x2 = area_outer->x2;
 
@@ -1516,7 +1923,7 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
             _lv_memset_ff(mask_buf, draw_area_w);
             mask_res = lv_draw_mask_apply(mask_buf, vdb->area.x1 + draw_area.x1, vdb->area.y1 + h, draw_area_w);
 
-            _lv_blend_fill(clip, &fill_area, color, mask_buf, mask_res, opa, blend_mode);
+            _lv_blend_fill_spans(clip, &fill_area, color, mask_buf, mask_res, opa, blend_mode);
             fill_area.y1++;
             fill_area.y2++;
 
@@ -1526,3 +1933,134 @@ static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * are
     lv_draw_mask_remove_id(mask_rout_id);
     _lv_mem_buf_release(mask_buf);
 }
+
+#if LV_RECT_SLICE_CACHE_SIZE
+/**
+ * Get the corner slices of a background or border.
+ * Render and buffer them with the currently added masks if they are not buffered yet.
+ * @param rout outer radius
+ * @param rin inner radius (0 for background)
+ * @param border_width width of the border (0 for background)
+ * @param rows number of lines in the top corners
+ * @param coords the outer coordinates of the currently drawn background or border
+ * @return the buffered slices or NULL if they can't be buffered
+ */
+static const slice_cache_entry_t * slice_cache_get(lv_coord_t rout, lv_coord_t rin, lv_coord_t border_width,
+                                                   lv_coord_t rows, const lv_area_t * coords)
+{
+    uint32_t i;
+    for(i = 0; i < SLICE_CACHE_ENTRY_NUM; i++) {
+        slice_cache_entry_t * e = &slice_cache_entries[i];
+        if(e->rout == rout && e->rin == rin && e->border_width == border_width && e->rows == rows) {
+            _lv_lru_use(&slice_cache, e);
+            return e;
+        }
+    }
+
+    uint32_t size = 2 * rows * rout;
+    slice_cache_entry_t * e = _lv_lru_get_free(&slice_cache, size);
+    if(e == NULL) return NULL;
+
+    e->buf = lv_mem_alloc(size);
+    if(e->buf == NULL) return NULL;
+
+    /*Render the top corners with the masks of the background or border*/
+    lv_coord_t y;
+    for(y = 0; y < rows; y++) {
+        lv_opa_t * left = &e->buf[y * rout];
+        lv_opa_t * right = &e->buf[(rows + y) * rout];
+        lv_draw_mask_res_t res;
+
+        _lv_memset_ff(left, rout);
+        res = lv_draw_mask_apply(left, coords->x1, coords->y1 + y, rout);
+        if(res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(left, rout);
+
+        _lv_memset_ff(right, rout);
+        res = lv_draw_mask_apply(right, coords->x2 - rout + 1, coords->y1 + y, rout);
+        if(res == LV_DRAW_MASK_RES_TRANSP) _lv_memset_00(right, rout);
+    }
+
+    e->rout = rout;
+    e->rin = rin;
+    e->border_width = border_width;
+    e->rows = rows;
+    _lv_lru_add(&slice_cache, e);
+
+    return e;
+}
+
+/**
+ * Get the size of buffered corner slices
+ * @param entry pointer to a `slice_cache_entry_t`
+ * @return the size of the slices in bytes. 0: unused entry
+ */
+static uint32_t slice_cache_size(const void * entry)
+{
+    const slice_cache_entry_t * e = entry;
+    return 2 * e->rows * e->rout;
+}
+
+/**
+ * Free buffered corner slices
+ * @param entry pointer to a `slice_cache_entry_t`
+ */
+static void slice_cache_free(void * entry)
+{
+    slice_cache_entry_t * e = entry;
+    lv_mem_free(e->buf);
+    e->buf = NULL;
+    e->rout = 0;
+}
+
+/**
+ * Blend the left and right corner of a line from the corner slices
+ * @param clip the clip area (absolute coordinates)
+ * @param slice the corner slices
+ * @param coords the outer coordinates of the background or border
+ * @param y the line to draw (absolute coordinates). Has to be in the top or bottom `slice->rows` lines.
+ * @param mask_buf a buffer for the mask of the corners. At least `slice->rout` long
+ * @param color color of the corners
+ * @param opa opacity of the corners
+ * @param opa_to_mask true: mix `opa` into the mask like the masks mixed into a line filled with `opa`
+ * @param mode blend mode
+ */
+LV_ATTRIBUTE_FAST_MEM static void slice_blend_corners(const lv_area_t * clip, const slice_cache_entry_t * slice,
+                                                      const lv_area_t * coords, lv_coord_t y, lv_opa_t * mask_buf,
+                                                      lv_color_t color, lv_opa_t opa, bool opa_to_mask, lv_blend_mode_t mode)
+{
+    if(y < clip->y1 || y > clip->y2) return;
+
+    lv_coord_t rout = slice->rout;
+    lv_coord_t slice_y = y - coords->y1;
+    if(slice_y >= slice->rows) slice_y = coords->y2 - y;
+
+    lv_coord_t x1_corners[2] = {coords->x1, coords->x2 - rout + 1};
+    uint32_t c;
+    for(c = 0; c < 2; c++) {
+        lv_area_t fill_area;
+        fill_area.x1 = x1_corners[c];
+        fill_area.x2 = x1_corners[c] + rout - 1;
+        fill_area.y1 = y;
+        fill_area.y2 = y;
+
+        /*The mask starts at the first visible pixel*/
+        int32_t first = LV_MATH_MAX(clip->x1, fill_area.x1);
+        int32_t last = LV_MATH_MIN(clip->x2, fill_area.x2);
+        if(first > last) continue;
+
+        /*Copy the used part because the mask might be modified by the blending*/
+        const lv_opa_t * src = &slice->buf[(c * slice->rows + slice_y) * rout + (first - fill_area.x1)];
+        int32_t len = last - first + 1;
+        if(opa_to_mask && opa < LV_OPA_MAX) {
+            int32_t i;
+            for(i = 0; i < len; i++) mask_buf[i] = LV_MATH_UDIV255(src[i] * opa);
+        }
+        else {
+            _lv_memcpy_small(mask_buf, src, len);
+        }
+
+        _lv_blend_fill(clip, &fill_area, color, mask_buf, LV_DRAW_MASK_RES_CHANGED,
+                       opa_to_mask ? LV_OPA_COVER : opa, mode);
+    }
+}
+#endif
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_triangle.h"
+#include "lv_draw_blend.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_mem.h"
 
@@ -21,6 +22,9 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool is_plain_bg(const lv_draw_rect_dsc_t * dsc);
+static void draw_polygon_spans(const lv_area_t * poly_coords, const lv_area_t * clip_area,
+                               const lv_draw_mask_line_param_t * mp, uint32_t mp_cnt, const lv_draw_rect_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
@@ -187,7 +191,9 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
 
     } while(mask_cnt < point_cnt);
 
-    lv_draw_rect(&poly_coords, clip_area, draw_dsc);
+    /*Fill only the spans of the rows covered by the polygon if only a plain background is drawn*/
+    if(is_plain_bg(draw_dsc)) draw_polygon_spans(&poly_coords, clip_area, mp, mp_next - mp, draw_dsc);
+    else lv_draw_rect(&poly_coords, clip_area, draw_dsc);
 
     lv_draw_mask_remove_custom(mp);
 
@@ -199,3 +205,72 @@ void lv_draw_polygon(const lv_point_t points[], uint16_t point_cnt, const lv_are
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Check whether a rectangle descriptor draws only a plain background without radius and gradient
+ * @param dsc pointer to a rectangle descriptor
+ * @return true: only a plain background is drawn
+ */
+static bool is_plain_bg(const lv_draw_rect_dsc_t * dsc)
+{
+    if(dsc->radius != 0) return false;
+    if(dsc->bg_grad_dir != LV_GRAD_DIR_NONE && dsc->bg_color.full != dsc->bg_grad_color.full) return false;
+    if(dsc->border_width != 0 && dsc->border_opa > LV_OPA_MIN && dsc->border_side != LV_BORDER_SIDE_NONE) return false;
+#if LV_USE_SHADOW
+    if(dsc->shadow_width != 0 && dsc->shadow_opa > LV_OPA_MIN) return false;
+#endif
+#if LV_USE_OUTLINE
+    if(dsc->outline_width != 0 && dsc->outline_opa > LV_OPA_MIN) return false;
+#endif
+#if LV_USE_PATTERN
+    if(dsc->pattern_image != NULL && dsc->pattern_opa > LV_OPA_MIN) return false;
+#endif
+#if LV_USE_VALUE_STR
+    if(dsc->value_str != NULL && dsc->value_opa > LV_OPA_MIN) return false;
+#endif
+
+    return true;
+}
+
+/**
+ * Fill a polygon row by row. Apply the masks only between the edges of the polygon.
+ * The masks of the polygon's edges should be already added.
+ * @param poly_coords the bounding box of the polygon
+ * @param clip_area the polygon will be drawn only in this area
+ * @param mp the masks of the edges
+ * @param mp_cnt number of masks in `mp`
+ * @param dsc pointer to a rectangle descriptor with plain background
+ */
+static void draw_polygon_spans(const lv_area_t * poly_coords, const lv_area_t * clip_area,
+                               const lv_draw_mask_line_param_t * mp, uint32_t mp_cnt, const lv_draw_rect_dsc_t * dsc)
+{
+    if(dsc->bg_opa <= LV_OPA_MIN) return;
+
+    lv_opa_t opa = dsc->bg_opa;
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    lv_area_t draw_area;
+    if(_lv_area_intersect(&draw_area, poly_coords, clip_area) == false) return;
+
+    lv_opa_t * mask_buf = _lv_mem_buf_get(lv_area_get_width(&draw_area));
+
+    lv_area_t fill_area;
+    for(fill_area.y1 = draw_area.y1; fill_area.y1 <= draw_area.y2; fill_area.y1++) {
+        fill_area.y2 = fill_area.y1;
+        fill_area.x1 = draw_area.x1;
+        fill_area.x2 = draw_area.x2;
+
+        uint32_t i;
+        for(i = 0; i < mp_cnt; i++) {
+            lv_draw_mask_line_limit_x(&mp[i], fill_area.y1, &fill_area.x1, &fill_area.x2);
+        }
+        if(fill_area.x1 > fill_area.x2) continue;
+
+        int32_t fill_w = lv_area_get_width(&fill_area);
+        _lv_memset_ff(mask_buf, fill_w);
+        lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, fill_area.x1, fill_area.y1, fill_w);
+        _lv_blend_fill(clip_area, &fill_area, dsc->bg_color, mask_buf, mask_res, opa, dsc->bg_blend_mode);
+    }
+
+    _lv_mem_buf_release(mask_buf);
+}
@@ -25,6 +25,11 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_IMG_TRANSFORM
+static void transform_row_limit(int64_t v, int32_t step, int64_t min, int64_t max, int32_t * i1, int32_t * i2);
+static inline lv_color_t transform_px_color(const uint8_t * px);
+static inline lv_color_t transform_mix(lv_color_t c1, lv_color_t c2, uint32_t ratio);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -410,6 +415,141 @@ uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
     }
 }
 
+/**
+ * Unpack a row of an `LV_IMG_CF_ALPHA_1/2/4/8BIT` image to opacities
+ * @param src pointer to the byte of the first pixel
+ * @param cf color format of the image
+ * @param px_ofs index of the first pixel in its byte (e.g. 0..7 with 1 bit per pixel)
+ * @param len number of pixels to unpack
+ * @param opa_buf store the opacities here (`len` elements)
+ */
+void _lv_img_buf_unpack_alpha_row(const uint8_t * src, lv_img_cf_t cf, uint8_t px_ofs, lv_coord_t len,
+                                  lv_opa_t * opa_buf)
+{
+    int32_t bpp = lv_img_cf_get_px_size(cf);
+    if(bpp == 8) {
+        _lv_memcpy(opa_buf, src, len);
+        return;
+    }
+
+    int32_t ppb = 8 / bpp;                  /*Pixels per byte*/
+    uint32_t mask = (1 << bpp) - 1;
+    uint32_t mul = LV_OPA_COVER / mask;     /*Scale the values to 0..255. E.g. 85 with 2 bit*/
+    int32_t i = 0;
+    int32_t pos;
+
+    /*The pixels of the first byte if it's not used from its first pixel*/
+    if(px_ofs) {
+        for(pos = 8 - bpp - px_ofs * bpp; pos >= 0 && i < len; pos -= bpp, i++) {
+            opa_buf[i] = ((*src >> pos) & mask) * mul;
+        }
+        src++;
+    }
+
+    /*Whole bytes. Empty and full bytes are very common in icons so handle them at once*/
+    for(; i + ppb <= len; i += ppb, src++) {
+        uint32_t b = *src;
+        if(b == 0x00) _lv_memset_00(&opa_buf[i], ppb);
+        else if(b == 0xFF) _lv_memset_ff(&opa_buf[i], ppb);
+        else {
+            int32_t k;
+            for(k = ppb - 1; k >= 0; k--) {
+                opa_buf[i + k] = (b & mask) * mul;
+                b = b >> bpp;
+            }
+        }
+    }
+
+    /*The first pixels of the last byte*/
+    for(pos = 8 - bpp; i < len; pos -= bpp, i++) {
+        opa_buf[i] = ((*src >> pos) & mask) * mul;
+    }
+}
+
+/**
+ * Unpack a row of an `LV_IMG_CF_INDEXED_1/2/4/8BIT` image with its palette
+ * @param src pointer to the byte of the first pixel
+ * @param cf color format of the image
+ * @param px_ofs index of the first pixel in its byte (e.g. 0..7 with 1 bit per pixel)
+ * @param len number of pixels to unpack
+ * @param palette the colors of the palette
+ * @param palette_opa the opacities of the palette
+ * @param color_buf store the colors here (`len` elements)
+ * @param opa_buf store the opacities here (`len` elements)
+ */
+void _lv_img_buf_unpack_indexed_row(const uint8_t * src, lv_img_cf_t cf, uint8_t px_ofs, lv_coord_t len,
+                                    const lv_color_t * palette, const lv_opa_t * palette_opa,
+                                    lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    int32_t bpp = lv_img_cf_get_px_size(cf);
+    int32_t i = 0;
+    if(bpp == 8) {
+        for(i = 0; i < len; i++) {
+            color_buf[i] = palette[src[i]];
+            opa_buf[i] = palette_opa[src[i]];
+        }
+        return;
+    }
+
+    int32_t ppb = 8 / bpp;                  /*Pixels per byte*/
+    uint32_t mask = (1 << bpp) - 1;
+    int32_t pos;
+
+    /*The pixels of the first byte if it's not used from its first pixel*/
+    if(px_ofs) {
+        for(pos = 8 - bpp - px_ofs * bpp; pos >= 0 && i < len; pos -= bpp, i++) {
+            uint32_t v = (*src >> pos) & mask;
+            color_buf[i] = palette[v];
+            opa_buf[i] = palette_opa[v];
+        }
+        src++;
+    }
+
+    /*Whole bytes*/
+    for(; i + ppb <= len; i += ppb, src++) {
+        uint32_t b = *src;
+        int32_t k;
+        for(k = ppb - 1; k >= 0; k--) {
+            uint32_t v = b & mask;
+            color_buf[i + k] = palette[v];
+            opa_buf[i + k] = palette_opa[v];
+            b = b >> bpp;
+        }
+    }
+
+    /*The first pixels of the last byte*/
+    for(pos = 8 - bpp; i < len; pos -= bpp, i++) {
+        uint32_t v = (*src >> pos) & mask;
+        color_buf[i] = palette[v];
+        opa_buf[i] = palette_opa[v];
+    }
+}
+
+/**
+ * Create the opacities of a row of an `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` image
+ * @param src the colors of the row
+ * @param len number of pixels
+ * @param opa_buf store the opacities here: `LV_OPA_TRANSP` for `LV_COLOR_TRANSP` pixels, else `LV_OPA_COVER`
+ * @return true: there was at least one transparent pixel
+ */
+bool _lv_img_buf_chroma_key_row(const lv_color_t * src, lv_coord_t len, lv_opa_t * opa_buf)
+{
+    lv_color_t ct = LV_COLOR_TRANSP;
+    uint32_t keyed = 0;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+#if LV_COLOR_DEPTH == 32
+        uint32_t k = (src[i].full | 0xFF000000) == ct.full;    /*The alpha channel is not used in the images*/
+#else
+        uint32_t k = src[i].full == ct.full;
+#endif
+        opa_buf[i] = k ? LV_OPA_TRANSP : LV_OPA_COVER;
+        keyed |= k;
+    }
+
+    return keyed ? true : false;
+}
+
 #if LV_USE_IMG_TRANSFORM
 /**
  * Initialize a descriptor to transform an image
@@ -433,6 +573,11 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
     dsc->tmp.sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
     dsc->tmp.cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
 
+    /* Moving 1 pixel in the transformed image moves `cos / zoom` and `sin / zoom` pixels in the source.
+     * Use the full precision of the sine here because the error adds up along the rows*/
+    dsc->tmp.sin_step = (dsc->tmp.sinma * (1 << (16 + 8 - LV_TRIGO_SHIFT))) / dsc->cfg.zoom;
+    dsc->tmp.cos_step = (dsc->tmp.cosma * (1 << (16 + 8 - LV_TRIGO_SHIFT))) / dsc->cfg.zoom;
+
     /*Use smaller value to avoid overflow*/
     dsc->tmp.sinma = dsc->tmp.sinma >> (LV_TRIGO_SHIFT - _LV_TRANSFORM_TRIGO_SHIFT);
     dsc->tmp.cosma = dsc->tmp.cosma >> (LV_TRIGO_SHIFT - _LV_TRANSFORM_TRIGO_SHIFT);
@@ -676,7 +821,234 @@ bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     return true;
 }
+
+/**
+ * Transform a row of pixels at once.
+ * `cfg.antialias` selects bilinear interpolation, else the nearest source pixel is used.
+ * Only `LV_IMG_CF_TRUE_COLOR/_ALPHA/_CHROMA_KEYED` images are supported.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the coordinate of the first pixel of the row relative to the image
+ * @param y the coordinate of the row relative to the image
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here (`len` elements)
+ * @param abuf store the opacities here (`len` elements). 0 where the rotated pixel is out of the image.
+ */
+void _lv_img_buf_transform_row(const lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                               lv_color_t * cbuf, lv_opa_t * abuf)
+{
+    const uint8_t * src_u8 = dsc->cfg.src;
+    int32_t src_w = dsc->cfg.src_w;
+    int32_t src_h = dsc->cfg.src_h;
+    int32_t px_size = dsc->tmp.has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : LV_COLOR_SIZE >> 3;
+    int32_t stride = src_w * px_size;
+    lv_color_t ct = LV_COLOR_TRANSP;
+
+    /* Map the center of the first pixel into the source (16.16 fixed point).
+     * Moving along the row only adds constant steps*/
+    int32_t dx = dsc->tmp.cos_step;
+    int32_t dy = dsc->tmp.sin_step;
+    int64_t xt = 2 * (x - dsc->cfg.pivot_x) + 1;
+    int64_t yt = 2 * (y - dsc->cfg.pivot_y) + 1;
+    int64_t xs64 = ((xt * dx - yt * dy) >> 1) + ((int64_t)dsc->cfg.pivot_x << 16);
+    int64_t ys64 = ((xt * dy + yt * dx) >> 1) + ((int64_t)dsc->cfg.pivot_y << 16);
+
+    /* Interpolate between the centers of the source pixels.
+     * The neighbors out of the image are transparent so the edges are smooth too*/
+    if(dsc->cfg.antialias) {
+        xs64 -= 0x8000;
+        ys64 -= 0x8000;
+    }
+
+    /*Find the pixels which use any pixel of the source. Skip the others without checking them one-by-one*/
+    int64_t min = dsc->cfg.antialias ? -0xFFFF : 0;
+    int32_t i1 = 0;
+    int32_t i2 = len - 1;
+    transform_row_limit(xs64, dx, min, (int64_t)src_w << 16, &i1, &i2);
+    transform_row_limit(ys64, dy, min, (int64_t)src_h << 16, &i1, &i2);
+    if(i1 > i2) {
+        _lv_memset_00(abuf, len);
+        return;
+    }
+
+    if(i1 > 0) _lv_memset_00(abuf, i1);
+    if(i2 < len - 1) _lv_memset_00(abuf + i2 + 1, len - 1 - i2);
+
+    int32_t xs = (int32_t)(xs64 + (int64_t)i1 * dx);
+    int32_t ys = (int32_t)(ys64 + (int64_t)i1 * dy);
+    int32_t i;
+
+    if(dsc->cfg.antialias == 0) {
+        for(i = i1; i <= i2; i++, xs += dx, ys += dy) {
+            const uint8_t * px = &src_u8[(ys >> 16) * stride + (xs >> 16) * px_size];
+            cbuf[i] = transform_px_color(px);
+            if(dsc->tmp.has_alpha) abuf[i] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            else if(dsc->tmp.chroma_keyed && cbuf[i].full == ct.full) abuf[i] = LV_OPA_TRANSP;
+            else abuf[i] = LV_OPA_COVER;
+        }
+        return;
+    }
+
+    for(i = i1; i <= i2; i++, xs += dx, ys += dy) {
+        int32_t xi = xs >> 16;
+        int32_t yi = ys >> 16;
+        uint32_t xr = (xs >> 8) & 0xFF;  /*Ratio of the right neighbors*/
+        uint32_t yr = (ys >> 8) & 0xFF;  /*Ratio of the bottom neighbors*/
+
+        lv_color_t c00;
+        lv_color_t c01;
+        lv_color_t c10;
+        lv_color_t c11;
+        lv_opa_t a00;
+        lv_opa_t a01;
+        lv_opa_t a10;
+        lv_opa_t a11;
+
+        if((uint32_t)xi < (uint32_t)(src_w - 1) && (uint32_t)yi < (uint32_t)(src_h - 1)) {
+            /*All 4 neighbors are in the image*/
+            const uint8_t * px = &src_u8[yi * stride + xi * px_size];
+            c00 = transform_px_color(px);
+            c01 = transform_px_color(px + px_size);
+            c10 = transform_px_color(px + stride);
+            c11 = transform_px_color(px + stride + px_size);
+            if(dsc->tmp.has_alpha) {
+                a00 = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                a01 = px[px_size + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                a10 = px[stride + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                a11 = px[stride + px_size + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            }
+            else if(dsc->tmp.chroma_keyed) {
+                a00 = c00.full == ct.full ? LV_OPA_TRANSP : LV_OPA_COVER;
+                a01 = c01.full == ct.full ? LV_OPA_TRANSP : LV_OPA_COVER;
+                a10 = c10.full == ct.full ? LV_OPA_TRANSP : LV_OPA_COVER;
+                a11 = c11.full == ct.full ? LV_OPA_TRANSP : LV_OPA_COVER;
+            }
+            else {
+                a00 = LV_OPA_COVER;
+                a01 = LV_OPA_COVER;
+                a10 = LV_OPA_COVER;
+                a11 = LV_OPA_COVER;
+            }
+        }
+        else {
+            /*On the edge of the image. The neighbors out of the image are transparent*/
+            lv_color_t c[4];
+            lv_opa_t a[4];
+            uint32_t k;
+            for(k = 0; k < 4; k++) {
+                int32_t xk = xi + (k & 1);
+                int32_t yk = yi + (k >> 1);
+                if((uint32_t)xk >= (uint32_t)src_w || (uint32_t)yk >= (uint32_t)src_h) {
+                    c[k].full = 0;
+                    a[k] = LV_OPA_TRANSP;
+                    continue;
+                }
+                const uint8_t * px = &src_u8[yk * stride + xk * px_size];
+                c[k] = transform_px_color(px);
+                if(dsc->tmp.has_alpha) a[k] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+                else if(dsc->tmp.chroma_keyed && c[k].full == ct.full) a[k] = LV_OPA_TRANSP;
+                else a[k] = LV_OPA_COVER;
+            }
+            c00 = c[0];
+            c01 = c[1];
+            c10 = c[2];
+            c11 = c[3];
+            a00 = a[0];
+            a01 = a[1];
+            a10 = a[2];
+            a11 = a[3];
+        }
+
+        /*Mix the opacities as they are but don't let the color of transparent pixels bleed in*/
+        lv_opa_t a0 = (a00 * (256 - xr) + a01 * xr) >> 8;
+        lv_opa_t a1 = (a10 * (256 - xr) + a11 * xr) >> 8;
+        abuf[i] = (a0 * (256 - yr) + a1 * yr) >> 8;
+
+        lv_color_t c0;
+        if(a00 == LV_OPA_TRANSP) c0 = c01;
+        else if(a01 == LV_OPA_TRANSP) c0 = c00;
+        else c0 = transform_mix(c00, c01, xr);
+
+        lv_color_t c1;
+        if(a10 == LV_OPA_TRANSP) c1 = c11;
+        else if(a11 == LV_OPA_TRANSP) c1 = c10;
+        else c1 = transform_mix(c10, c11, xr);
+
+        if(a0 == LV_OPA_TRANSP) cbuf[i] = c1;
+        else if(a1 == LV_OPA_TRANSP) cbuf[i] = c0;
+        else cbuf[i] = transform_mix(c0, c1, yr);
+    }
+}
 #endif
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_USE_IMG_TRANSFORM
+/**
+ * Limit a range of a row to the pixels where a source coordinate is in a given range.
+ * @param v the source coordinate at the first pixel of the row
+ * @param step the change of the source coordinate per pixel
+ * @param min the smallest allowed source coordinate
+ * @param max the source coordinate has to be smaller than this
+ * @param i1 the first pixel of the range. Updated to the first pixel with a valid coordinate.
+ * @param i2 the last pixel of the range. Updated to the last pixel with a valid coordinate.
+ */
+static void transform_row_limit(int64_t v, int32_t step, int64_t min, int64_t max, int32_t * i1, int32_t * i2)
+{
+    int64_t first;
+    int64_t last;
+    if(step == 0) {
+        if(v < min || v >= max) *i2 = *i1 - 1;
+        return;
+    }
+    else if(step > 0) {
+        first = v >= min ? 0 : (min - v + step - 1) / step;
+        last = v < max ? (max - v + step - 1) / step - 1 : -1;
+    }
+    else {
+        first = v < max ? 0 : (v - max) / -step + 1;
+        last = v >= min ? (v - min) / -step : -1;
+    }
+
+    if(first > *i1) *i1 = first > *i2 ? *i2 + 1 : (int32_t)first;
+    if(last < *i2) *i2 = last < *i1 ? *i1 - 1 : (int32_t)last;
+}
+
+static inline lv_color_t transform_px_color(const uint8_t * px)
+{
+    lv_color_t c;
+#if LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8
+    c.full = px[0];
+#elif LV_COLOR_DEPTH == 16
+    c.full = px[0] + (px[1] << 8);
+#elif LV_COLOR_DEPTH == 32
+    _lv_memcpy_small(&c, px, sizeof(lv_color_t));
+    c.ch.alpha = 0xFF;
+#endif
+    return c;
+}
+
+/**
+ * Mix two colors of the source image.
+ * @param c1 the first color
+ * @param c2 the second color
+ * @param ratio ratio of `c2` [0..255]
+ * @return the mixed color
+ */
+static inline lv_color_t transform_mix(lv_color_t c1, lv_color_t c2, uint32_t ratio)
+{
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    /* Spread the channels with gaps in a 32 bit word: -GGGGGG- -----RRR RR------ ---BBBBB
+     * to mix all of them with a single multiplication. 5 bit ratio makes the products fit into the gaps.*/
+    uint32_t r2 = (ratio + 4) >> 3;
+    uint32_t w1 = (c1.full | ((uint32_t)c1.full << 16)) & 0x07E0F81F;
+    uint32_t w2 = (c2.full | ((uint32_t)c2.full << 16)) & 0x07E0F81F;
+    uint32_t w = ((w1 * (32 - r2) + w2 * r2) >> 5) & 0x07E0F81F;
+    lv_color_t c;
+    c.full = (uint16_t)(w | (w >> 16));
+    return c;
+#else
+    return lv_color_mix(c2, c1, ratio);
+#endif
+}
+#endif
@@ -166,6 +166,8 @@ typedef struct {
         int32_t pivot_y_256;
         int32_t sinma;
         int32_t cosma;
+        int32_t sin_step;           /*Step of the source coordinates in a row (16.16 fixed point)*/
+        int32_t cos_step;
 
         uint8_t chroma_keyed : 1;
         uint8_t has_alpha : 1;
@@ -265,6 +267,41 @@ void lv_img_buf_free(lv_img_dsc_t * dsc);
  */
 uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf);
 
+/**
+ * Unpack a row of an `LV_IMG_CF_ALPHA_1/2/4/8BIT` image to opacities
+ * @param src pointer to the byte of the first pixel
+ * @param cf color format of the image
+ * @param px_ofs index of the first pixel in its byte (e.g. 0..7 with 1 bit per pixel)
+ * @param len number of pixels to unpack
+ * @param opa_buf store the opacities here (`len` elements)
+ */
+void _lv_img_buf_unpack_alpha_row(const uint8_t * src, lv_img_cf_t cf, uint8_t px_ofs, lv_coord_t len,
+                                  lv_opa_t * opa_buf);
+
+/**
+ * Unpack a row of an `LV_IMG_CF_INDEXED_1/2/4/8BIT` image with its palette
+ * @param src pointer to the byte of the first pixel
+ * @param cf color format of the image
+ * @param px_ofs index of the first pixel in its byte (e.g. 0..7 with 1 bit per pixel)
+ * @param len number of pixels to unpack
+ * @param palette the colors of the palette
+ * @param palette_opa the opacities of the palette
+ * @param color_buf store the colors here (`len` elements)
+ * @param opa_buf store the opacities here (`len` elements)
+ */
+void _lv_img_buf_unpack_indexed_row(const uint8_t * src, lv_img_cf_t cf, uint8_t px_ofs, lv_coord_t len,
+                                    const lv_color_t * palette, const lv_opa_t * palette_opa,
+                                    lv_color_t * color_buf, lv_opa_t * opa_buf);
+
+/**
+ * Create the opacities of a row of an `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` image
+ * @param src the colors of the row
+ * @param len number of pixels
+ * @param opa_buf store the opacities here: `LV_OPA_TRANSP` for `LV_COLOR_TRANSP` pixels, else `LV_OPA_COVER`
+ * @return true: there was at least one transparent pixel
+ */
+bool _lv_img_buf_chroma_key_row(const lv_color_t * src, lv_coord_t len, lv_opa_t * opa_buf);
+
 #if LV_USE_IMG_TRANSFORM
 /**
  * Initialize a descriptor to rotate an image
@@ -278,6 +315,20 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc);
  */
 bool _lv_img_buf_transform_anti_alias(lv_img_transform_dsc_t * dsc);
 
+/**
+ * Transform a row of pixels at once.
+ * `cfg.antialias` selects bilinear interpolation, else the nearest source pixel is used.
+ * Only `LV_IMG_CF_TRUE_COLOR/_ALPHA/_CHROMA_KEYED` images are supported.
+ * @param dsc a descriptor initialized by `_lv_img_buf_transform_init`
+ * @param x the coordinate of the first pixel of the row relative to the image
+ * @param y the coordinate of the row relative to the image
+ * @param len number of pixels to transform
+ * @param cbuf store the colors here (`len` elements)
+ * @param abuf store the opacities here (`len` elements). 0 where the rotated pixel is out of the image.
+ */
+void _lv_img_buf_transform_row(const lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                               lv_color_t * cbuf, lv_opa_t * abuf);
+
 /**
  * Get which color and opa would come to a pixel if it were rotated
  * @param dsc a descriptor initialized by `lv_img_buf_rotate_init`
@@ -12,6 +12,9 @@
 #include "lv_draw_img.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_lru.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -26,26 +29,68 @@
  * "die" from very high values */
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Marks the end of a hash bucket's or the free entries' list*/
+#define LV_IMG_CACHE_ENTRY_NONE 0xFFFF
+
+/*Number of zoom/angle pairs tracked by the transform cache (including the ones seen only once yet)*/
+#define LV_IMG_TRANSFORM_CACHE_ENTRY_NUM 8
+
+#define TRANSFORM_CACHE (LV_USE_IMG_TRANSFORM && LV_IMG_TRANSFORM_CACHE_SIZE)
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if TRANSFORM_CACHE
+typedef struct {
+    lv_lru_entry_t lru;
+    const void * src;       /*Source of the image. Files are stored with a copy of their path. NULL: unused entry*/
+    uint8_t * map;          /*The transformed `LV_IMG_CF_TRUE_COLOR_ALPHA` map. NULL if not created yet*/
+    lv_area_t area;         /*Area of `map` relative to the image*/
+    uint32_t first_time;    /*Tick when the pair was requested first*/
+    lv_point_t pivot;
+    lv_color_t color;
+    int16_t angle;
+    uint16_t zoom;
+    uint8_t antialias : 1;
+} transform_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_DEF_SIZE || TRANSFORM_CACHE
     static bool lv_img_cache_match(const void * src1, const void * src2);
 #endif
-
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    static lv_img_cache_entry_t cache_temp;
+#if LV_IMG_CACHE_DEF_SIZE
+    static uint32_t lv_img_cache_hash(const void * src);
+    static uint32_t entry_size_calc(const lv_img_decoder_dsc_t * dsc);
+    static void entry_drop(uint16_t idx);
+#endif
+#if TRANSFORM_CACHE
+    static uint32_t transform_cache_size(const void * entry);
+    static void transform_cache_free(void * entry);
+    static bool transform_cache_create(transform_cache_entry_t * e, const lv_img_decoder_dsc_t * dec_dsc);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Images which are not kept in the cache are opened here*/
+static lv_img_cache_entry_t cache_temp;
+
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t * bucket;       /*Index of the first entry in each hash bucket*/
+    static uint16_t bucket_mask;    /*Number of buckets - 1. The number of buckets is a power of 2*/
+    static uint16_t free_first;     /*Index of the first unused entry*/
+    static uint32_t cache_time;     /*Incremented in every open. The entries' `life` is compared to it*/
+    static uint32_t cache_mem_size = LV_IMG_CACHE_MEM_SIZE;
+    static lv_img_cache_stats_t cache_stats;
+#endif
+#if TRANSFORM_CACHE
+    static transform_cache_entry_t transform_cache_entries[LV_IMG_TRANSFORM_CACHE_ENTRY_NUM];
+    static lv_lru_t transform_cache = _LV_LRU_INIT(transform_cache_entries, LV_IMG_TRANSFORM_CACHE_SIZE,
+                                                   transform_cache_size, transform_cache_free);
 #endif
 
 /**********************
@@ -66,9 +111,6 @@
  */
 lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 {
-    /*Is the image cached?*/
-    lv_img_cache_entry_t * cached_src = NULL;
-
 #if LV_IMG_CACHE_DEF_SIZE
     if(entry_cnt == 0) {
         LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
@@ -77,62 +119,41 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
+    /*Make the entries older*/
+    cache_time += LV_IMG_CACHE_AGING;
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+    uint32_t hash = lv_img_cache_hash(src);
+    uint16_t i;
+    for(i = bucket[hash & bucket_mask]; i != LV_IMG_CACHE_ENTRY_NONE; i = cache[i].next) {
+        lv_img_cache_entry_t * e = &cache[i];
+        if(e->hash == hash && color.full == e->dec_dsc.color.full && lv_img_cache_match(src, e->dec_dsc.src)) {
             /* If opened increment its life.
              * Image difficult to open should live longer to keep avoid frequent their recaching.
              * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+            int32_t life = (int32_t)(e->life - cache_time);
+            if(life < 0) life = 0;
+            life += e->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+            if(life > LV_IMG_CACHE_LIFE_LIMIT) life = LV_IMG_CACHE_LIFE_LIMIT;
+            e->life = cache_time + life;
+            cache_stats.hit++;
             LV_LOG_TRACE("image draw: image found in the cache");
-            break;
-        }
-    }
-
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
+            return e;
         }
     }
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
-#else
-    cached_src = &cache_temp;
+    cache_stats.miss++;
 #endif
+
     /*Open the image and measure the time to open*/
+    lv_img_cache_entry_t * cached_src = &cache_temp;
     uint32_t t_start  = lv_tick_get();
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -140,13 +161,92 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Don't keep the image if it would fill the cache alone. It's closed by `_lv_img_cache_release`*/
+    uint32_t size = entry_size_calc(&cached_src->dec_dsc);
+    if(cache_mem_size && size > cache_mem_size) {
+        LV_LOG_INFO("image draw: cache miss, the image is too large to cache");
+        return cached_src;
+    }
+
+    /*Make room for the image. Drop the entries with the least life*/
+    while(free_first == LV_IMG_CACHE_ENTRY_NONE ||
+          (cache_mem_size && cache_stats.mem_used + size > cache_mem_size)) {
+        uint16_t weakest = LV_IMG_CACHE_ENTRY_NONE;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src == NULL) continue;
+            if(weakest == LV_IMG_CACHE_ENTRY_NONE ||
+               (int32_t)(cache[i].life - cache[weakest].life) < 0) {
+                weakest = i;
+            }
+        }
+
+        /*Nothing to drop. It's closed by `_lv_img_cache_release`*/
+        if(weakest == LV_IMG_CACHE_ENTRY_NONE) return cached_src;
+
+        entry_drop(weakest);
+        cache_stats.evict++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    }
+
+    /*Move the opened image to a free entry and add it to its bucket*/
+    i = free_first;
+    lv_img_cache_entry_t * e = &cache[i];
+    free_first = e->next;
+    _lv_memcpy(&e->dec_dsc, &cached_src->dec_dsc, sizeof(lv_img_decoder_dsc_t));
+    _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
+
+    e->life = cache_time;
+    e->size = size;
+    e->hash = hash;
+    e->next = bucket[hash & bucket_mask];
+    bucket[hash & bucket_mask] = i;
+
+    cache_stats.mem_used += size;
+    cache_stats.entry_cnt++;
+
+    return e;
+#else
     return cached_src;
+#endif
+}
+
+/**
+ * Close an image opened by ::lv_img_cache_open if it wasn't kept in the cache.
+ * Should be called when the image is not used anymore.
+ * @param entry pointer to the cache entry returned by ::lv_img_cache_open
+ */
+void _lv_img_cache_release(lv_img_cache_entry_t * entry)
+{
+    if(entry != &cache_temp) return;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    _lv_memset_00(entry, sizeof(lv_img_cache_entry_t));
+}
+
+/**
+ * Close an image opened by ::lv_img_cache_open and remove it from the cache.
+ * Used if the image can't be read so it's opened again when it's drawn next time.
+ * @param entry pointer to the cache entry returned by ::lv_img_cache_open
+ */
+void _lv_img_cache_drop(lv_img_cache_entry_t * entry)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(entry != &cache_temp) {
+        lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        entry_drop(entry - cache);
+        return;
+    }
+#endif
+
+    _lv_img_cache_release(entry);
 }
 
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * The RAM used by the cached images is limited by ::lv_img_cache_set_mem_size too.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_entry_cnt)
@@ -159,25 +259,192 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        LV_GC_ROOT(_lv_img_cache_array) = NULL;
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    entry_cnt = 0;
+    bucket = NULL;
+    bucket_mask = 0;
+    free_first = LV_IMG_CACHE_ENTRY_NONE;
+    if(new_entry_cnt == 0) return;
+    if(new_entry_cnt == LV_IMG_CACHE_ENTRY_NONE) new_entry_cnt--;
+
+    /*Use at least as many buckets as entries*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < new_entry_cnt) bucket_cnt <<= 1;
+
+    /*Reallocate the cache. The buckets are stored after the entries*/
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * bucket_cnt);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
-        return;
-    }
+    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) return;
+
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
     entry_cnt = new_entry_cnt;
+    bucket = (uint16_t *)&cache[entry_cnt];
+    bucket_mask = bucket_cnt - 1;
 
     /*Clean the cache*/
-    _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(lv_img_cache_entry_t));
+    _lv_memset_00(cache, entry_cnt * sizeof(lv_img_cache_entry_t));
+    _lv_memset_ff(bucket, bucket_cnt * sizeof(uint16_t));
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) cache[i].next = i + 1;
+    cache[entry_cnt - 1].next = LV_IMG_CACHE_ENTRY_NONE;
+    free_first = 0;
+#endif
+}
+
+/**
+ * Set the RAM the cached images can use together.
+ * The images which wouldn't fit into it alone are not cached at all.
+ * @param mem_size the budget in bytes. 0: no limit, only the number of images is limited
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(mem_size);
+    LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    cache_mem_size = mem_size;
+    if(mem_size == 0) return;
+
+    /*Drop the images with the least life until the rest fits*/
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    while(cache_stats.mem_used > mem_size) {
+        uint16_t weakest = LV_IMG_CACHE_ENTRY_NONE;
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src == NULL) continue;
+            if(weakest == LV_IMG_CACHE_ENTRY_NONE ||
+               (int32_t)(cache[i].life - cache[weakest].life) < 0) {
+                weakest = i;
+            }
+        }
+        if(weakest == LV_IMG_CACHE_ENTRY_NONE) break;
+
+        entry_drop(weakest);
+        cache_stats.evict++;
+    }
+#endif
+}
+
+/**
+ * Get the RAM the cached images can use together.
+ * @return the budget in bytes. 0: no limit (or the cache is disabled)
+ */
+uint32_t lv_img_cache_get_mem_size(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    return cache_mem_size;
+#else
+    return 0;
 #endif
 }
 
+/**
+ * Get the statistics of the image cache
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_memcpy_small(stats, &cache_stats, sizeof(lv_img_cache_stats_t));
+#else
+    _lv_memset_00(stats, sizeof(lv_img_cache_stats_t));
+#endif
+}
+
+#if TRANSFORM_CACHE
+/**
+ * Get the transformed copy of an opened image.
+ * A zoom/angle pair is transformed only when it's requested again after a refresh period
+ * so animated images are not transformed as a whole in every frame.
+ * The copy is a snapshot: if the pixels of the source are changed in place
+ * `lv_img_cache_invalidate_src()` has to be called to transform them again.
+ * @param cdsc an opened image whose decoder gave the whole uncompressed image (`img_data`)
+ * @param angle angle of rotation (0.1 degree units)
+ * @param zoom zoom (256 no zoom)
+ * @param pivot pivot of the rotation relative to the image
+ * @param antialias true: interpolate the pixels (bilinear); false: use the nearest pixel
+ * @param area store the area of the transformed map relative to the image here
+ * @return pointer to an `LV_IMG_CF_TRUE_COLOR_ALPHA` map of `area` or NULL if it's not cached
+ */
+const uint8_t * _lv_img_cache_get_transformed(const lv_img_cache_entry_t * cdsc, int16_t angle, uint16_t zoom,
+                                              const lv_point_t * pivot, bool antialias, lv_area_t * area)
+{
+    const lv_img_decoder_dsc_t * dec_dsc = &cdsc->dec_dsc;
+    lv_img_cf_t cf = dec_dsc->header.cf;
+    if(dec_dsc->img_data == NULL) return NULL;
+    if(cf != LV_IMG_CF_TRUE_COLOR && cf != LV_IMG_CF_TRUE_COLOR_ALPHA && cf != LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+        return NULL;
+    }
+
+    transform_cache_entry_t * e = NULL;
+    uint32_t i;
+    for(i = 0; i < LV_IMG_TRANSFORM_CACHE_ENTRY_NUM; i++) {
+        transform_cache_entry_t * t = &transform_cache_entries[i];
+        if(t->src && t->angle == angle && t->zoom == zoom && t->antialias == antialias &&
+           t->pivot.x == pivot->x && t->pivot.y == pivot->y && t->color.full == dec_dsc->color.full &&
+           lv_img_cache_match(dec_dsc->src, t->src)) {
+            e = t;
+            break;
+        }
+    }
+
+    if(e) {
+        _lv_lru_use(&transform_cache, e);
+        if(e->map == NULL) {
+            if(lv_tick_elaps(e->first_time) < LV_DISP_DEF_REFR_PERIOD) return NULL;
+            if(transform_cache_create(e, dec_dsc) == false) return NULL;
+        }
+
+        lv_area_copy(area, &e->area);
+        return e->map;
+    }
+
+    /* Remember the pair. Replace the least recently used entry if there is no free one.
+     * (`_lv_lru_get_free` would take the pairs without map as free even if they were requested recently)*/
+    uint32_t time = transform_cache.time;
+    for(i = 0; i < LV_IMG_TRANSFORM_CACHE_ENTRY_NUM; i++) {
+        transform_cache_entry_t * t = &transform_cache_entries[i];
+        if(t->src == NULL) {
+            e = t;
+            break;
+        }
+        if(e == NULL || time - t->lru.life > time - e->lru.life) e = t;
+    }
+    _lv_lru_drop(&transform_cache, e);
+
+    if(lv_img_src_get_type(dec_dsc->src) == LV_IMG_SRC_FILE) {
+        char * path = lv_mem_alloc(strlen(dec_dsc->src) + 1);
+        LV_ASSERT_MEM(path);
+        if(path == NULL) return NULL;
+        strcpy(path, dec_dsc->src);
+        e->src = path;
+    }
+    else {
+        e->src = dec_dsc->src;
+    }
+
+    e->first_time = lv_tick_get();
+    _lv_lru_use(&transform_cache, e);
+    e->pivot = *pivot;
+    e->color = dec_dsc->color;
+    e->angle = angle;
+    e->zoom = zoom;
+    e->antialias = antialias ? 1 : 0;
+
+    return NULL;
+}
+#endif
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * The transformed copies of the image are dropped too. As they are snapshots of the pixels
+ * it has to be called whenever the data of an `lv_img_dsc_t` variable is changed in place and the image
+ * is drawn rotated or zoomed. (`lv_canvas` calls it from its drawing functions.)
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src)
@@ -186,13 +453,29 @@ void lv_img_cache_invalidate_src(const void * src)
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
     uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+    if(src == NULL) {
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src != NULL) entry_drop(i);
+        }
+    }
+    else if(entry_cnt) {
+        /*Drop the image with all colors. They are in the same bucket*/
+        uint32_t hash = lv_img_cache_hash(src);
+        i = bucket[hash & bucket_mask];
+        while(i != LV_IMG_CACHE_ENTRY_NONE) {
+            uint16_t next = cache[i].next;
+            if(cache[i].hash == hash && lv_img_cache_match(src, cache[i].dec_dsc.src)) entry_drop(i);
+            i = next;
+        }
+    }
+#endif
 
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+#if TRANSFORM_CACHE
+    uint32_t t;
+    for(t = 0; t < LV_IMG_TRANSFORM_CACHE_ENTRY_NUM; t++) {
+        if(transform_cache_entries[t].src == NULL) continue;
+        if(src == NULL || lv_img_cache_match(src, transform_cache_entries[t].src)) {
+            _lv_lru_drop(&transform_cache, &transform_cache_entries[t]);
         }
     }
 #endif
@@ -202,7 +485,7 @@ void lv_img_cache_invalidate_src(const void * src)
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_IMG_CACHE_DEF_SIZE
+#if LV_IMG_CACHE_DEF_SIZE || TRANSFORM_CACHE
 static bool lv_img_cache_match(const void * src1, const void * src2)
 {
     lv_img_src_t src_type = lv_img_src_get_type(src1);
@@ -215,3 +498,175 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
     return strcmp(src1, src2) == 0;
 }
 #endif
+
+#if LV_IMG_CACHE_DEF_SIZE
+/**
+ * Hash an image source. Files are hashed by their path, variables by their address.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @return the hash
+ */
+static uint32_t lv_img_cache_hash(const void * src)
+{
+    uint32_t hash;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        /*FNV-1a*/
+        const uint8_t * p = src;
+        hash = 2166136261U;
+        while(*p) {
+            hash ^= *p;
+            hash *= 16777619U;
+            p++;
+        }
+    }
+    else {
+        hash = (uint32_t)(lv_uintptr_t)src;
+        hash ^= hash >> 16;
+        hash *= 0x45D9F3BU;
+        hash ^= hash >> 16;
+    }
+
+    return hash;
+}
+
+/**
+ * Estimate the RAM used by an opened image
+ * @param dsc the opened image
+ * @return the size in bytes
+ */
+static uint32_t entry_size_calc(const lv_img_decoder_dsc_t * dsc)
+{
+    uint32_t size = 0;
+    lv_img_cf_t cf = dsc->header.cf;
+
+    if(dsc->src_type == LV_IMG_SRC_FILE) size += strlen(dsc->src) + 1;
+
+    /*The decoder told it*/
+    if(dsc->mem_size) {
+        size += dsc->mem_size;
+    }
+    /*The decoder decoded the whole image into its own buffer*/
+    else if(dsc->img_data) {
+        if(dsc->src_type != LV_IMG_SRC_VARIABLE || dsc->img_data != ((const lv_img_dsc_t *)dsc->src)->data) {
+            size += lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, cf);
+        }
+    }
+    /*The palette of indexed images is kept while the image is read line by line*/
+    else if(cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT) {
+        uint32_t palette_size = 1 << lv_img_cf_get_px_size(cf);
+        size += palette_size * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+    }
+
+    return size;
+}
+
+/**
+ * Close the image of an entry and free the entry
+ * @param idx index of the entry
+ */
+static void entry_drop(uint16_t idx)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * e = &cache[idx];
+
+    /*Remove the entry from its bucket*/
+    uint16_t * link = &bucket[e->hash & bucket_mask];
+    while(*link != idx) link = &cache[*link].next;
+    *link = e->next;
+
+    lv_img_decoder_close(&e->dec_dsc);
+    cache_stats.mem_used -= e->size;
+    cache_stats.entry_cnt--;
+
+    _lv_memset_00(e, sizeof(lv_img_cache_entry_t));
+    e->next = free_first;
+    free_first = idx;
+}
+#endif
+
+#if TRANSFORM_CACHE
+/**
+ * Get the RAM used by the map of a transform cache entry
+ * @param entry pointer to a `transform_cache_entry_t`
+ * @return size of the map or 0 if the entry has no map
+ */
+static uint32_t transform_cache_size(const void * entry)
+{
+    const transform_cache_entry_t * e = entry;
+    return e->map ? lv_area_get_size(&e->area) * LV_IMG_PX_SIZE_ALPHA_BYTE : 0;
+}
+
+/**
+ * Free a transform cache entry and its map
+ * @param entry pointer to a `transform_cache_entry_t`
+ */
+static void transform_cache_free(void * entry)
+{
+    transform_cache_entry_t * e = entry;
+    if(e->map) lv_mem_free(e->map);
+
+    if(e->src && lv_img_src_get_type(e->src) == LV_IMG_SRC_FILE) lv_mem_free((void *)e->src);
+
+    _lv_memset_00(e, sizeof(transform_cache_entry_t));
+}
+
+/**
+ * Transform the whole image into the map of an entry.
+ * Drop the least recently used maps if there is not enough room for it.
+ * @param e pointer to an entry with the transformation's parameters
+ * @param dec_dsc the opened image
+ * @return true: the map is created; false: the map is too large or out of memory
+ */
+static bool transform_cache_create(transform_cache_entry_t * e, const lv_img_decoder_dsc_t * dec_dsc)
+{
+    lv_coord_t src_w = dec_dsc->header.w;
+    lv_coord_t src_h = dec_dsc->header.h;
+    lv_area_t area;
+    _lv_img_buf_get_transformed_area(&area, src_w, src_h, e->angle, e->zoom, &e->pivot);
+
+    /*Only make room for the map. `e` has no map yet so it's an unused entry for `lv_lru` and it's not freed.*/
+    uint32_t size = lv_area_get_size(&area) * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    if(_lv_lru_get_free(&transform_cache, size) == NULL) return false;
+
+    uint8_t * map = lv_mem_alloc(size);
+    if(map == NULL) return false;
+
+    lv_img_transform_dsc_t trans_dsc;
+    _lv_memset_00(&trans_dsc, sizeof(lv_img_transform_dsc_t));
+    trans_dsc.cfg.angle = e->angle;
+    trans_dsc.cfg.zoom = e->zoom;
+    trans_dsc.cfg.src = dec_dsc->img_data;
+    trans_dsc.cfg.src_w = src_w;
+    trans_dsc.cfg.src_h = src_h;
+    trans_dsc.cfg.cf = dec_dsc->header.cf;
+    trans_dsc.cfg.pivot_x = e->pivot.x;
+    trans_dsc.cfg.pivot_y = e->pivot.y;
+    trans_dsc.cfg.color = e->color;
+    trans_dsc.cfg.antialias = e->antialias;
+    _lv_img_buf_transform_init(&trans_dsc);
+
+    lv_coord_t w = lv_area_get_width(&area);
+    lv_color_t * cbuf = _lv_mem_buf_get(w * sizeof(lv_color_t));
+    lv_opa_t * abuf = _lv_mem_buf_get(w);
+
+    uint8_t * map_px = map;
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        _lv_img_buf_transform_row(&trans_dsc, area.x1, y, w, cbuf, abuf);
+        lv_coord_t x;
+        for(x = 0; x < w; x++) {
+            _lv_memcpy_small(map_px, &cbuf[x], LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = abuf[x];
+            map_px += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+
+    _lv_mem_buf_release(abuf);
+    _lv_mem_buf_release(cbuf);
+
+    e->map = map;
+    lv_area_copy(&e->area, &area);
+    _lv_lru_add(&transform_cache, e);
+
+    return true;
+}
+#endif
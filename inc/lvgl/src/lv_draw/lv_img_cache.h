@@ -31,12 +31,28 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
-    int32_t life;
+    /** The time (in number of opens) until the entry is kept. It's compared to the cache's clock
+     * which is incremented in every ::lv_img_cache_open so the entries get older without touching them.
+     * Add `time_to_open` to the remaining life when the entry is used.
+     * The entry with the least remaining life is reused first*/
+    uint32_t life;
+
+    uint32_t size;      /**< Approximate RAM used by the opened image [bytes]*/
+    uint32_t hash;      /**< Hash of the image's source*/
+    uint16_t next;      /**< Index of the next entry in the same hash bucket (or in the list of free entries)*/
 } lv_img_cache_entry_t;
 
+/**
+ * Statistics of the image cache
+ */
+typedef struct {
+    uint32_t hit;       /**< Number of opens served from the cache*/
+    uint32_t miss;      /**< Number of opens which needed to open the image with its decoder*/
+    uint32_t evict;     /**< Number of entries dropped to make room for a new image*/
+    uint32_t mem_used;  /**< Approximate RAM used by the cached images [bytes]*/
+    uint16_t entry_cnt; /**< Number of cached images*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -51,17 +67,73 @@ typedef struct {
  */
 lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
 
+#if LV_USE_IMG_TRANSFORM && LV_IMG_TRANSFORM_CACHE_SIZE
+/**
+ * Get the transformed copy of an opened image.
+ * A zoom/angle pair is transformed only when it's requested again after a refresh period
+ * so animated images are not transformed as a whole in every frame.
+ * The copy is a snapshot: if the pixels of the source are changed in place
+ * `lv_img_cache_invalidate_src()` has to be called to transform them again.
+ * @param cdsc an opened image whose decoder gave the whole uncompressed image (`img_data`)
+ * @param angle angle of rotation (0.1 degree units)
+ * @param zoom zoom (256 no zoom)
+ * @param pivot pivot of the rotation relative to the image
+ * @param antialias true: interpolate the pixels (bilinear); false: use the nearest pixel
+ * @param area store the area of the transformed map relative to the image here
+ * @return pointer to an `LV_IMG_CF_TRUE_COLOR_ALPHA` map of `area` or NULL if it's not cached
+ */
+const uint8_t * _lv_img_cache_get_transformed(const lv_img_cache_entry_t * cdsc, int16_t angle, uint16_t zoom,
+                                              const lv_point_t * pivot, bool antialias, lv_area_t * area);
+#endif
+
+/**
+ * Close an image opened by ::lv_img_cache_open if it wasn't kept in the cache.
+ * Should be called when the image is not used anymore.
+ * @param entry pointer to the cache entry returned by ::lv_img_cache_open
+ */
+void _lv_img_cache_release(lv_img_cache_entry_t * entry);
+
+/**
+ * Close an image opened by ::lv_img_cache_open and remove it from the cache.
+ * Used if the image can't be read so it's opened again when it's drawn next time.
+ * @param entry pointer to the cache entry returned by ::lv_img_cache_open
+ */
+void _lv_img_cache_drop(lv_img_cache_entry_t * entry);
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
  * E.g. if 20 PNG or JPG images are open in the RAM they consume memory while opened in the cache.
+ * The RAM used by the cached images is limited by ::lv_img_cache_set_mem_size too.
  * @param new_entry_cnt number of image to cache
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set the RAM the cached images can use together.
+ * The images which wouldn't fit into it alone are not cached at all.
+ * @param mem_size the budget in bytes. 0: no limit, only the number of images is limited
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size);
+
+/**
+ * Get the RAM the cached images can use together.
+ * @return the budget in bytes. 0: no limit (or the cache is disabled)
+ */
+uint32_t lv_img_cache_get_mem_size(void);
+
+/**
+ * Get the statistics of the image cache
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * The transformed copies of the image are dropped too. As they are snapshots of the pixels
+ * it has to be called whenever the data of an `lv_img_dsc_t` variable is changed in place and the image
+ * is drawn rotated or zoomed. (`lv_canvas` calls it from its drawing functions.)
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src);
@@ -9,6 +9,8 @@
 #include "lv_img_decoder.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_draw/lv_draw_img.h"
+#include "lv_img_png.h"
+#include "lv_img_rle.h"
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_gc.h"
 
@@ -38,6 +40,14 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_line_alpha_split(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                         lv_coord_t len, lv_opa_t * opa_buf);
+static lv_res_t lv_img_decoder_built_in_line_indexed_split(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                           lv_coord_t len, lv_color_t * color_buf, lv_opa_t * opa_buf);
+#if LV_IMG_CF_ALPHA || LV_IMG_CF_INDEXED
+static const uint8_t * lv_img_decoder_built_in_line_bits(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                         lv_coord_t len, uint8_t * fs_buf, uint8_t * px_ofs);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +82,14 @@ void _lv_img_decoder_init(void)
     lv_img_decoder_set_open_cb(decoder, lv_img_decoder_built_in_open);
     lv_img_decoder_set_read_line_cb(decoder, lv_img_decoder_built_in_read_line);
     lv_img_decoder_set_close_cb(decoder, lv_img_decoder_built_in_close);
+
+#if LV_USE_PNG
+    _lv_img_png_init();
+#endif
+
+#if LV_USE_RLE
+    _lv_img_rle_init();
+#endif
 }
 
 /**
@@ -153,6 +171,7 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         dsc->img_data  = NULL;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
+        dsc->mem_size = 0;
     }
 
     if(dsc->src_type == LV_IMG_SRC_FILE)
@@ -178,6 +197,78 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Read a line from an opened image into separate color and opacity buffers which are ready to blend.
+ * The built-in alpha, indexed and chroma keyed formats are unpacked directly into the buffers.
+ * The lines of other decoders are read with `read_line` and split.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param x start X coordinate (from left)
+ * @param y start Y coordinate (from top)
+ * @param len number of pixels to read
+ * @param color_buf store the colors here (`len` elements).
+ *                  Not written with `LV_IMG_CF_ALPHA_...` formats as their color is always `dsc->color`.
+ * @param opa_buf store the opacities here (`len` elements)
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t _lv_img_decoder_read_line_split(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                         lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    lv_img_cf_t cf = dsc->header.cf;
+    bool alpha_only = cf >= LV_IMG_CF_ALPHA_1BIT && cf <= LV_IMG_CF_ALPHA_8BIT;
+
+    if(dsc->decoder->read_line_cb == lv_img_decoder_built_in_read_line) {
+        if(alpha_only) {
+            return lv_img_decoder_built_in_line_alpha_split(dsc, x, y, len, opa_buf);
+        }
+        else if(cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT) {
+            return lv_img_decoder_built_in_line_indexed_split(dsc, x, y, len, color_buf, opa_buf);
+        }
+        else if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+            /*The pixels can be read as they are*/
+            lv_res_t res = lv_img_decoder_read_line(dsc, x, y, len, (uint8_t *)color_buf);
+            if(res != LV_RES_OK) return res;
+
+            if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) _lv_img_buf_chroma_key_row(color_buf, len, opa_buf);
+            else _lv_memset_ff(opa_buf, len);
+            return LV_RES_OK;
+        }
+    }
+
+    uint8_t * buf = _lv_mem_buf_get(len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    if(buf == NULL) return LV_RES_INV;
+
+    lv_res_t res = lv_img_decoder_read_line(dsc, x, y, len, buf);
+    if(res != LV_RES_OK) {
+        _lv_mem_buf_release(buf);
+        return res;
+    }
+
+    bool alpha_byte = lv_img_cf_has_alpha(cf);
+    uint32_t px_size = alpha_byte ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    lv_coord_t i;
+    if(alpha_only == false) {
+        for(i = 0; i < len; i++) {
+            _lv_memcpy_small(&color_buf[i], &buf[i * px_size], sizeof(lv_color_t));
+#if LV_COLOR_DEPTH == 32
+            color_buf[i].ch.alpha = 0xFF;
+#endif
+        }
+    }
+
+    if(alpha_byte) {
+        for(i = 0; i < len; i++) opa_buf[i] = buf[i * px_size + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+    }
+    else if(lv_img_cf_is_chroma_keyed(cf)) {
+        _lv_img_buf_chroma_key_row(color_buf, len, opa_buf);
+    }
+    else {
+        _lv_memset_ff(opa_buf, len);
+    }
+
+    _lv_mem_buf_release(buf);
+    return LV_RES_OK;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -570,13 +661,16 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf)
 {
 #if LV_IMG_CF_ALPHA
-    const lv_opa_t alpha1_opa_table[2]  = {0, 255};          /*Opacity mapping with bpp = 1 (Just for compatibility)*/
-    const lv_opa_t alpha2_opa_table[4]  = {0, 85, 170, 255}; /*Opacity mapping with bpp = 2*/
-    const lv_opa_t alpha4_opa_table[16] = {0,  17, 34,  51,  /*Opacity mapping with bpp = 4*/
-                                           68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255
-                                          };
+    lv_opa_t * opa_buf = _lv_mem_buf_get(len);
+    if(opa_buf == NULL) return LV_RES_INV;
 
-    /*Simply fill the buffer with the color. Later only the alpha value will be modified.*/
+    lv_res_t res = lv_img_decoder_built_in_line_alpha_split(dsc, x, y, len, opa_buf);
+    if(res != LV_RES_OK) {
+        _lv_mem_buf_release(opa_buf);
+        return res;
+    }
+
+    /*Interleave the same color with the opacities*/
     lv_color_t bg_color = dsc->color;
     lv_coord_t i;
     for(i = 0; i < len; i++) {
@@ -591,176 +685,156 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
 #else
 #error "Invalid LV_COLOR_DEPTH. Check it in lv_conf.h"
 #endif
+        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa_buf[i];
     }
 
-    const lv_opa_t * opa_table = NULL;
-    uint8_t px_size            = lv_img_cf_get_px_size(dsc->header.cf);
-    uint16_t mask              = (1 << px_size) - 1; /*E.g. px_size = 2; mask = 0x03*/
-
-    lv_coord_t w = 0;
-    uint32_t ofs = 0;
-    int8_t pos   = 0;
-    switch(dsc->header.cf) {
-        case LV_IMG_CF_ALPHA_1BIT:
-            w = (dsc->header.w + 7) >> 3; /*E.g. w = 20 -> w = 2 + 1*/
-            ofs += w * y + (x >> 3); /*First pixel*/
-            pos = 7 - (x & 0x7);
-            opa_table = alpha1_opa_table;
-            break;
-        case LV_IMG_CF_ALPHA_2BIT:
-            w = (dsc->header.w + 3) >> 2; /*E.g. w = 13 -> w = 3 + 1 (bytes)*/
-            ofs += w * y + (x >> 2); /*First pixel*/
-            pos = 6 - (x & 0x3) * 2;
-            opa_table = alpha2_opa_table;
-            break;
-        case LV_IMG_CF_ALPHA_4BIT:
-            w = (dsc->header.w + 1) >> 1; /*E.g. w = 13 -> w = 6 + 1 (bytes)*/
-            ofs += w * y + (x >> 1); /*First pixel*/
-            pos = 4 - (x & 0x1) * 4;
-            opa_table = alpha4_opa_table;
-            break;
-        case LV_IMG_CF_ALPHA_8BIT:
-            w = dsc->header.w; /*E.g. x = 7 -> w = 7 (bytes)*/
-            ofs += w * y + x;  /*First pixel*/
-            pos = 0;
-            break;
-    }
-
-#if LV_USE_FILESYSTEM
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
+    _lv_mem_buf_release(opa_buf);
+    return LV_RES_OK;
+#else
+    LV_LOG_WARN("Image built-in alpha line reader failed because LV_IMG_CF_ALPHA is 0 in lv_conf.h");
+    return LV_RES_INV;
 #endif
+}
 
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
+static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                     lv_coord_t len, uint8_t * buf)
+{
+#if LV_IMG_CF_INDEXED
+    lv_color_t * color_buf = _lv_mem_buf_get(len * sizeof(lv_color_t));
+    lv_opa_t * opa_buf = _lv_mem_buf_get(len);
+    lv_res_t res = LV_RES_INV;
+    if(color_buf && opa_buf) res = lv_img_decoder_built_in_line_indexed_split(dsc, x, y, len, color_buf, opa_buf);
 
-        data_tmp = img_dsc->data + ofs;
-    }
-    else {
-#if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+    if(res == LV_RES_OK) {
+        lv_coord_t i;
+        for(i = 0; i < len; i++) {
+            lv_color_t color = color_buf[i];
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+            buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full;
+#elif LV_COLOR_DEPTH == 16
+            /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
+            buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full & 0xFF;
+            buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 1] = (color.full >> 8) & 0xFF;
+#elif LV_COLOR_DEPTH == 32
+            *((uint32_t *)&buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE]) = color.full;
 #else
-        LV_LOG_WARN("Image built-in alpha line reader can't read file because LV_USE_FILESYSTEM = 0");
-        data_tmp = NULL; /*To avoid warnings*/
-        return LV_RES_INV;
+#error "Invalid LV_COLOR_DEPTH. Check it in lv_conf.h"
 #endif
-    }
-
-    for(i = 0; i < len; i++) {
-        uint8_t val_act = (*data_tmp >> pos) & mask;
-
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] =
-            dsc->header.cf == LV_IMG_CF_ALPHA_8BIT ? val_act : opa_table[val_act];
-
-        pos -= px_size;
-        if(pos < 0) {
-            pos = 8 - px_size;
-            data_tmp++;
+            buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa_buf[i];
         }
     }
-#if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
-#endif
-    return LV_RES_OK;
+
+    if(opa_buf) _lv_mem_buf_release(opa_buf);
+    if(color_buf) _lv_mem_buf_release(color_buf);
+    return res;
 #else
-    LV_LOG_WARN("Image built-in alpha line reader failed because LV_IMG_CF_ALPHA is 0 in lv_conf.h");
+    LV_LOG_WARN("Image built-in indexed line reader failed because LV_IMG_CF_INDEXED is 0 in lv_conf.h");
     return LV_RES_INV;
 #endif
 }
 
-static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
-                                                     lv_coord_t len, uint8_t * buf)
+#if LV_IMG_CF_ALPHA || LV_IMG_CF_INDEXED
+/**
+ * Get the packed pixels of a line of an alpha or indexed image.
+ * @param dsc pointer to decoder descriptor
+ * @param x start x coordinate
+ * @param y start y coordinate
+ * @param len number of pixels
+ * @param fs_buf a buffer with at least as many bytes as a line of the image to read the files into
+ * @param px_ofs store the index of the first pixel in its byte here
+ * @return pointer to the byte of the first pixel or NULL on error
+ */
+static const uint8_t * lv_img_decoder_built_in_line_bits(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                         lv_coord_t len, uint8_t * fs_buf, uint8_t * px_ofs)
 {
-#if LV_IMG_CF_INDEXED
-    uint8_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
-    uint16_t mask   = (1 << px_size) - 1; /*E.g. px_size = 2; mask = 0x03*/
-
-    lv_coord_t w = 0;
-    int8_t pos   = 0;
-    uint32_t ofs = 0;
-    switch(dsc->header.cf) {
-        case LV_IMG_CF_INDEXED_1BIT:
-            w = (dsc->header.w + 7) >> 3; /*E.g. w = 20 -> w = 2 + 1*/
-            ofs += w * y + (x >> 3); /*First pixel*/
-            ofs += 8;                /*Skip the palette*/
-            pos = 7 - (x & 0x7);
-            break;
-        case LV_IMG_CF_INDEXED_2BIT:
-            w = (dsc->header.w + 3) >> 2; /*E.g. w = 13 -> w = 3 + 1 (bytes)*/
-            ofs += w * y + (x >> 2); /*First pixel*/
-            ofs += 16;               /*Skip the palette*/
-            pos = 6 - (x & 0x3) * 2;
-            break;
-        case LV_IMG_CF_INDEXED_4BIT:
-            w = (dsc->header.w + 1) >> 1; /*E.g. w = 13 -> w = 6 + 1 (bytes)*/
-            ofs += w * y + (x >> 1); /*First pixel*/
-            ofs += 64;               /*Skip the palette*/
-            pos = 4 - (x & 0x1) * 4;
-            break;
-        case LV_IMG_CF_INDEXED_8BIT:
-            w = dsc->header.w; /*E.g. x = 7 -> w = 7 (bytes)*/
-            ofs += w * y + x;  /*First pixel*/
-            ofs += 1024;       /*Skip the palette*/
-            pos = 0;
-            break;
+    lv_img_cf_t cf = dsc->header.cf;
+    uint32_t px_size = lv_img_cf_get_px_size(cf);
+    uint32_t stride = (dsc->header.w * px_size + 7) >> 3;   /*E.g. w = 20, 1 bit per pixel -> 3 bytes*/
+    uint32_t ofs = stride * y + ((x * px_size) >> 3);       /*First pixel*/
+    if(cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT) {
+        ofs += (1 << px_size) * sizeof(lv_color32_t);       /*Skip the palette*/
     }
 
-    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    *px_ofs = x & ((8 / px_size) - 1);
 
-#if LV_USE_FILESYSTEM
-    uint8_t * fs_buf = _lv_mem_buf_get(w);
-    if(fs_buf == NULL) return LV_RES_INV;
-#endif
-    const uint8_t * data_tmp = NULL;
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         const lv_img_dsc_t * img_dsc = dsc->src;
-        data_tmp                     = img_dsc->data + ofs;
+        return img_dsc->data + ofs;
     }
-    else {
+
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(&user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    uint32_t btr = ((*px_ofs + len) * px_size + 7) >> 3;
+    lv_fs_seek(&user_data->f, ofs + 4); /*+4 to skip the header*/
+    if(lv_fs_read(&user_data->f, fs_buf, btr, NULL) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Built-in image decoder read failed");
+        return NULL;
+    }
+    return fs_buf;
 #else
-        LV_LOG_WARN("Image built-in indexed line reader can't read file because LV_USE_FILESYSTEM = 0");
-        data_tmp = NULL; /*To avoid warnings*/
-        return LV_RES_INV;
+    LV_UNUSED(len);
+    LV_UNUSED(fs_buf);
+    LV_LOG_WARN("Image built-in line reader can't read file because LV_USE_FILESYSTEM = 0");
+    return NULL;
+#endif
+}
 #endif
+
+static lv_res_t lv_img_decoder_built_in_line_alpha_split(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                         lv_coord_t len, lv_opa_t * opa_buf)
+{
+#if LV_IMG_CF_ALPHA
+    uint8_t * fs_buf = NULL;
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        fs_buf = _lv_mem_buf_get(dsc->header.w);
+        if(fs_buf == NULL) return LV_RES_INV;
     }
 
-    lv_coord_t i;
-    for(i = 0; i < len; i++) {
-        uint8_t val_act = (*data_tmp >> pos) & mask;
+    uint8_t px_ofs;
+    const uint8_t * data = lv_img_decoder_built_in_line_bits(dsc, x, y, len, fs_buf, &px_ofs);
+    if(data) _lv_img_buf_unpack_alpha_row(data, dsc->header.cf, px_ofs, len, opa_buf);
 
-        lv_color_t color = user_data->palette[val_act];
-#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full;
-#elif LV_COLOR_DEPTH == 16
-        /*Because of Alpha byte 16 bit color can start on odd address which can cause crash*/
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full & 0xFF;
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 1] = (color.full >> 8) & 0xFF;
-#elif LV_COLOR_DEPTH == 32
-        *((uint32_t *)&buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE]) = color.full;
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
+    return data ? LV_RES_OK : LV_RES_INV;
 #else
-#error "Invalid LV_COLOR_DEPTH. Check it in lv_conf.h"
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+    LV_UNUSED(len);
+    LV_UNUSED(opa_buf);
+    LV_LOG_WARN("Image built-in alpha line reader failed because LV_IMG_CF_ALPHA is 0 in lv_conf.h");
+    return LV_RES_INV;
 #endif
-        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = user_data->opa[val_act];
+}
 
-        pos -= px_size;
-        if(pos < 0) {
-            pos = 8 - px_size;
-            data_tmp++;
-        }
+static lv_res_t lv_img_decoder_built_in_line_indexed_split(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                           lv_coord_t len, lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+#if LV_IMG_CF_INDEXED
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+
+    uint8_t * fs_buf = NULL;
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        fs_buf = _lv_mem_buf_get(dsc->header.w);
+        if(fs_buf == NULL) return LV_RES_INV;
     }
-#if LV_USE_FILESYSTEM
-    _lv_mem_buf_release(fs_buf);
-#endif
-    return LV_RES_OK;
+
+    uint8_t px_ofs;
+    const uint8_t * data = lv_img_decoder_built_in_line_bits(dsc, x, y, len, fs_buf, &px_ofs);
+    if(data) {
+        _lv_img_buf_unpack_indexed_row(data, dsc->header.cf, px_ofs, len, user_data->palette, user_data->opa,
+                                       color_buf, opa_buf);
+    }
+
+    if(fs_buf) _lv_mem_buf_release(fs_buf);
+    return data ? LV_RES_OK : LV_RES_INV;
 #else
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+    LV_UNUSED(len);
+    LV_UNUSED(color_buf);
+    LV_UNUSED(opa_buf);
     LV_LOG_WARN("Image built-in indexed line reader failed because LV_IMG_CF_INDEXED is 0 in lv_conf.h");
     return LV_RES_INV;
 #endif
@@ -120,6 +120,10 @@ typedef struct _lv_img_decoder_dsc {
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
 
+    /** RAM allocated by the decoder for the opened image [bytes].
+     *  `lv_img_cache` uses it to limit the RAM of the cached images. If not set it's estimated from the header*/
+    uint32_t mem_size;
+
     /**A text to display instead of the image when the image can't be opened.
      * Can be set in `open` function or set NULL. */
     const char * error_msg;
@@ -175,6 +179,22 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Read a line from an opened image into separate color and opacity buffers which are ready to blend.
+ * The built-in alpha, indexed and chroma keyed formats are unpacked directly into the buffers.
+ * The lines of other decoders are read with `read_line` and split.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param x start X coordinate (from left)
+ * @param y start Y coordinate (from top)
+ * @param len number of pixels to read
+ * @param color_buf store the colors here (`len` elements).
+ *                  Not written with `LV_IMG_CF_ALPHA_...` formats as their color is always `dsc->color`.
+ * @param opa_buf store the opacities here (`len` elements)
+ * @return LV_RES_OK: success; LV_RES_INV: an error occurred
+ */
+lv_res_t _lv_img_decoder_read_line_split(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                                         lv_color_t * color_buf, lv_opa_t * opa_buf);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
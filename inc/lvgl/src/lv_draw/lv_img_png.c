@@ -0,0 +1,1216 @@
+/**
+ * @file lv_img_png.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_png.h"
+
+#if LV_USE_PNG
+
+#include "lv_img_cache.h"
+#include "lv_draw_img.h"
+#include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_mem.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Size of the buffer used to read the compressed data from files*/
+#define PNG_IN_BUF_SIZE     512
+
+/*Number of bits resolved at once by the Huffman decoder. Longer codes are decoded bit by bit*/
+#define PNG_FAST_BITS       9
+
+#define PNG_CTYPE_GRAY      0
+#define PNG_CTYPE_RGB       2
+#define PNG_CTYPE_PALETTE   3
+#define PNG_CTYPE_GRAY_A    4
+#define PNG_CTYPE_RGBA      6
+
+/*Largest image `lv_img_header_t` can describe*/
+#define PNG_MAX_SIZE        2047
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*Canonical Huffman code*/
+typedef struct {
+    uint16_t fast[1 << PNG_FAST_BITS];  /*(symbol << 4) | code length for the codes not longer than `PNG_FAST_BITS`*/
+    uint16_t count[16];                 /*Number of codes with a given length*/
+    uint16_t symbol[288];               /*The symbols ordered by their codes*/
+} png_huff_t;
+
+typedef enum {
+    PNG_INFLATE_BLOCK,      /*Read the header of the next block*/
+    PNG_INFLATE_STORED,     /*In an uncompressed block*/
+    PNG_INFLATE_HUFF,       /*In a compressed block*/
+    PNG_INFLATE_END,        /*The last block is finished*/
+} png_inflate_mode_t;
+
+typedef struct {
+    /*The source*/
+#if LV_USE_FILESYSTEM
+    lv_fs_file_t f;
+#endif
+    const uint8_t * data;   /*The PNG file if the source is a variable. NULL: the source is a file*/
+    uint32_t data_size;
+    uint32_t pos;           /*Read position in `data`*/
+
+    /*The header*/
+    uint32_t w;
+    uint32_t h;
+    uint8_t depth;
+    uint8_t ctype;
+    uint8_t interlace;
+    uint8_t has_trns;
+    uint16_t trns_key[3];   /*Transparent gray or RGB sample with `PNG_CTYPE_GRAY` and `PNG_CTYPE_RGB`*/
+    lv_color_t * palette;
+    lv_opa_t * palette_opa;
+    uint32_t idat_pos;      /*Position of the first IDAT chunk's header*/
+
+    /*The compressed stream*/
+    uint8_t in_buf[PNG_IN_BUF_SIZE];
+    const uint8_t * in_p;
+    const uint8_t * in_end;
+    uint32_t chunk_left;    /*Bytes not read yet from the current IDAT chunk*/
+    uint8_t in_over;        /*Number of bytes read after the last IDAT chunk (zeros)*/
+    uint8_t idat_end;       /*1: there are no more IDAT chunks*/
+
+    /*The inflate state*/
+    png_inflate_mode_t mode;
+    uint8_t final;
+    uint32_t bit_buf;
+    uint8_t bit_cnt;
+    uint16_t stored_left;
+    uint16_t match_len;
+    uint16_t match_dist;
+    uint8_t * window;
+    uint32_t window_mask;
+    uint32_t window_pos;
+    uint8_t cmf;            /*First byte of the zlib header. Tells the window size*/
+    png_huff_t lit;
+    png_huff_t dist;
+
+    /*The rows*/
+    uint8_t * row_prev;
+    uint8_t * row_cur;
+    uint32_t row_bytes;     /*Bytes of a row without the filter byte*/
+    uint8_t filter_bpp;     /*Bytes of a pixel for the filters (at least 1)*/
+    uint32_t next_y;        /*Index of the next row to inflate. `row_cur` contains `next_y - 1`*/
+} png_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static png_dsc_t * png_src_open(const void * src);
+static void png_src_close(png_dsc_t * png);
+static bool png_src_read(png_dsc_t * png, void * buf, uint32_t len);
+static bool png_src_seek(png_dsc_t * png, uint32_t pos);
+static bool png_parse(png_dsc_t * png, bool load);
+static bool png_has_alpha(const png_dsc_t * png);
+static uint32_t png_px_bits(const png_dsc_t * png);
+static uint32_t png_window_size(const png_dsc_t * png);
+static bool png_restart(png_dsc_t * png);
+static bool png_read_row(png_dsc_t * png, uint8_t * row, uint32_t row_bytes);
+static void png_convert_row(const png_dsc_t * png, const uint8_t * row, uint32_t x, uint32_t len, uint8_t * buf);
+static bool png_decode_full(png_dsc_t * png, uint8_t * img);
+static uint32_t png_in_refill(png_dsc_t * png);
+static inline uint32_t png_bits(png_dsc_t * png, uint32_t n);
+static inline int32_t png_huff_decode(png_dsc_t * png, const png_huff_t * h);
+static bool png_inflate(png_dsc_t * png, uint8_t * out, uint32_t len);
+static bool png_inflate_tables(png_dsc_t * png);
+static void png_huff_build(png_huff_t * h, const uint8_t * lens, uint32_t num);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint8_t png_signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+static const uint16_t len_base[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+                                     };
+static const uint8_t len_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+                                     };
+static const uint16_t dist_base[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                       257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+                                      };
+static const uint8_t dist_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                       7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+                                      };
+static const uint8_t clen_order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+/**********************
+ *      MACROS
+ **********************/
+#define PNG_BE32(p) (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | ((uint32_t)(p)[2] << 8) | (p)[3])
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register the PNG decoder.
+ * It opens "*.png" files and `lv_img_dsc_t` variables with `LV_IMG_CF_RAW...` color format whose data is a PNG file.
+ * The rows are decoded when they are drawn, keeping only the inflate state and two rows in the RAM.
+ * If the image cache's RAM budget allows the whole image is decoded when it's opened.
+ */
+void _lv_img_png_init(void)
+{
+    lv_img_decoder_t * decoder = lv_img_decoder_create();
+    LV_ASSERT_MEM(decoder);
+    if(decoder == NULL) {
+        LV_LOG_WARN("_lv_img_png_init: out of memory");
+        return;
+    }
+
+    lv_img_decoder_set_info_cb(decoder, lv_img_png_info);
+    lv_img_decoder_set_open_cb(decoder, lv_img_png_open);
+    lv_img_decoder_set_read_line_cb(decoder, lv_img_png_read_line);
+    lv_img_decoder_set_close_cb(decoder, lv_img_png_close);
+}
+
+/**
+ * Get info about a PNG image
+ * @param decoder the decoder where this function belongs
+ * @param src can be file name or pointer to a C array
+ * @param header store the info here
+ * @return LV_RES_OK: no error; LV_RES_INV: can't get the info
+ */
+lv_res_t lv_img_png_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+
+    png_dsc_t * png = png_src_open(src);
+    if(png == NULL) return LV_RES_INV;
+
+    lv_res_t res = LV_RES_INV;
+    if(png_parse(png, false)) {
+        header->always_zero = 0;
+        header->w = png->w;
+        header->h = png->h;
+        header->cf = png_has_alpha(png) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+        res = LV_RES_OK;
+    }
+
+    png_src_close(png);
+    lv_mem_free(png);
+    return res;
+}
+
+/**
+ * Open a PNG image
+ * @param decoder the decoder where this function belongs
+ * @param dsc pointer to decoder descriptor. `src`, `color` are already initialized in it.
+ * @return LV_RES_OK: the image is opened; LV_RES_INV: not a PNG image or other error.
+ */
+lv_res_t lv_img_png_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    png_dsc_t * png = png_src_open(dsc->src);
+    if(png == NULL) return LV_RES_INV;
+
+    dsc->user_data = png;
+    if(png_parse(png, true) == false || png_restart(png) == false) {
+        lv_img_png_close(decoder, dsc);
+        return LV_RES_INV;
+    }
+
+    uint32_t px_bits = png_px_bits(png);
+    uint32_t window_size = png_window_size(png);
+    png->filter_bpp = (px_bits + 7) / 8;
+    png->row_bytes = (png->w * px_bits + 7) / 8;
+    png->window = lv_mem_alloc(window_size);
+    png->row_prev = lv_mem_alloc(png->row_bytes);
+    png->row_cur = lv_mem_alloc(png->row_bytes);
+    LV_ASSERT_MEM(png->window);
+    LV_ASSERT_MEM(png->row_prev);
+    LV_ASSERT_MEM(png->row_cur);
+    if(png->window == NULL || png->row_prev == NULL || png->row_cur == NULL) {
+        lv_img_png_close(decoder, dsc);
+        return LV_RES_INV;
+    }
+    png->window_mask = window_size - 1;
+    _lv_memset_00(png->row_cur, png->row_bytes);
+
+    uint8_t px_size = png_has_alpha(png) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t img_size = png->w * png->h * px_size;
+    uint32_t stream_size = sizeof(png_dsc_t) + window_size + png->row_bytes * 2;
+    if(png->palette) stream_size += 256 * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+
+    /*Decode the whole image if the image cache can keep it. Interlaced images can't be decoded row by row*/
+    bool full = png->interlace ? true : false;
+#if LV_IMG_CACHE_DEF_SIZE
+    uint32_t budget = lv_img_cache_get_mem_size();
+    if(budget == 0 || img_size <= budget) full = true;
+#endif
+
+    if(full) {
+        uint8_t * img = lv_mem_alloc(img_size);
+        if(img == NULL || png_decode_full(png, img) == false) {
+            LV_LOG_WARN("PNG decoder: can't decode the image");
+            if(img) lv_mem_free(img);
+            lv_img_png_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+
+        /*Only the decoded image is kept*/
+        lv_img_png_close(decoder, dsc);
+        dsc->img_data = img;
+        dsc->mem_size = img_size;
+        return LV_RES_OK;
+    }
+
+    dsc->img_data = NULL;
+    dsc->mem_size = stream_size;
+    return LV_RES_OK;
+}
+
+/**
+ * Decode `len` pixels starting from the given `x`, `y` coordinates and store them in `buf`.
+ * The rows are inflated in order. Reading an earlier row restarts the inflating from the first row.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param x start x coordinate
+ * @param y start y coordinate
+ * @param len number of pixels to decode
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_png_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
+                              lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+
+    png_dsc_t * png = dsc->user_data;
+    if(png == NULL || png->window == NULL) return LV_RES_INV;
+    if(y < 0 || (uint32_t)y >= png->h || x < 0 || (uint32_t)(x + len) > png->w) return LV_RES_INV;
+
+    /*Only the last row is kept. Start again for earlier rows*/
+    if((uint32_t)y + 1 < png->next_y) {
+        if(png_restart(png) == false) return LV_RES_INV;
+    }
+
+    while(png->next_y <= (uint32_t)y) {
+        uint8_t * tmp = png->row_prev;
+        png->row_prev = png->row_cur;
+        png->row_cur = tmp;
+        if(png_read_row(png, png->row_cur, png->row_bytes) == false) {
+            LV_LOG_WARN("PNG decoder: corrupted image data");
+            png->next_y = UINT32_MAX;   /*Restart on the next read*/
+            return LV_RES_INV;
+        }
+        png->next_y++;
+    }
+
+    png_convert_row(png, png->row_cur, x, len, buf);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Close the pending decoding. Free resources etc.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ */
+void lv_img_png_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    png_dsc_t * png = dsc->user_data;
+    if(png) {
+        png_src_close(png);
+        if(png->palette) lv_mem_free(png->palette);
+        if(png->window) lv_mem_free(png->window);
+        if(png->row_prev) lv_mem_free(png->row_prev);
+        if(png->row_cur) lv_mem_free(png->row_cur);
+        lv_mem_free(png);
+        dsc->user_data = NULL;
+    }
+    else if(dsc->img_data) {
+        lv_mem_free((void *)dsc->img_data);
+        dsc->img_data = NULL;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open the file or take the data of a PNG image source.
+ * The decoder's data is allocated only if the source starts with the PNG signature.
+ * @param src a file name or pointer to an `lv_img_dsc_t` variable
+ * @return the decoder's data with the source read after the signature or NULL if it's not a PNG image
+ */
+static png_dsc_t * png_src_open(const void * src)
+{
+    const lv_img_dsc_t * img_dsc = NULL;
+#if LV_USE_FILESYSTEM
+    lv_fs_file_t f;
+#endif
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_VARIABLE) {
+        img_dsc = src;
+        lv_img_cf_t cf = img_dsc->header.cf;
+        if(cf != LV_IMG_CF_RAW && cf != LV_IMG_CF_RAW_ALPHA && cf != LV_IMG_CF_RAW_CHROMA_KEYED) return NULL;
+        if(img_dsc->data == NULL || img_dsc->data_size < sizeof(png_signature)) return NULL;
+        if(memcmp(img_dsc->data, png_signature, sizeof(png_signature))) return NULL;
+    }
+#if LV_USE_FILESYSTEM
+    else if(src_type == LV_IMG_SRC_FILE) {
+        const char * ext = lv_fs_get_ext(src);
+        if(strcmp(ext, "png") && strcmp(ext, "PNG")) return NULL;
+        if(lv_fs_open(&f, src, LV_FS_MODE_RD) != LV_FS_RES_OK) return NULL;
+
+        uint8_t sig[sizeof(png_signature)];
+        uint32_t rn;
+        if(lv_fs_read(&f, sig, sizeof(sig), &rn) != LV_FS_RES_OK || rn != sizeof(sig) ||
+           memcmp(sig, png_signature, sizeof(png_signature))) {
+            lv_fs_close(&f);
+            return NULL;
+        }
+    }
+#endif
+    else {
+        return NULL;
+    }
+
+    png_dsc_t * png = lv_mem_alloc(sizeof(png_dsc_t));
+    LV_ASSERT_MEM(png);
+    if(png == NULL) {
+#if LV_USE_FILESYSTEM
+        if(img_dsc == NULL) lv_fs_close(&f);
+#endif
+        return NULL;
+    }
+
+    _lv_memset_00(png, sizeof(png_dsc_t));
+    if(img_dsc) {
+        png->data = img_dsc->data;
+        png->data_size = img_dsc->data_size;
+        png->pos = sizeof(png_signature);
+    }
+#if LV_USE_FILESYSTEM
+    else {
+        png->f = f;
+    }
+#endif
+
+    return png;
+}
+
+/**
+ * Close the file of a PNG image source
+ * @param png the decoder's data
+ */
+static void png_src_close(png_dsc_t * png)
+{
+#if LV_USE_FILESYSTEM
+    if(png->data == NULL && png->f.file_d) {
+        lv_fs_close(&png->f);
+        png->f.file_d = NULL;
+    }
+#else
+    LV_UNUSED(png);
+#endif
+}
+
+/**
+ * Read from the current position of a PNG image source
+ * @param png the decoder's data
+ * @param buf store the data here
+ * @param len number of bytes to read
+ * @return true: `len` bytes are read
+ */
+static bool png_src_read(png_dsc_t * png, void * buf, uint32_t len)
+{
+    if(png->data) {
+        if(png->pos + len > png->data_size) return false;
+        _lv_memcpy(buf, &png->data[png->pos], len);
+        png->pos += len;
+        return true;
+    }
+
+#if LV_USE_FILESYSTEM
+    uint32_t rn;
+    if(len == 0) return true;
+    if(lv_fs_read(&png->f, buf, len, &rn) != LV_FS_RES_OK || rn != len) return false;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Set the read position of a PNG image source
+ * @param png the decoder's data
+ * @param pos the new position
+ * @return true: success
+ */
+static bool png_src_seek(png_dsc_t * png, uint32_t pos)
+{
+    if(png->data) {
+        if(pos > png->data_size) return false;
+        png->pos = pos;
+        return true;
+    }
+
+#if LV_USE_FILESYSTEM
+    return lv_fs_seek(&png->f, pos) == LV_FS_RES_OK;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Read the header and the chunks before the image data
+ * @param png the decoder's data with a source opened by `png_src_open`
+ * @param load true: load the palette and the transparency too; false: only check whether they exist
+ * @return true: it's a supported PNG image
+ */
+static bool png_parse(png_dsc_t * png, bool load)
+{
+    /*The signature is already checked by `png_src_open`*/
+    uint8_t hdr[8 + 13 + 4];
+    if(png_src_read(png, hdr, sizeof(hdr)) == false) return false;
+    if(PNG_BE32(&hdr[0]) != 13 || memcmp(&hdr[4], "IHDR", 4)) return false;
+
+    png->w = PNG_BE32(&hdr[8]);
+    png->h = PNG_BE32(&hdr[12]);
+    png->depth = hdr[16];
+    png->ctype = hdr[17];
+    png->interlace = hdr[20];
+
+    if(png->w == 0 || png->h == 0 || png->w > PNG_MAX_SIZE || png->h > PNG_MAX_SIZE) {
+        LV_LOG_WARN("PNG decoder: the image is too large");
+        return false;
+    }
+    if(hdr[18] != 0 || hdr[19] != 0 || png->interlace > 1) return false;
+
+    uint8_t d = png->depth;
+    switch(png->ctype) {
+        case PNG_CTYPE_GRAY:
+            if(d != 1 && d != 2 && d != 4 && d != 8 && d != 16) return false;
+            break;
+        case PNG_CTYPE_PALETTE:
+            if(d != 1 && d != 2 && d != 4 && d != 8) return false;
+            break;
+        case PNG_CTYPE_RGB:
+        case PNG_CTYPE_GRAY_A:
+        case PNG_CTYPE_RGBA:
+            if(d != 8 && d != 16) return false;
+            break;
+        default:
+            return false;
+    }
+
+    /*Walk the chunks until the image data*/
+    uint32_t pos = sizeof(png_signature) + sizeof(hdr);
+    while(1) {
+        uint8_t chunk[8];
+        if(png_src_read(png, chunk, sizeof(chunk)) == false) return false;
+        uint32_t chunk_len = PNG_BE32(chunk);
+
+        if(memcmp(&chunk[4], "IDAT", 4) == 0) {
+            png->idat_pos = pos;
+            break;
+        }
+        else if(memcmp(&chunk[4], "IEND", 4) == 0) {
+            return false;
+        }
+        else if(memcmp(&chunk[4], "tRNS", 4) == 0) {
+            png->has_trns = 1;
+            if(load) {
+                uint8_t trns[256];
+                if(chunk_len > sizeof(trns) || png_src_read(png, trns, chunk_len) == false) return false;
+                if(png->ctype == PNG_CTYPE_PALETTE && png->palette) {
+                    uint32_t i;
+                    for(i = 0; i < chunk_len; i++) png->palette_opa[i] = trns[i];
+                }
+                else if(png->ctype == PNG_CTYPE_GRAY && chunk_len >= 2) {
+                    png->trns_key[0] = (trns[0] << 8) | trns[1];
+                }
+                else if(png->ctype == PNG_CTYPE_RGB && chunk_len >= 6) {
+                    png->trns_key[0] = (trns[0] << 8) | trns[1];
+                    png->trns_key[1] = (trns[2] << 8) | trns[3];
+                    png->trns_key[2] = (trns[4] << 8) | trns[5];
+                }
+                else {
+                    png->has_trns = 0;
+                }
+                chunk_len = 0;
+            }
+        }
+        else if(memcmp(&chunk[4], "PLTE", 4) == 0 && png->ctype == PNG_CTYPE_PALETTE && load) {
+            uint8_t plte[256 * 3];
+            if(chunk_len > sizeof(plte) || chunk_len % 3 || png_src_read(png, plte, chunk_len) == false) return false;
+
+            png->palette = lv_mem_alloc(256 * (sizeof(lv_color_t) + sizeof(lv_opa_t)));
+            LV_ASSERT_MEM(png->palette);
+            if(png->palette == NULL) return false;
+            png->palette_opa = (lv_opa_t *)&png->palette[256];
+            _lv_memset_00(png->palette, 256 * sizeof(lv_color_t));
+            _lv_memset_ff(png->palette_opa, 256);
+
+            uint32_t i;
+            for(i = 0; i < chunk_len / 3; i++) {
+                png->palette[i] = lv_color_make(plte[i * 3], plte[i * 3 + 1], plte[i * 3 + 2]);
+            }
+            chunk_len = 0;
+        }
+
+        /*Skip the (rest of the) data and the CRC*/
+        pos += 8 + PNG_BE32(chunk) + 4;
+        if(chunk_len && png_src_seek(png, pos) == false) return false;
+        if(chunk_len == 0) {
+            uint8_t crc[4];
+            if(png_src_read(png, crc, 4) == false) return false;
+        }
+    }
+
+    if(png->ctype == PNG_CTYPE_PALETTE && load && png->palette == NULL) return false;
+
+    return true;
+}
+
+/**
+ * Tell whether the decoded pixels have alpha
+ * @param png the decoder's data
+ * @return true: the image has an alpha channel or a transparent color
+ */
+static bool png_has_alpha(const png_dsc_t * png)
+{
+    return png->ctype == PNG_CTYPE_GRAY_A || png->ctype == PNG_CTYPE_RGBA || png->has_trns;
+}
+
+/**
+ * Get the number of bits of a pixel in the image data
+ * @param png the decoder's data
+ * @return bits per pixel
+ */
+static uint32_t png_px_bits(const png_dsc_t * png)
+{
+    switch(png->ctype) {
+        case PNG_CTYPE_RGB:
+            return png->depth * 3;
+        case PNG_CTYPE_GRAY_A:
+            return png->depth * 2;
+        case PNG_CTYPE_RGBA:
+            return png->depth * 4;
+        default:
+            return png->depth;
+    }
+}
+
+/**
+ * Get the size of the inflate window. It's the window of the zlib header
+ * but not larger than the whole inflated image data because a match can't reach further back.
+ * @param png the decoder's data after `png_restart`
+ * @return the window size (power of 2)
+ */
+static uint32_t png_window_size(const png_dsc_t * png)
+{
+    uint32_t size = (uint32_t)1 << ((png->cmf >> 4) + 8);
+    if(size > 32768) size = 32768;
+
+    uint32_t raw_size = ((png->w * png_px_bits(png) + 7) / 8 + 1) * png->h;
+    if(png->interlace) raw_size += png->h * 7;    /*The filter bytes of the passes*/
+
+    while(size > 256 && size / 2 >= raw_size) size /= 2;
+
+    return size;
+}
+
+/**
+ * Go back to the start of the image data and reset the inflate state
+ * @param png the decoder's data
+ * @return true: success
+ */
+static bool png_restart(png_dsc_t * png)
+{
+    uint8_t chunk[8];
+    if(png_src_seek(png, png->idat_pos) == false) return false;
+    if(png_src_read(png, chunk, sizeof(chunk)) == false) return false;
+
+    png->chunk_left = PNG_BE32(chunk);
+    png->in_p = NULL;
+    png->in_end = NULL;
+    png->in_over = 0;
+    png->idat_end = 0;
+
+    png->mode = PNG_INFLATE_BLOCK;
+    png->final = 0;
+    png->bit_buf = 0;
+    png->bit_cnt = 0;
+    png->match_len = 0;
+    png->window_pos = 0;
+    png->next_y = 0;
+    if(png->row_cur) _lv_memset_00(png->row_cur, png->row_bytes);
+
+    /*Check the zlib header. Only deflate without preset dictionary is allowed in PNG*/
+    uint32_t cmf = png_bits(png, 8);
+    uint32_t flg = png_bits(png, 8);
+    if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || (flg & 0x20) || ((cmf << 8) | flg) % 31) return false;
+    png->cmf = cmf;
+
+    return true;
+}
+
+/**
+ * Inflate and unfilter the next row
+ * @param png the decoder's data
+ * @param row store the row here. The previous row is in `png->row_prev` (zeros for the first row of a pass)
+ * @param row_bytes number of bytes in the row
+ * @return true: success
+ */
+static bool png_read_row(png_dsc_t * png, uint8_t * row, uint32_t row_bytes)
+{
+    const uint8_t * prev = png->row_prev;
+    uint8_t filter;
+    if(png_inflate(png, &filter, 1) == false) return false;
+    if(png_inflate(png, row, row_bytes) == false) return false;
+
+    uint32_t bpp = png->filter_bpp;
+    uint32_t i;
+    switch(filter) {
+        case 0:
+            break;
+        case 1:
+            for(i = bpp; i < row_bytes; i++) row[i] += row[i - bpp];
+            break;
+        case 2:
+            for(i = 0; i < row_bytes; i++) row[i] += prev[i];
+            break;
+        case 3:
+            for(i = 0; i < bpp && i < row_bytes; i++) row[i] += prev[i] >> 1;
+            for(; i < row_bytes; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4:
+            for(i = 0; i < bpp && i < row_bytes; i++) row[i] += prev[i];
+            for(; i < row_bytes; i++) {
+                int32_t a = row[i - bpp];
+                int32_t b = prev[i];
+                int32_t c = prev[i - bpp];
+                int32_t pa = b - c;
+                int32_t pb = a - c;
+                int32_t pc = pa + pb;
+                if(pa < 0) pa = -pa;
+                if(pb < 0) pb = -pb;
+                if(pc < 0) pc = -pc;
+                if(pa <= pb && pa <= pc) row[i] += a;
+                else if(pb <= pc) row[i] += b;
+                else row[i] += c;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Convert the pixels of an unfiltered row to `LV_IMG_CF_TRUE_COLOR(_ALPHA)`
+ * @param png the decoder's data
+ * @param row the unfiltered row
+ * @param x index of the first pixel to convert
+ * @param len number of pixels to convert
+ * @param buf store the pixels here
+ */
+static void png_convert_row(const png_dsc_t * png, const uint8_t * row, uint32_t x, uint32_t len, uint8_t * buf)
+{
+    bool alpha = png_has_alpha(png);
+    uint32_t x_end = x + len;
+    uint32_t i;
+    lv_color_t c;
+    lv_opa_t opa = LV_OPA_COVER;
+
+    /*The common 8 bit RGB(A) images*/
+    if(png->depth == 8 && png->ctype == PNG_CTYPE_RGBA) {
+        const uint8_t * s = &row[x * 4];
+        for(i = x; i < x_end; i++) {
+            c = lv_color_make(s[0], s[1], s[2]);
+#if LV_COLOR_DEPTH == 32
+            c.ch.alpha = s[3];
+            _lv_memcpy_small(buf, &c, sizeof(lv_color_t));
+#else
+            _lv_memcpy_small(buf, &c, sizeof(lv_color_t));
+            buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = s[3];
+#endif
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            s += 4;
+        }
+        return;
+    }
+
+    if(png->depth == 8 && png->ctype == PNG_CTYPE_RGB && !alpha) {
+        const uint8_t * s = &row[x * 3];
+        for(i = x; i < x_end; i++) {
+            c = lv_color_make(s[0], s[1], s[2]);
+            _lv_memcpy_small(buf, &c, sizeof(lv_color_t));
+            buf += sizeof(lv_color_t);
+            s += 3;
+        }
+        return;
+    }
+
+    uint32_t depth = png->depth;
+    uint32_t mask = (1 << depth) - 1;
+    for(i = x; i < x_end; i++) {
+        uint32_t v;
+        switch(png->ctype) {
+            case PNG_CTYPE_GRAY:
+                if(depth == 16) {
+                    v = (row[i * 2] << 8) | row[i * 2 + 1];
+                    c = lv_color_make(row[i * 2], row[i * 2], row[i * 2]);
+                }
+                else {
+                    if(depth == 8) v = row[i];
+                    else v = (row[(i * depth) >> 3] >> (8 - depth - ((i * depth) & 0x7))) & mask;
+                    uint8_t gray = v * (255 / mask);
+                    c = lv_color_make(gray, gray, gray);
+                }
+                opa = png->has_trns && v == png->trns_key[0] ? LV_OPA_TRANSP : LV_OPA_COVER;
+                break;
+            case PNG_CTYPE_PALETTE:
+                if(depth == 8) v = row[i];
+                else v = (row[(i * depth) >> 3] >> (8 - depth - ((i * depth) & 0x7))) & mask;
+                c = png->palette[v];
+                opa = png->palette_opa[v];
+                break;
+            case PNG_CTYPE_RGB:
+                if(depth == 16) {
+                    const uint8_t * s = &row[i * 6];
+                    c = lv_color_make(s[0], s[2], s[4]);
+                    opa = png->has_trns && ((s[0] << 8) | s[1]) == png->trns_key[0] &&
+                          ((s[2] << 8) | s[3]) == png->trns_key[1] &&
+                          ((s[4] << 8) | s[5]) == png->trns_key[2] ? LV_OPA_TRANSP : LV_OPA_COVER;
+                }
+                else {
+                    const uint8_t * s = &row[i * 3];
+                    c = lv_color_make(s[0], s[1], s[2]);
+                    opa = png->has_trns && s[0] == png->trns_key[0] && s[1] == png->trns_key[1] &&
+                          s[2] == png->trns_key[2] ? LV_OPA_TRANSP : LV_OPA_COVER;
+                }
+                break;
+            case PNG_CTYPE_GRAY_A:
+                if(depth == 16) {
+                    c = lv_color_make(row[i * 4], row[i * 4], row[i * 4]);
+                    opa = row[i * 4 + 2];
+                }
+                else {
+                    c = lv_color_make(row[i * 2], row[i * 2], row[i * 2]);
+                    opa = row[i * 2 + 1];
+                }
+                break;
+            default:    /*PNG_CTYPE_RGBA with 16 bit depth*/
+                c = lv_color_make(row[i * 8], row[i * 8 + 2], row[i * 8 + 4]);
+                opa = row[i * 8 + 6];
+                break;
+        }
+
+        if(alpha) {
+#if LV_COLOR_DEPTH == 32
+            c.ch.alpha = opa;
+            _lv_memcpy_small(buf, &c, sizeof(lv_color_t));
+#else
+            _lv_memcpy_small(buf, &c, sizeof(lv_color_t));
+            buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+#endif
+            buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+        else {
+            _lv_memcpy_small(buf, &c, sizeof(lv_color_t));
+            buf += sizeof(lv_color_t);
+        }
+    }
+}
+
+/**
+ * Decode the whole image. Interlaced images are decoded pass by pass.
+ * @param png the decoder's data right after `png_restart`
+ * @param img store the `LV_IMG_CF_TRUE_COLOR(_ALPHA)` pixels here
+ * @return true: success
+ */
+static bool png_decode_full(png_dsc_t * png, uint8_t * img)
+{
+    uint32_t px_size = png_has_alpha(png) ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t y;
+
+    if(png->interlace == 0) {
+        for(y = 0; y < png->h; y++) {
+            uint8_t * tmp = png->row_prev;
+            png->row_prev = png->row_cur;
+            png->row_cur = tmp;
+            if(png_read_row(png, png->row_cur, png->row_bytes) == false) return false;
+            png_convert_row(png, png->row_cur, 0, png->w, &img[y * png->w * px_size]);
+        }
+        png->next_y = png->h;
+        return true;
+    }
+
+    /*Adam7*/
+    static const uint8_t start_x[7] = {0, 4, 0, 2, 0, 1, 0};
+    static const uint8_t start_y[7] = {0, 0, 4, 0, 2, 0, 1};
+    static const uint8_t step_x[7] = {8, 8, 4, 4, 2, 2, 1};
+    static const uint8_t step_y[7] = {8, 8, 8, 4, 4, 2, 2};
+
+    uint8_t * pass_buf = _lv_mem_buf_get(png->w * px_size);
+    if(pass_buf == NULL) return false;
+
+    bool res = true;
+    uint32_t p;
+    for(p = 0; p < 7 && res; p++) {
+        if(png->w <= start_x[p] || png->h <= start_y[p]) continue;
+        uint32_t pass_w = (png->w - start_x[p] + step_x[p] - 1) / step_x[p];
+        uint32_t pass_h = (png->h - start_y[p] + step_y[p] - 1) / step_y[p];
+        uint32_t pass_bytes = (pass_w * png_px_bits(png) + 7) / 8;
+
+        /*The first row of the pass is filtered against zeros*/
+        _lv_memset_00(png->row_cur, pass_bytes);
+        for(y = 0; y < pass_h; y++) {
+            uint8_t * tmp = png->row_prev;
+            png->row_prev = png->row_cur;
+            png->row_cur = tmp;
+            if(png_read_row(png, png->row_cur, pass_bytes) == false) {
+                res = false;
+                break;
+            }
+            png_convert_row(png, png->row_cur, 0, pass_w, pass_buf);
+
+            uint8_t * dest = &img[((start_y[p] + y * step_y[p]) * png->w + start_x[p]) * px_size];
+            uint32_t i;
+            for(i = 0; i < pass_w; i++) {
+                _lv_memcpy_small(dest, &pass_buf[i * px_size], px_size);
+                dest += step_x[p] * px_size;
+            }
+        }
+    }
+
+    _lv_mem_buf_release(pass_buf);
+    png->next_y = png->h;
+    return res;
+}
+
+/**
+ * Read the next part of the compressed stream when the input buffer is empty.
+ * Step to the next IDAT chunk if required.
+ * @param png the decoder's data
+ * @return the next byte of the compressed stream. 0 after the last IDAT chunk.
+ */
+static uint32_t png_in_refill(png_dsc_t * png)
+{
+    while(png->chunk_left == 0) {
+        uint8_t chunk[12];  /*CRC of the previous chunk and the header of the next one*/
+        if(png->idat_end || png_src_read(png, chunk, sizeof(chunk)) == false || memcmp(&chunk[8], "IDAT", 4)) {
+            png->idat_end = 1;
+            if(png->in_over < UINT8_MAX) png->in_over++;
+            return 0;
+        }
+        png->chunk_left = PNG_BE32(&chunk[4]);
+    }
+
+    uint32_t n = png->chunk_left;
+    if(png->data) {
+        /*Read the variable directly*/
+        if(n > png->data_size - png->pos) n = png->data_size - png->pos;
+        png->in_p = &png->data[png->pos];
+        png->pos += n;
+    }
+    else {
+        if(n > PNG_IN_BUF_SIZE) n = PNG_IN_BUF_SIZE;
+        if(png_src_read(png, png->in_buf, n) == false) n = 0;
+        png->in_p = png->in_buf;
+    }
+
+    if(n == 0) {
+        png->idat_end = 1;
+        png->chunk_left = 0;
+        return png_in_refill(png);
+    }
+
+    png->chunk_left -= n;
+    png->in_end = png->in_p + n;
+    return *png->in_p++;
+}
+
+/**
+ * Read bits from the compressed stream
+ * @param png the decoder's data
+ * @param n number of bits to read (max. 16)
+ * @return the bits
+ */
+static inline uint32_t png_bits(png_dsc_t * png, uint32_t n)
+{
+    while(png->bit_cnt < n) {
+        uint32_t b = png->in_p < png->in_end ? *png->in_p++ : png_in_refill(png);
+        png->bit_buf |= b << png->bit_cnt;
+        png->bit_cnt += 8;
+    }
+
+    uint32_t v = png->bit_buf & ((1 << n) - 1);
+    png->bit_buf >>= n;
+    png->bit_cnt -= n;
+    return v;
+}
+
+/**
+ * Decode a symbol from the compressed stream
+ * @param png the decoder's data
+ * @param h the Huffman code to use
+ * @return the symbol or -1 on invalid code
+ */
+static inline int32_t png_huff_decode(png_dsc_t * png, const png_huff_t * h)
+{
+    while(png->bit_cnt < PNG_FAST_BITS) {
+        uint32_t b = png->in_p < png->in_end ? *png->in_p++ : png_in_refill(png);
+        png->bit_buf |= b << png->bit_cnt;
+        png->bit_cnt += 8;
+    }
+
+    uint32_t e = h->fast[png->bit_buf & ((1 << PNG_FAST_BITS) - 1)];
+    if(e) {
+        png->bit_buf >>= e & 0xF;
+        png->bit_cnt -= e & 0xF;
+        return e >> 4;
+    }
+
+    /*Longer code. Decode it bit by bit*/
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    uint32_t len;
+    for(len = 1; len < 16; len++) {
+        code |= png_bits(png, 1);
+        int32_t count = h->count[len];
+        if(code - first < count) return h->symbol[index + code - first];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    return -1;
+}
+
+/**
+ * Inflate the next bytes of the image data
+ * @param png the decoder's data
+ * @param out store the bytes here
+ * @param len number of bytes to inflate
+ * @return true: success; false: corrupted or too short data
+ */
+static bool png_inflate(png_dsc_t * png, uint8_t * out, uint32_t len)
+{
+    uint8_t * window = png->window;
+    uint32_t mask = png->window_mask;
+
+    while(len) {
+        /*Continue the pending match*/
+        if(png->match_len) {
+            uint32_t n = png->match_len < len ? png->match_len : len;
+            uint32_t src = png->window_pos - png->match_dist;
+            uint32_t i;
+            for(i = 0; i < n; i++) {
+                uint8_t b = window[(src + i) & mask];
+                window[(png->window_pos + i) & mask] = b;
+                out[i] = b;
+            }
+            png->window_pos += n;
+            png->match_len -= n;
+            out += n;
+            len -= n;
+            continue;
+        }
+
+        if(png->in_over > 4) return false;  /*Read too far after the data*/
+
+        if(png->mode == PNG_INFLATE_HUFF) {
+            int32_t sym = png_huff_decode(png, &png->lit);
+            if(sym < 0) return false;
+            if(sym < 256) {
+                window[png->window_pos & mask] = sym;
+                png->window_pos++;
+                *out = sym;
+                out++;
+                len--;
+            }
+            else if(sym == 256) {
+                png->mode = png->final ? PNG_INFLATE_END : PNG_INFLATE_BLOCK;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return false;
+                uint32_t match_len = len_base[sym] + png_bits(png, len_extra[sym]);
+                int32_t dsym = png_huff_decode(png, &png->dist);
+                if(dsym < 0 || dsym >= 30) return false;
+                uint32_t dist = dist_base[dsym] + png_bits(png, dist_extra[dsym]);
+                if(dist > png->window_pos || dist > mask + 1) return false;
+                png->match_len = match_len;
+                png->match_dist = dist;
+            }
+        }
+        else if(png->mode == PNG_INFLATE_STORED) {
+            uint32_t n = png->stored_left < len ? png->stored_left : len;
+            uint32_t i;
+            for(i = 0; i < n; i++) {
+                uint8_t b = png_bits(png, 8);
+                window[png->window_pos & mask] = b;
+                png->window_pos++;
+                out[i] = b;
+            }
+            out += n;
+            len -= n;
+            png->stored_left -= n;
+            if(png->stored_left == 0) png->mode = png->final ? PNG_INFLATE_END : PNG_INFLATE_BLOCK;
+        }
+        else if(png->mode == PNG_INFLATE_BLOCK) {
+            png->final = png_bits(png, 1);
+            uint32_t type = png_bits(png, 2);
+            if(type == 0) {
+                /*Stored block: skip to the byte boundary*/
+                png_bits(png, png->bit_cnt & 0x7);
+                uint32_t stored_len = png_bits(png, 16);
+                uint32_t stored_nlen = png_bits(png, 16);
+                if((stored_len ^ 0xFFFF) != stored_nlen) return false;
+                png->stored_left = stored_len;
+                if(stored_len) png->mode = PNG_INFLATE_STORED;
+                else png->mode = png->final ? PNG_INFLATE_END : PNG_INFLATE_BLOCK;
+            }
+            else if(type == 1) {
+                /*Fixed Huffman codes*/
+                uint8_t lens[288];
+                _lv_memset(lens, 8, 144);
+                _lv_memset(&lens[144], 9, 112);
+                _lv_memset(&lens[256], 7, 24);
+                _lv_memset(&lens[280], 8, 8);
+                png_huff_build(&png->lit, lens, 288);
+                _lv_memset(lens, 5, 30);
+                png_huff_build(&png->dist, lens, 30);
+                png->mode = PNG_INFLATE_HUFF;
+            }
+            else if(type == 2) {
+                if(png_inflate_tables(png) == false) return false;
+                png->mode = PNG_INFLATE_HUFF;
+            }
+            else {
+                return false;
+            }
+        }
+        else {
+            return false;   /*The stream ended before the image*/
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Read the dynamic Huffman codes of a block
+ * @param png the decoder's data
+ * @return true: success; false: invalid codes
+ */
+static bool png_inflate_tables(png_dsc_t * png)
+{
+    uint32_t hlit = png_bits(png, 5) + 257;
+    uint32_t hdist = png_bits(png, 5) + 1;
+    uint32_t hclen = png_bits(png, 4) + 4;
+    if(hlit > 286 || hdist > 30) return false;
+
+    uint8_t lens[288 + 32];
+    _lv_memset_00(lens, 19);
+
+    uint32_t i;
+    for(i = 0; i < hclen; i++) lens[clen_order[i]] = png_bits(png, 3);
+
+    /*The distance table is free to store the code of the code lengths*/
+    png_huff_build(&png->dist, lens, 19);
+
+    uint32_t num = hlit + hdist;
+    i = 0;
+    while(i < num) {
+        int32_t sym = png_huff_decode(png, &png->dist);
+        if(sym < 0) return false;
+        if(sym < 16) {
+            lens[i++] = sym;
+            continue;
+        }
+
+        uint8_t v = 0;
+        uint32_t rep;
+        if(sym == 16) {
+            if(i == 0) return false;
+            v = lens[i - 1];
+            rep = 3 + png_bits(png, 2);
+        }
+        else if(sym == 17) {
+            rep = 3 + png_bits(png, 3);
+        }
+        else {
+            rep = 11 + png_bits(png, 7);
+        }
+
+        if(i + rep > num) return false;
+        _lv_memset(&lens[i], v, rep);
+        i += rep;
+    }
+
+    if(lens[256] == 0) return false;
+
+    png_huff_build(&png->lit, lens, hlit);
+    png_huff_build(&png->dist, &lens[hlit], hdist);
+
+    return true;
+}
+
+/**
+ * Build a canonical Huffman code from the code lengths
+ * @param h store the code here
+ * @param lens code length of each symbol (0: the symbol is not used)
+ * @param num number of symbols
+ */
+static void png_huff_build(png_huff_t * h, const uint8_t * lens, uint32_t num)
+{
+    uint16_t offs[16];
+    uint32_t i;
+
+    _lv_memset_00(h->fast, sizeof(h->fast));
+    _lv_memset_00(h->count, sizeof(h->count));
+
+    for(i = 0; i < num; i++) h->count[lens[i]]++;
+    h->count[0] = 0;
+
+    offs[1] = 0;
+    for(i = 1; i < 15; i++) offs[i + 1] = offs[i] + h->count[i];
+
+    for(i = 0; i < num; i++) {
+        if(lens[i]) h->symbol[offs[lens[i]]++] = i;
+    }
+
+    /*Fill the table of the short codes. The codes are stored from their MSB so index with the reversed code*/
+    uint32_t code = 0;
+    uint32_t idx = 0;
+    uint32_t len;
+    for(len = 1; len <= PNG_FAST_BITS; len++) {
+        uint32_t k;
+        for(k = 0; k < h->count[len]; k++) {
+            uint32_t rev = 0;
+            uint32_t b;
+            for(b = 0; b < len; b++) rev |= ((code >> b) & 1) << (len - 1 - b);
+
+            uint16_t e = (h->symbol[idx] << 4) | len;
+            for(; rev < (1 << PNG_FAST_BITS); rev += 1 << len) h->fast[rev] = e;
+            code++;
+            idx++;
+        }
+        code <<= 1;
+    }
+}
+
+#endif /*LV_USE_PNG*/
@@ -0,0 +1,491 @@
+/**
+ * @file lv_img_rle.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_rle.h"
+
+#if LV_USE_RLE
+
+#include "lv_img_cache.h"
+#include "lv_draw_img.h"
+#include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_mem.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+#if LV_USE_FILESYSTEM
+    lv_fs_file_t f;
+    uint8_t * row_buf;          /*The packets of a row read from the file*/
+#endif
+    const uint8_t * data;       /*The image if the source is a variable or a mapped file. NULL: read the file*/
+    const uint8_t * row_ofs;    /*The row offset table (in `data` or loaded from the file)*/
+    uint32_t data_size;         /*Size of `data`*/
+    uint16_t w;
+    uint16_t h;
+    uint8_t alpha;
+} rle_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool rle_header_read(const void * src, uint8_t * header);
+static bool rle_header_check(const uint8_t * header, lv_img_header_t * img_header);
+static const uint8_t * rle_row_get(rle_dsc_t * rle, uint32_t y, const uint8_t ** end);
+static bool rle_row_decode(const rle_dsc_t * rle, const uint8_t * p, const uint8_t * end, uint32_t x, uint32_t len,
+                           uint8_t * buf);
+static const uint8_t * rle_plane_decode(const uint8_t * p, const uint8_t * end, uint32_t w, uint32_t size,
+                                        uint32_t x, uint32_t len, uint8_t * out, uint32_t stride);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+#define RLE_LE16(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8))
+#define RLE_LE32(p) ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register the RLE image decoder.
+ * It opens "*.rle" files and `lv_img_dsc_t` variables with `LV_IMG_CF_RAW...` color format whose data is an RLE image.
+ */
+void _lv_img_rle_init(void)
+{
+    lv_img_decoder_t * decoder = lv_img_decoder_create();
+    LV_ASSERT_MEM(decoder);
+    if(decoder == NULL) {
+        LV_LOG_WARN("_lv_img_rle_init: out of memory");
+        return;
+    }
+
+    lv_img_decoder_set_info_cb(decoder, lv_img_rle_info);
+    lv_img_decoder_set_open_cb(decoder, lv_img_rle_open);
+    lv_img_decoder_set_read_line_cb(decoder, lv_img_rle_read_line);
+    lv_img_decoder_set_close_cb(decoder, lv_img_rle_close);
+}
+
+/**
+ * Get info about an RLE image
+ * @param decoder the decoder where this function belongs
+ * @param src can be file name or pointer to a C array
+ * @param header store the info here
+ * @return LV_RES_OK: no error; LV_RES_INV: can't get the info
+ */
+lv_res_t lv_img_rle_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+
+    uint8_t rle_header[LV_IMG_RLE_HEADER_SIZE];
+    if(rle_header_read(src, rle_header) == false) return LV_RES_INV;
+    if(rle_header_check(rle_header, header) == false) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Open an RLE image
+ * @param decoder the decoder where this function belongs
+ * @param dsc pointer to decoder descriptor. `src`, `color` are already initialized in it.
+ * @return LV_RES_OK: the image is opened; LV_RES_INV: not an RLE image or other error.
+ */
+lv_res_t lv_img_rle_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    uint8_t rle_header[LV_IMG_RLE_HEADER_SIZE];
+    if(rle_header_read(dsc->src, rle_header) == false) return LV_RES_INV;
+    if(rle_header_check(rle_header, &dsc->header) == false) return LV_RES_INV;
+
+    rle_dsc_t * rle = lv_mem_alloc(sizeof(rle_dsc_t));
+    LV_ASSERT_MEM(rle);
+    if(rle == NULL) return LV_RES_INV;
+
+    _lv_memset_00(rle, sizeof(rle_dsc_t));
+    dsc->user_data = rle;
+    rle->w = dsc->header.w;
+    rle->h = dsc->header.h;
+    rle->alpha = dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? 1 : 0;
+
+    uint32_t table_size = (rle->h + 1) * sizeof(uint32_t);
+    uint32_t mem_size = sizeof(rle_dsc_t);
+
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        if(img_dsc->data_size < LV_IMG_RLE_HEADER_SIZE + table_size) {
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+        rle->data = img_dsc->data;
+        rle->data_size = img_dsc->data_size;
+        rle->row_ofs = &img_dsc->data[LV_IMG_RLE_HEADER_SIZE];
+        if(RLE_LE32(&rle->row_ofs[rle->h * 4]) > img_dsc->data_size) {
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+    }
+#if LV_USE_FILESYSTEM
+    else {
+        if(lv_fs_open(&rle->f, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+
+        /*Use the file like a variable if the driver can map it into the memory*/
+        uint32_t file_size;
+        const void * map;
+        if(lv_fs_size(&rle->f, &file_size) == LV_FS_RES_OK && file_size >= LV_IMG_RLE_HEADER_SIZE + table_size &&
+           lv_fs_map(&rle->f, 0, file_size, &map) == LV_FS_RES_OK) {
+            rle->data = map;
+            rle->data_size = file_size;
+            rle->row_ofs = &rle->data[LV_IMG_RLE_HEADER_SIZE];
+            if(RLE_LE32(&rle->row_ofs[rle->h * 4]) > file_size) {
+                lv_img_rle_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+        }
+    }
+
+    if(rle->data == NULL) {
+        /*Keep the row offset table and a buffer for the largest row in the RAM*/
+        uint8_t * row_ofs = lv_mem_alloc(table_size);
+        LV_ASSERT_MEM(row_ofs);
+        rle->row_ofs = row_ofs;
+        if(row_ofs == NULL) {
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+
+        uint32_t rn;
+        lv_fs_res_t res = lv_fs_seek(&rle->f, LV_IMG_RLE_HEADER_SIZE);
+        if(res == LV_FS_RES_OK) res = lv_fs_read(&rle->f, row_ofs, table_size, &rn);
+        if(res != LV_FS_RES_OK || rn != table_size) {
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+
+        uint32_t row_max = 0;
+        uint32_t y;
+        for(y = 0; y < rle->h; y++) {
+            uint32_t start = RLE_LE32(&row_ofs[y * 4]);
+            uint32_t end = RLE_LE32(&row_ofs[(y + 1) * 4]);
+            if(end < start) {
+                lv_img_rle_close(decoder, dsc);
+                return LV_RES_INV;
+            }
+            if(end - start > row_max) row_max = end - start;
+        }
+
+        rle->row_buf = lv_mem_alloc(row_max ? row_max : 1);
+        LV_ASSERT_MEM(rle->row_buf);
+        if(rle->row_buf == NULL) {
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+        mem_size += table_size + row_max;
+    }
+#endif
+
+    /*Decode the whole image if the image cache can keep it*/
+    uint32_t img_size = lv_img_buf_get_img_size(rle->w, rle->h, dsc->header.cf);
+    bool full = false;
+#if LV_IMG_CACHE_DEF_SIZE
+    uint32_t budget = lv_img_cache_get_mem_size();
+    if(budget == 0 || img_size <= budget) full = true;
+#endif
+
+    if(full) {
+        uint8_t * img = lv_mem_alloc(img_size);
+        if(img) {
+            uint32_t px_size = rle->alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+            uint32_t y;
+            for(y = 0; y < rle->h; y++) {
+                const uint8_t * end;
+                const uint8_t * p = rle_row_get(rle, y, &end);
+                if(p == NULL || rle_row_decode(rle, p, end, 0, rle->w, &img[y * rle->w * px_size]) == false) break;
+            }
+
+            if(y == rle->h) {
+                /*Only the decoded image is kept*/
+                lv_img_rle_close(decoder, dsc);
+                dsc->img_data = img;
+                dsc->mem_size = img_size;
+                return LV_RES_OK;
+            }
+
+            LV_LOG_WARN("RLE decoder: corrupted image");
+            lv_mem_free(img);
+            lv_img_rle_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+    }
+
+    dsc->img_data = NULL;
+    dsc->mem_size = mem_size;
+    return LV_RES_OK;
+}
+
+/**
+ * Decode `len` pixels starting from the given `x`, `y` coordinates and store them in `buf`.
+ * Any row can be read directly thanks to the row offset table.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param x start x coordinate
+ * @param y start y coordinate
+ * @param len number of pixels to decode
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_rle_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
+                              lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+
+    rle_dsc_t * rle = dsc->user_data;
+    if(rle == NULL) return LV_RES_INV;
+    if(y < 0 || y >= rle->h || x < 0 || len < 0 || x + len > rle->w) return LV_RES_INV;
+
+    const uint8_t * end;
+    const uint8_t * p = rle_row_get(rle, y, &end);
+    if(p == NULL || rle_row_decode(rle, p, end, x, len, buf) == false) {
+        LV_LOG_WARN("RLE decoder: corrupted image");
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Close the pending decoding. Free resources etc.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ */
+void lv_img_rle_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+
+    rle_dsc_t * rle = dsc->user_data;
+    if(rle) {
+#if LV_USE_FILESYSTEM
+        if(rle->data == NULL) {
+            if(rle->row_ofs) lv_mem_free((void *)rle->row_ofs);
+            if(rle->row_buf) lv_mem_free(rle->row_buf);
+        }
+        if(rle->f.file_d) lv_fs_close(&rle->f);
+#endif
+        lv_mem_free(rle);
+        dsc->user_data = NULL;
+    }
+    else if(dsc->img_data) {
+        lv_mem_free((void *)dsc->img_data);
+        dsc->img_data = NULL;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Read the header of an RLE image
+ * @param src a file name or pointer to an `lv_img_dsc_t` variable
+ * @param header store `LV_IMG_RLE_HEADER_SIZE` bytes here
+ * @return true: the source might be an RLE image
+ */
+static bool rle_header_read(const void * src, uint8_t * header)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = src;
+        lv_img_cf_t cf = img_dsc->header.cf;
+        if(cf != LV_IMG_CF_RAW && cf != LV_IMG_CF_RAW_ALPHA && cf != LV_IMG_CF_RAW_CHROMA_KEYED) return false;
+        if(img_dsc->data == NULL || img_dsc->data_size < LV_IMG_RLE_HEADER_SIZE) return false;
+        _lv_memcpy_small(header, img_dsc->data, LV_IMG_RLE_HEADER_SIZE);
+        return true;
+    }
+#if LV_USE_FILESYSTEM
+    else if(src_type == LV_IMG_SRC_FILE) {
+        if(strcmp(lv_fs_get_ext(src), "rle")) return false;
+
+        lv_fs_file_t f;
+        if(lv_fs_open(&f, src, LV_FS_MODE_RD) != LV_FS_RES_OK) return false;
+        uint32_t rn;
+        lv_fs_res_t res = lv_fs_read(&f, header, LV_IMG_RLE_HEADER_SIZE, &rn);
+        lv_fs_close(&f);
+        return res == LV_FS_RES_OK && rn == LV_IMG_RLE_HEADER_SIZE;
+    }
+#endif
+
+    return false;
+}
+
+/**
+ * Check the header of an RLE image
+ * @param header the first `LV_IMG_RLE_HEADER_SIZE` bytes of the image
+ * @param img_header store the size and color format of the decoded image here
+ * @return true: the image can be decoded
+ */
+static bool rle_header_check(const uint8_t * header, lv_img_header_t * img_header)
+{
+    if(memcmp(header, LV_IMG_RLE_MAGIC, 4)) return false;
+
+    uint32_t w = RLE_LE16(&header[4]);
+    uint32_t h = RLE_LE16(&header[6]);
+    uint8_t flags = header[9];
+    if(w == 0 || h == 0 || w > 2047 || h > 2047) return false;
+
+    /*The colors are stored as `lv_color_t` so they must be converted for this color format*/
+    if(header[8] != LV_COLOR_DEPTH || ((flags & LV_IMG_RLE_FLAG_SWAP) ? 1 : 0) != LV_COLOR_16_SWAP) {
+        LV_LOG_WARN("RLE decoder: the image was converted for an other color format");
+        return false;
+    }
+
+    img_header->always_zero = 0;
+    img_header->w = w;
+    img_header->h = h;
+    img_header->cf = (flags & LV_IMG_RLE_FLAG_ALPHA) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+
+    return true;
+}
+
+/**
+ * Get the packets of a row
+ * @param rle the decoder's data
+ * @param y index of the row
+ * @param end store the end of the row's packets here
+ * @return pointer to the row's packets or NULL on error
+ */
+static const uint8_t * rle_row_get(rle_dsc_t * rle, uint32_t y, const uint8_t ** end)
+{
+    uint32_t start = RLE_LE32(&rle->row_ofs[y * 4]);
+    uint32_t stop = RLE_LE32(&rle->row_ofs[(y + 1) * 4]);
+    if(stop < start) return NULL;
+
+    if(rle->data) {
+        if(stop > rle->data_size) return NULL;
+        *end = &rle->data[stop];
+        return &rle->data[start];
+    }
+
+#if LV_USE_FILESYSTEM
+    uint32_t rn;
+    if(lv_fs_seek(&rle->f, start) != LV_FS_RES_OK) return NULL;
+    if(lv_fs_read(&rle->f, rle->row_buf, stop - start, &rn) != LV_FS_RES_OK || rn != stop - start) return NULL;
+    *end = &rle->row_buf[stop - start];
+    return rle->row_buf;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * Decode a part of a row to `LV_IMG_CF_TRUE_COLOR(_ALPHA)`
+ * @param rle the decoder's data
+ * @param p the packets of the row
+ * @param end the end of the row's packets
+ * @param x index of the first pixel to decode
+ * @param len number of pixels to decode
+ * @param buf store the pixels here
+ * @return true: success; false: corrupted row
+ */
+static bool rle_row_decode(const rle_dsc_t * rle, const uint8_t * p, const uint8_t * end, uint32_t x, uint32_t len,
+                           uint8_t * buf)
+{
+    if(rle->alpha == 0) {
+        return rle_plane_decode(p, end, rle->w, sizeof(lv_color_t), x, len, buf, sizeof(lv_color_t)) != NULL;
+    }
+
+    /*The alpha plane follows the whole color plane. With 32 bit colors it overwrites the colors' alpha*/
+    p = rle_plane_decode(p, end, rle->w, sizeof(lv_color_t), x, len, buf, LV_IMG_PX_SIZE_ALPHA_BYTE);
+    if(p == NULL) return false;
+    p = rle_plane_decode(p, end, rle->w, 1, x, len, &buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], LV_IMG_PX_SIZE_ALPHA_BYTE);
+    return p != NULL;
+}
+
+/**
+ * Decode the `[x, x + len)` part of a plane (colors or opacities) of a row
+ * @param p the packets of the plane
+ * @param end the end of the row's packets
+ * @param w width of the image
+ * @param size size of the values (`sizeof(lv_color_t)` or 1)
+ * @param x index of the first value to decode
+ * @param len number of values to decode
+ * @param out store the values here
+ * @param stride distance of the values in `out`
+ * @return pointer after the plane's packets or NULL on error
+ */
+static const uint8_t * rle_plane_decode(const uint8_t * p, const uint8_t * end, uint32_t w, uint32_t size,
+                                        uint32_t x, uint32_t len, uint8_t * out, uint32_t stride)
+{
+    uint32_t x_end = x + len;
+    uint32_t i = 0;
+    while(i < w) {
+        if(p >= end) return NULL;
+        uint32_t n = (*p & ~LV_IMG_RLE_RUN) + 1;
+        bool run = (*p & LV_IMG_RLE_RUN) ? true : false;
+        p++;
+
+        uint32_t data_size = run ? size : n * size;
+        if(i + n > w || (uint32_t)(end - p) < data_size) return NULL;
+
+        /*The part of the packet in [x, x_end)*/
+        uint32_t s = i > x ? i : x;
+        uint32_t e = i + n < x_end ? i + n : x_end;
+        if(s < e) {
+            uint8_t * o = &out[(s - x) * stride];
+            uint32_t cnt = e - s;
+            if(run) {
+                if(stride == size && size == sizeof(lv_color_t)) {
+                    lv_color_t c;
+                    _lv_memcpy_small(&c, p, sizeof(lv_color_t));
+                    lv_color_fill((lv_color_t *)o, c, cnt);
+                }
+                else if(stride == 1) {
+                    _lv_memset(o, *p, cnt);
+                }
+                else {
+                    uint32_t k;
+                    for(k = 0; k < cnt; k++) {
+                        _lv_memcpy_small(o, p, size);
+                        o += stride;
+                    }
+                }
+            }
+            else {
+                const uint8_t * v = &p[(s - i) * size];
+                if(stride == size) {
+                    _lv_memcpy(o, v, cnt * size);
+                }
+                else {
+                    uint32_t k;
+                    for(k = 0; k < cnt; k++) {
+                        _lv_memcpy_small(o, v, size);
+                        o += stride;
+                        v += size;
+                    }
+                }
+            }
+        }
+
+        p += data_size;
+        i += n;
+    }
+
+    return p;
+}
+
+#endif /*LV_USE_RLE*/
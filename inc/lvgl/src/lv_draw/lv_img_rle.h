@@ -0,0 +1,106 @@
+/**
+ * @file lv_img_rle.h
+ *
+ */
+
+#ifndef LV_IMG_RLE_H
+#define LV_IMG_RLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_RLE
+
+#include "lv_img_decoder.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*First bytes of an RLE image*/
+#define LV_IMG_RLE_MAGIC        "LVRL"
+
+/*Size of the RLE image header. The row offset table follows it*/
+#define LV_IMG_RLE_HEADER_SIZE  12
+
+/*Bits of the header's `flags`*/
+#define LV_IMG_RLE_FLAG_ALPHA   0x01    /*The rows have an alpha plane after the color plane*/
+#define LV_IMG_RLE_FLAG_SWAP    0x02    /*The colors were converted with `LV_COLOR_16_SWAP`*/
+
+/*A packet header with this bit set is followed by one value repeated `(header & 0x7F) + 1` times.
+ *Else `header + 1` values follow*/
+#define LV_IMG_RLE_RUN          0x80
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the RLE image decoder.
+ * It opens "*.rle" files and `lv_img_dsc_t` variables with `LV_IMG_CF_RAW...` color format whose data is an RLE image.
+ * An RLE image (little endian):
+ * - header: `LV_IMG_RLE_MAGIC`, width (uint16), height (uint16), `LV_COLOR_DEPTH` (uint8), flags (uint8), 0 (uint16)
+ * - offset of each row and the end of the last row from the start of the image (uint32, height + 1 entries)
+ * - rows: packets of the colors (`lv_color_t`) and, with `LV_IMG_RLE_FLAG_ALPHA`, packets of the opacities
+ * Use `tools/img_rle_conv.c` to convert images to this format.
+ */
+void _lv_img_rle_init(void);
+
+/**
+ * Get info about an RLE image
+ * @param decoder the decoder where this function belongs
+ * @param src can be file name or pointer to a C array
+ * @param header store the info here
+ * @return LV_RES_OK: no error; LV_RES_INV: can't get the info
+ */
+lv_res_t lv_img_rle_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+
+/**
+ * Open an RLE image
+ * @param decoder the decoder where this function belongs
+ * @param dsc pointer to decoder descriptor. `src`, `color` are already initialized in it.
+ * @return LV_RES_OK: the image is opened; LV_RES_INV: not an RLE image or other error.
+ */
+lv_res_t lv_img_rle_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+
+/**
+ * Decode `len` pixels starting from the given `x`, `y` coordinates and store them in `buf`.
+ * Any row can be read directly thanks to the row offset table.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param x start x coordinate
+ * @param y start y coordinate
+ * @param len number of pixels to decode
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+lv_res_t lv_img_rle_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
+                              lv_coord_t y, lv_coord_t len, uint8_t * buf);
+
+/**
+ * Close the pending decoding. Free resources etc.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ */
+void lv_img_rle_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_RLE*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_IMG_RLE_H*/
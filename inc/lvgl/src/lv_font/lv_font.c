@@ -8,8 +8,11 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_txt.h"
 
 /*********************
  *      DEFINES
@@ -18,14 +21,26 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_FONT_FALLBACK_CACHE_SIZE
+typedef struct {
+    const lv_font_t * font;         /*The font the letter was looked up in. NULL: unused entry*/
+    const lv_font_t * resolved;     /*The font of the fallback chain which has the glyph. NULL: none of them*/
+    uint32_t letter;
+} fallback_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static const lv_font_t * fallback_resolve(const lv_font_t * font, uint32_t letter);
+static bool is_streamed(const lv_font_t * font);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_FONT_FALLBACK_CACHE_SIZE
+    static fallback_cache_entry_t fallback_cache[LV_FONT_FALLBACK_CACHE_SIZE];
+#endif
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -43,15 +58,20 @@
  * Return with the bitmap of a font.
  * @param font_p pointer to a font
  * @param letter an UNICODE character code
- * @return pointer to the bitmap of the letter
+ * @return pointer to the bitmap of the letter. Taken from the fallback fonts if `font_p` has no such glyph.
  */
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
+    if(font_p->fallback) {
+        font_p = fallback_resolve(font_p, letter);
+        if(font_p == NULL) return NULL;
+    }
+
     return font_p->get_glyph_bitmap(font_p, letter);
 }
 
 /**
- * Get the descriptor of a glyph
+ * Get the descriptor of a glyph. Taken from the first font of the fallback chain which has the glyph.
  * @param font_p pointer to font
  * @param dsc_out store the result descriptor here
  * @param letter an UNICODE letter code
@@ -61,7 +81,14 @@ const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t lett
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
                            uint32_t letter_next)
 {
-    return font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    if(font_p->fallback) {
+        font_p = fallback_resolve(font_p, letter);
+        if(font_p == NULL) return false;
+    }
+
+    if(font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next) == false) return false;
+    dsc_out->resolved_font = font_p;
+    return true;
 }
 
 /**
@@ -80,6 +107,102 @@ uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32
     else return 0;
 }
 
+/**
+ * Read the glyphs of a text into the caches of the fonts which load their bitmaps from files on demand
+ * (e.g. with `lv_font_load_lazy()`) so drawing the text later doesn't have to wait for the file system.
+ * Does nothing if all fonts of the fallback chain have their bitmaps in the memory.
+ * @param font pointer to a font
+ * @param txt a '\0' terminated text
+ */
+void lv_font_prefetch(const lv_font_t * font, const char * txt)
+{
+    const lv_font_t * f;
+    for(f = font; f != NULL; f = f->fallback) {
+        if(is_streamed(f)) break;
+    }
+    if(f == NULL) return;
+
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        lv_font_glyph_dsc_t g;
+        if(lv_font_get_glyph_dsc(font, &g, letter, 0) == false) continue;
+        if(g.box_w == 0 || g.box_h == 0) continue;
+
+        f = g.resolved_font;
+        if(is_streamed(f)) f->get_glyph_bitmap(f, letter);
+    }
+}
+
+/**
+ * Forget which fonts of the fallback chains have the recently used letters.
+ * Call it if a `fallback` is changed or a font is deleted.
+ */
+void lv_font_fallback_cache_clean(void)
+{
+#if LV_FONT_FALLBACK_CACHE_SIZE
+    _lv_memset_00(fallback_cache, sizeof(fallback_cache));
+#endif
+}
+
+/**
+ * Get the table of the widths of the printable ASCII letters of a font. Built on the first call.
+ * @param font pointer to a font
+ * @return pointer to the table or NULL if the font has none
+ */
+const lv_font_ascii_widths_t * _lv_font_get_ascii_widths(const lv_font_t * font)
+{
+#if LV_FONT_ASCII_WIDTHS
+    /*Only the fonts in the built-in format can tell whether their glyphs are kerned*/
+    if(font->get_glyph_dsc == lv_font_get_glyph_dsc_fmt_txt) return lv_font_fmt_txt_get_ascii_widths(font);
+#else
+    (void)font; /*Unused*/
+#endif
+    return NULL;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Find the first font of a fallback chain which has a glyph for a letter.
+ * The result is cached so the fonts are searched only once for the recently used letters.
+ * @param font pointer to the first font of the chain
+ * @param letter an UNICODE letter code
+ * @return the font with the glyph or NULL if none of the fonts has it
+ */
+static const lv_font_t * fallback_resolve(const lv_font_t * font, uint32_t letter)
+{
+#if LV_FONT_FALLBACK_CACHE_SIZE
+    fallback_cache_entry_t * e = &fallback_cache[(letter ^ ((lv_uintptr_t)font >> 4)) & (LV_FONT_FALLBACK_CACHE_SIZE - 1)];
+    if(e->font == font && e->letter == letter) return e->resolved;
+#endif
+
+    const lv_font_t * f;
+    for(f = font; f != NULL; f = f->fallback) {
+        lv_font_glyph_dsc_t g;
+        if(f->get_glyph_dsc(f, &g, letter, 0)) break;
+    }
+
+#if LV_FONT_FALLBACK_CACHE_SIZE
+    e->font = font;
+    e->resolved = f;
+    e->letter = letter;
+#endif
+
+    return f;
+}
+
+/**
+ * Tell whether a font reads its glyph bitmaps from a file on demand.
+ * @param font pointer to a font
+ * @return true: the bitmaps are read when they are needed; false: they are in the memory
+ */
+static bool is_streamed(const lv_font_t * font)
+{
+    if(font->get_glyph_dsc != lv_font_get_glyph_dsc_fmt_txt) return false;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    return fdsc->glyph_bitmap == NULL && fdsc->get_bitmap_cb != NULL;
+}
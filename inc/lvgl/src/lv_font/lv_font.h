@@ -24,6 +24,9 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*The printable ASCII letters measured with `lv_font_ascii_widths_t`*/
+#define LV_FONT_ASCII_FIRST     0x20
+#define LV_FONT_ASCII_CNT       (0x7F - LV_FONT_ASCII_FIRST)
 
 /**********************
  *      TYPEDEFS
@@ -33,8 +36,11 @@ extern "C" {
  * General types
  *-----------------*/
 
+struct _lv_font_struct;
+
 /** Describes the properties of a glyph. */
 typedef struct {
+    const struct _lv_font_struct * resolved_font; /**< The font of the fallback chain which has the glyph*/
     uint16_t adv_w; /**< The glyph needs this space. Draw the next glyph after this width. */
     uint16_t box_w;  /**< Width of the glyph's bounding box*/
     uint16_t box_h;  /**< Height of the glyph's bounding box*/
@@ -69,6 +75,11 @@ typedef struct _lv_font_struct {
     int8_t underline_position;      /**< Distance between the top of the underline and base line (< 0 means below the base line)*/
     int8_t underline_thickness;     /**< Thickness of the underline*/
 
+    /** Look up the glyphs missing from this font in this font (and in its fallback).
+     *  If it's changed after the font was used clean the caches with `lv_font_fallback_cache_clean()`
+     *  and, for the fonts in the built-in format, with `lv_font_fmt_txt_glyph_cache_clean()`.*/
+    const struct _lv_font_struct * fallback;
+
     void * dsc;                     /**< Store implementation specific or run_time data or caching here*/
 #if LV_USE_USER_DATA
     lv_font_user_data_t user_data;  /**< Custom user data for font. */
@@ -76,6 +87,12 @@ typedef struct _lv_font_struct {
 
 } lv_font_t;
 
+/** The widths of the printable ASCII letters of a font [px]*/
+typedef struct {
+    uint8_t kern;   /**< 0: `w[letter]`, 1: `w[letter][letter_next]` as the widths depend on kerning*/
+    uint8_t w[];
+} lv_font_ascii_widths_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -84,12 +101,12 @@ typedef struct _lv_font_struct {
  * Return with the bitmap of a font.
  * @param font_p pointer to a font
  * @param letter an UNICODE character code
- * @return pointer to the bitmap of the letter
+ * @return pointer to the bitmap of the letter. Taken from the fallback fonts if `font_p` has no such glyph.
  */
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter);
 
 /**
- * Get the descriptor of a glyph
+ * Get the descriptor of a glyph. Taken from the first font of the fallback chain which has the glyph.
  * @param font_p pointer to font
  * @param dsc_out store the result descriptor here
  * @param letter an UNICODE letter code
@@ -108,6 +125,48 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
  */
 uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next);
 
+/**
+ * Read the glyphs of a text into the caches of the fonts which load their bitmaps from files on demand
+ * (e.g. with `lv_font_load_lazy()`) so drawing the text later doesn't have to wait for the file system.
+ * Does nothing if all fonts of the fallback chain have their bitmaps in the memory.
+ * @param font pointer to a font
+ * @param txt a '\0' terminated text
+ */
+void lv_font_prefetch(const lv_font_t * font, const char * txt);
+
+/**
+ * Forget which fonts of the fallback chains have the recently used letters.
+ * Call it if a `fallback` is changed or a font is deleted.
+ */
+void lv_font_fallback_cache_clean(void);
+
+/**
+ * Get the table of the widths of the printable ASCII letters of a font. Built on the first call.
+ * @param font pointer to a font
+ * @return pointer to the table or NULL if the font has none
+ */
+const lv_font_ascii_widths_t * _lv_font_get_ascii_widths(const lv_font_t * font);
+
+/**
+ * Get the width of a printable ASCII letter from the width table of its font.
+ * Gives the same result as `lv_font_get_glyph_width()`.
+ * @param widths the widths of the font from `_lv_font_get_ascii_widths()`
+ * @param letter an UNICODE letter
+ * @param letter_next the next letter after `letter`. Used for kerning
+ * @return the width of the glyph or -1 if the letters are not in the table
+ */
+static inline int32_t _lv_font_get_ascii_width(const lv_font_ascii_widths_t * widths, uint32_t letter,
+                                               uint32_t letter_next)
+{
+    letter -= LV_FONT_ASCII_FIRST;
+    if(letter >= LV_FONT_ASCII_CNT) return -1;
+    if(widths->kern == 0) return widths->w[letter];
+
+    letter_next -= LV_FONT_ASCII_FIRST;
+    if(letter_next >= LV_FONT_ASCII_CNT) return -1;
+    return widths->w[letter * LV_FONT_ASCII_CNT + letter_next];
+}
+
 /**
  * Get the line height of a font. All characters fit into this height
  * @param font_p pointer to a font
@@ -14,10 +14,19 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_lru.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define GLYPH_CACHE_BUCKETS 64  /*Must be power of 2*/
+#define GLYPH_CACHE_ENTRY_CNT   (LV_FONT_GLYPH_CACHE_SIZE / 128 + 1)    /*Glyphs of 128 bytes on average fill the budget*/
+#define GLYPH_CACHE_NONE    0xFFFF  /*No entry in `buckets` and `hash_next`*/
+#define CMAP_PAGE_CNT       256
+#define CMAP_PAGE_SIZE      256
+#define CMAP_GID_NONE       0xFFFF  /*The glyph id doesn't fit into the page. Look it up in the cmaps.*/
+#define KERN_ASCII_FIRST    0x20
+#define KERN_ASCII_CNT      (0x7F - KERN_ASCII_FIRST)
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +37,51 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+typedef struct {
+    lv_lru_entry_t lru;
+    uint8_t * data;         /*The decompressed bitmap. NULL: unused entry*/
+    uint32_t size;          /*Size of `data` [bytes]*/
+    uint32_t gid;           /*An unused entry stays in the bucket of its last glyph until it's reused. 0: in no bucket*/
+    uint16_t hash_next;     /*Index of the next entry in the same bucket*/
+} glyph_cache_entry_t;
+
+typedef struct _lv_font_fmt_txt_glyph_cache_t {
+    lv_lru_t lru;
+    glyph_cache_entry_t entries[GLYPH_CACHE_ENTRY_CNT];
+    uint16_t buckets[GLYPH_CACHE_BUCKETS];      /*Index of the first entry of the buckets*/
+    uint32_t add_cnt;                           /*Number of glyphs added. The ones not in the cache anymore were evicted.*/
+    lv_font_fmt_txt_glyph_cache_stats_t stats;  /*Only the hits and misses. The others are counted on request.*/
+} lv_font_fmt_txt_glyph_cache_t;
+
+#if LV_FONT_KERN_ASCII_TABLE || LV_FONT_KERN_CACHE_SIZE
+typedef struct {
+    uint32_t pair;      /*`(gid_left << 16) + gid_right`. 0: empty as the glyph id 0 is never kerned*/
+    int8_t value;
+} kern_cache_entry_t;
+
+typedef struct _lv_font_fmt_txt_kern_cache_t {
+#if LV_FONT_KERN_ASCII_TABLE
+    int8_t ascii[KERN_ASCII_CNT][KERN_ASCII_CNT];   /*Kerning values of all pairs of printable ASCII letters*/
+#endif
+#if LV_FONT_KERN_CACHE_SIZE
+    kern_cache_entry_t entries[LV_FONT_KERN_CACHE_SIZE];
+#endif
+} lv_font_fmt_txt_kern_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t cmap_lookup(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_USE_FONT_CMAP_TABLE
+    static const uint16_t * cmap_page_build(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t page_id);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int8_t kern_lookup(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t gid_right);
+#if LV_FONT_KERN_ASCII_TABLE || LV_FONT_KERN_CACHE_SIZE
+    static lv_font_fmt_txt_kern_cache_t * kern_cache_get(const lv_font_t * font);
+#endif
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
@@ -44,11 +93,23 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
     static inline uint8_t rle_next(void);
+#if LV_FONT_GLYPH_CACHE_SIZE
+    static const uint8_t * glyph_cache_get(lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid);
+    static uint8_t * glyph_cache_add(lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t size);
+    static uint32_t glyph_cache_size(const void * entry);
+    static void glyph_cache_free(void * entry);
+#endif
 #endif /* LV_USE_FONT_COMPRESSED */
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_FONT_CMAP_TABLE
+    static const uint16_t cmap_page_empty[CMAP_PAGE_SIZE];  /*Shared by the pages without glyphs*/
+#endif
+#if LV_FONT_ASCII_WIDTHS
+    static lv_font_ascii_widths_t ascii_widths_none;        /*Marks the fonts with too wide letters for the table*/
+#endif
 #if LV_USE_FONT_COMPRESSED
     static uint32_t rle_rdp;
     static const uint8_t * rle_in;
@@ -86,8 +147,22 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+        const uint8_t * cached = glyph_cache_get(fdsc, gid);
+        if(cached) return cached;
+    }
+#endif
+
+    const uint8_t * bitmap;
+    if(fdsc->glyph_bitmap) bitmap = &fdsc->glyph_bitmap[gdsc->bitmap_index];
+    else if(fdsc->get_bitmap_cb) bitmap = fdsc->get_bitmap_cb(font, gid);
+    else bitmap = NULL;
+
+    if(bitmap == NULL) return NULL;
+
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
-        return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+        return bitmap;
     }
     /*Handle compressed bitmap*/
     else {
@@ -112,17 +187,24 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MEM(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+        /*Decompress into the cache or, if it doesn't fit, into the common buffer*/
+        uint8_t * out = NULL;
+#if LV_FONT_GLYPH_CACHE_SIZE
+        out = glyph_cache_add(fdsc, gid, buf_size);
+#endif
+        if(out == NULL) {
+            if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
+                uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+                LV_ASSERT_MEM(tmp);
+                if(tmp == NULL) return NULL;
+                LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+            }
+            out = LV_GC_ROOT(_lv_font_decompr_buf);
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        decompress(bitmap, out, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+        return out;
 #else /* !LV_USE_FONT_COMPRESSED */
         return NULL;
 #endif
@@ -154,9 +236,23 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
 
     int8_t kvalue = 0;
     if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
+        bool kern_found = false;
+#if LV_FONT_KERN_ASCII_TABLE
+        /*The pairs of printable ASCII letters are in a table if the font has kerning pairs*/
+        if(fdsc->kern_classes == 0 &&
+           unicode_letter - KERN_ASCII_FIRST < KERN_ASCII_CNT && unicode_letter_next - KERN_ASCII_FIRST < KERN_ASCII_CNT) {
+            lv_font_fmt_txt_kern_cache_t * cache = kern_cache_get(font);
+            if(cache) {
+                kvalue = cache->ascii[unicode_letter - KERN_ASCII_FIRST][unicode_letter_next - KERN_ASCII_FIRST];
+                kern_found = true;
+            }
+        }
+#endif
+        if(!kern_found) {
+            uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+            if(gid_next) {
+                kvalue = get_kern_value(font, gid, gid_next);
+            }
         }
     }
 
@@ -183,6 +279,46 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_FONT_ASCII_WIDTHS
+/**
+ * Get the widths of the printable ASCII letters of a font. Built on the first call.
+ * @param font pointer to a font in LittlevGL's native format
+ * @return pointer to the widths or NULL if they don't fit into the table or out of memory
+ */
+const lv_font_ascii_widths_t * lv_font_fmt_txt_get_ascii_widths(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+    if(fdsc->ascii_widths) return fdsc->ascii_widths != &ascii_widths_none ? fdsc->ascii_widths : NULL;
+
+    /*With kerning the width of a letter depends on the next letter too.
+     *The fallback fonts might have kerning so measure all pairs for them too.*/
+    uint32_t next_cnt = (fdsc->kern_dsc || font->fallback) ? LV_FONT_ASCII_CNT : 1;
+    lv_font_ascii_widths_t * widths = lv_mem_alloc(sizeof(lv_font_ascii_widths_t) + LV_FONT_ASCII_CNT * next_cnt);
+    LV_ASSERT_MEM(widths);
+    if(widths == NULL) return NULL;
+    widths->kern = next_cnt > 1 ? 1 : 0;
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < LV_FONT_ASCII_CNT; i++) {
+        for(j = 0; j < next_cnt; j++) {
+            lv_font_glyph_dsc_t g;
+            uint32_t w = 0;
+            if(lv_font_get_glyph_dsc(font, &g, LV_FONT_ASCII_FIRST + i, LV_FONT_ASCII_FIRST + j)) w = g.adv_w;
+            if(w > UINT8_MAX) {
+                lv_mem_free(widths);
+                fdsc->ascii_widths = &ascii_widths_none;
+                return NULL;
+            }
+            widths->w[i * next_cnt + j] = w;
+        }
+    }
+
+    fdsc->ascii_widths = widths;
+    return widths;
+}
+#endif
+
 /**
  * Free the allocated memories.
  */
@@ -194,6 +330,73 @@ void _lv_font_clean_up_fmt_txt(void)
     }
 }
 
+/**
+ * Free the decompressed glyphs, the glyph id lookup table, the kerning values and the ASCII widths cached for a font.
+ * @param font pointer to a font in LittlevGL's native format
+ */
+void lv_font_fmt_txt_glyph_cache_clean(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+
+#if LV_USE_FONT_CMAP_TABLE
+    if(fdsc->cmap_pages) {
+        uint32_t i;
+        for(i = 0; i < CMAP_PAGE_CNT; i++) {
+            if(fdsc->cmap_pages[i] != cmap_page_empty) lv_mem_free(fdsc->cmap_pages[i]);
+        }
+        lv_mem_free(fdsc->cmap_pages);
+        fdsc->cmap_pages = NULL;
+    }
+#endif
+
+    if(fdsc->kern_cache) {
+        lv_mem_free(fdsc->kern_cache);
+        fdsc->kern_cache = NULL;
+    }
+
+#if LV_FONT_ASCII_WIDTHS
+    if(fdsc->ascii_widths) {
+        if(fdsc->ascii_widths != &ascii_widths_none) lv_mem_free(fdsc->ascii_widths);
+        fdsc->ascii_widths = NULL;
+    }
+#endif
+
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->glyph_cache;
+    if(cache == NULL) return;
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_GLYPH_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < GLYPH_CACHE_ENTRY_CNT; i++) glyph_cache_free(&cache->entries[i]);
+#endif
+
+    lv_mem_free(cache);
+    fdsc->glyph_cache = NULL;
+}
+
+/**
+ * Get the statistics of the decompressed glyph cache of a font.
+ * @param font pointer to a font in LittlevGL's native format
+ * @param stats store the statistics here (all zero if the font has no cache yet)
+ */
+void lv_font_fmt_txt_glyph_cache_get_stats(const lv_font_t * font, lv_font_fmt_txt_glyph_cache_stats_t * stats)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+    const lv_font_fmt_txt_glyph_cache_t * cache = fdsc->glyph_cache;
+    if(cache == NULL) {
+        _lv_memset_00(stats, sizeof(lv_font_fmt_txt_glyph_cache_stats_t));
+        return;
+    }
+
+    *stats = cache->stats;
+    stats->mem_used = cache->lru.used;
+    stats->entry_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < GLYPH_CACHE_ENTRY_CNT; i++) {
+        if(cache->entries[i].data) stats->entry_cnt++;
+    }
+    stats->evict = cache->add_cnt - stats->entry_cnt;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -204,15 +407,53 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
+#if LV_USE_FONT_CMAP_TABLE
+    /*Use the table in the Basic Multilingual Plane. Build it on the first use.*/
+    if(letter < CMAP_PAGE_CNT * CMAP_PAGE_SIZE) {
+        if(fdsc->cmap_pages == NULL) {
+            fdsc->cmap_pages = lv_mem_alloc(CMAP_PAGE_CNT * sizeof(fdsc->cmap_pages[0]));
+            LV_ASSERT_MEM(fdsc->cmap_pages);
+            if(fdsc->cmap_pages) _lv_memset_00(fdsc->cmap_pages, CMAP_PAGE_CNT * sizeof(fdsc->cmap_pages[0]));
+        }
+
+        if(fdsc->cmap_pages) {
+            const uint16_t * page = fdsc->cmap_pages[letter / CMAP_PAGE_SIZE];
+            if(page == NULL) {
+                page = cmap_page_build(fdsc, letter / CMAP_PAGE_SIZE);
+                fdsc->cmap_pages[letter / CMAP_PAGE_SIZE] = page;
+            }
+
+            if(page) {
+                uint16_t glyph_id = page[letter % CMAP_PAGE_SIZE];
+                if(glyph_id != CMAP_GID_NONE) return glyph_id;
+            }
+        }
+    }
+#endif
+
     /*Check the cache first*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
 
+    fdsc->last_letter = letter;
+    fdsc->last_glyph_id = cmap_lookup(fdsc, letter);
+    return fdsc->last_glyph_id;
+}
+
+/**
+ * Find the glyph id of a letter in the cmaps of a font.
+ * The first cmap whose range contains the letter tells the glyph id.
+ * @param fdsc pointer to a font descriptor
+ * @param letter an UNICODE letter code
+ * @return the glyph id or 0 if not found
+ */
+static uint32_t cmap_lookup(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -243,22 +484,145 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
     return 0;
+}
+
+#if LV_USE_FONT_CMAP_TABLE
+/**
+ * Create a page of the glyph id table from the cmaps.
+ * The cmaps are applied from the last so the first cmap containing a letter wins like in `cmap_lookup()`.
+ * @param fdsc pointer to a font descriptor
+ * @param page_id index of the page (the letters `page_id * 256 ... page_id * 256 + 255`)
+ * @return the new page, `cmap_page_empty` if it has no glyphs or NULL if out of memory
+ */
+static const uint16_t * cmap_page_build(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t page_id)
+{
+    uint32_t page_start = page_id * CMAP_PAGE_SIZE;
+    uint32_t page_end = page_start + CMAP_PAGE_SIZE;
+
+    uint16_t * page = NULL;
+    int32_t i;
+    for(i = fdsc->cmap_num - 1; i >= 0; i--) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t start = LV_MATH_MAX(cmap->range_start, page_start);
+        uint32_t end = LV_MATH_MIN(cmap->range_start + cmap->range_length, page_end);
+        if(start >= end) continue;
+
+        if(page == NULL) {
+            page = lv_mem_alloc(CMAP_PAGE_SIZE * sizeof(page[0]));
+            LV_ASSERT_MEM(page);
+            if(page == NULL) return NULL;
+            _lv_memset_00(page, CMAP_PAGE_SIZE * sizeof(page[0]));
+        }
 
+        uint32_t letter;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+            bool full = cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL;
+            for(letter = start; letter < end; letter++) {
+                uint32_t rcp = letter - cmap->range_start;
+                uint32_t glyph_id = cmap->glyph_id_start + (full ? gid_ofs_8[rcp] : rcp);
+                page[letter - page_start] = glyph_id < CMAP_GID_NONE ? glyph_id : CMAP_GID_NONE;
+            }
+        }
+        else {
+            /*Clear the range as the letters not in the list have no glyphs, then find the first listed letter*/
+            for(letter = start; letter < end; letter++) page[letter - page_start] = 0;
+
+            const uint16_t * list = cmap->unicode_list;
+            uint32_t lo = 0;
+            uint32_t hi = cmap->list_length;
+            while(lo < hi) {
+                uint32_t mid = (lo + hi) / 2;
+                if(cmap->range_start + list[mid] < start) lo = mid + 1;
+                else hi = mid;
+            }
+
+            const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+            uint32_t k;
+            for(k = lo; k < cmap->list_length && cmap->range_start + list[k] < end; k++) {
+                uint32_t glyph_id = cmap->glyph_id_start;
+                if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) glyph_id += gid_ofs_16[k];
+                else glyph_id += k;
+                page[cmap->range_start + list[k] - page_start] = glyph_id < CMAP_GID_NONE ? glyph_id : CMAP_GID_NONE;
+            }
+        }
+    }
+
+    return page ? page : cmap_page_empty;
 }
+#endif /*LV_USE_FONT_CMAP_TABLE*/
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *) font->dsc;
+
+#if LV_FONT_KERN_CACHE_SIZE
+    /*The kerning classes are looked up directly, cache only the search in the kerning pairs*/
+    if(fdsc->kern_classes == 0 && gid_left <= 0xFFFF && gid_right <= 0xFFFF) {
+        lv_font_fmt_txt_kern_cache_t * cache = kern_cache_get(font);
+        if(cache) {
+            uint32_t pair = (gid_left << 16) + gid_right;
+            kern_cache_entry_t * e = &cache->entries[(gid_left * 31 + gid_right) & (LV_FONT_KERN_CACHE_SIZE - 1)];
+            if(e->pair != pair) {
+                e->pair = pair;
+                e->value = kern_lookup(fdsc, gid_left, gid_right);
+            }
+            return e->value;
+        }
+    }
+#endif
+
+    return kern_lookup(fdsc, gid_left, gid_right);
+}
+
+#if LV_FONT_KERN_ASCII_TABLE || LV_FONT_KERN_CACHE_SIZE
+/**
+ * Get the kerning cache of a font. Create it on the first call.
+ * @param font pointer to a font with kerning pairs
+ * @return pointer to the cache or NULL if out of memory
+ */
+static lv_font_fmt_txt_kern_cache_t * kern_cache_get(const lv_font_t * font)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+    if(fdsc->kern_cache) return fdsc->kern_cache;
+
+    lv_font_fmt_txt_kern_cache_t * cache = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_cache_t));
+    LV_ASSERT_MEM(cache);
+    if(cache == NULL) return NULL;
+    _lv_memset_00(cache, sizeof(lv_font_fmt_txt_kern_cache_t));
+
+#if LV_FONT_KERN_ASCII_TABLE
+    uint32_t gids[KERN_ASCII_CNT];
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < KERN_ASCII_CNT; i++) gids[i] = get_glyph_dsc_id(font, KERN_ASCII_FIRST + i);
+
+    for(i = 0; i < KERN_ASCII_CNT; i++) {
+        if(gids[i] == 0) continue;
+        for(j = 0; j < KERN_ASCII_CNT; j++) {
+            if(gids[j]) cache->ascii[i][j] = kern_lookup(fdsc, gids[i], gids[j]);
+        }
+    }
+#endif
 
+    fdsc->kern_cache = cache;
+    return cache;
+}
+#endif
+
+/**
+ * Search the kerning value of two glyphs in the font's kerning pairs or classes.
+ * @param fdsc pointer to a font descriptor with kerning
+ * @param gid_left id of the left glyph
+ * @param gid_right id of the right glyph
+ * @return the kerning value or 0 if the glyphs are not kerned
+ */
+static int8_t kern_lookup(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid_left, uint32_t gid_right)
+{
     int8_t value = 0;
 
     if(fdsc->kern_classes == 0) {
@@ -561,6 +925,110 @@ static inline uint8_t rle_next(void)
 
     return ret;
 }
+#if LV_FONT_GLYPH_CACHE_SIZE
+
+/**
+ * Find the decompressed bitmap of a glyph in the font's cache and mark it as the most recently used.
+ * @param fdsc pointer to a font descriptor
+ * @param gid id of the glyph
+ * @return pointer to the bitmap or NULL if not cached
+ */
+static const uint8_t * glyph_cache_get(lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->glyph_cache;
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(lv_font_fmt_txt_glyph_cache_t));
+        LV_ASSERT_MEM(cache);
+        if(cache == NULL) return NULL;
+        _lv_memset_00(cache, sizeof(lv_font_fmt_txt_glyph_cache_t));
+        _lv_memset_ff(cache->buckets, sizeof(cache->buckets));
+        lv_lru_t lru = _LV_LRU_INIT(cache->entries, LV_FONT_GLYPH_CACHE_SIZE, glyph_cache_size, glyph_cache_free);
+        cache->lru = lru;
+        fdsc->glyph_cache = cache;
+    }
+
+    uint16_t id = cache->buckets[gid & (GLYPH_CACHE_BUCKETS - 1)];
+    while(id != GLYPH_CACHE_NONE) {
+        glyph_cache_entry_t * e = &cache->entries[id];
+        if(e->gid == gid && e->data) {
+            cache->stats.hit++;
+            _lv_lru_use(&cache->lru, e);
+            return e->data;
+        }
+        id = e->hash_next;
+    }
+
+    cache->stats.miss++;
+    return NULL;
+}
+
+/**
+ * Add a glyph to the font's cache. Free the least recently used glyphs to fit into the budget.
+ * @param fdsc pointer to a font descriptor
+ * @param gid id of the glyph
+ * @param size size of the decompressed bitmap
+ * @return pointer where the bitmap should be decompressed or NULL if it can't be cached
+ */
+static uint8_t * glyph_cache_add(lv_font_fmt_txt_dsc_t * fdsc, uint32_t gid, uint32_t size)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->glyph_cache;
+    if(cache == NULL) return NULL;
+
+    glyph_cache_entry_t * e = _lv_lru_get_free(&cache->lru, size);
+    if(e == NULL) return NULL;
+
+    e->data = lv_mem_alloc(size);
+    LV_ASSERT_MEM(e->data);
+    if(e->data == NULL) return NULL;
+
+    uint16_t id = (uint16_t)(e - cache->entries);
+
+    /*Remove the entry from the bucket of the glyph it had before*/
+    if(e->gid) {
+        uint16_t * link = &cache->buckets[e->gid & (GLYPH_CACHE_BUCKETS - 1)];
+        while(*link != id) link = &cache->entries[*link].hash_next;
+        *link = e->hash_next;
+    }
+
+    e->gid = gid;
+    e->size = size;
+
+    uint16_t * bucket = &cache->buckets[gid & (GLYPH_CACHE_BUCKETS - 1)];
+    e->hash_next = *bucket;
+    *bucket = id;
+
+    _lv_lru_add(&cache->lru, e);
+    cache->add_cnt++;
+
+    return e->data;
+}
+
+/**
+ * Get the RAM used by a glyph of the cache
+ * @param entry pointer to a `glyph_cache_entry_t`
+ * @return size of the bitmap or 0 if the entry is unused
+ */
+static uint32_t glyph_cache_size(const void * entry)
+{
+    const glyph_cache_entry_t * e = entry;
+    return e->data ? e->size : 0;
+}
+
+/**
+ * Free the bitmap of a glyph. The entry stays in its bucket until it's reused.
+ * @param entry pointer to a `glyph_cache_entry_t`
+ */
+static void glyph_cache_free(void * entry)
+{
+    glyph_cache_entry_t * e = entry;
+    if(e->data) {
+        lv_mem_free(e->data);
+        e->data = NULL;
+    }
+}
+
+#endif /*LV_FONT_GLYPH_CACHE_SIZE*/
+
 #endif /* LV_USE_FONT_COMPRESSED */
 
 /** Code Comparator.
@@ -150,6 +150,18 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+/** Statistics of the decompressed glyph cache of a font*/
+typedef struct {
+    uint32_t hit;       /**< Number of bitmaps served from the cache*/
+    uint32_t miss;      /**< Number of bitmaps which needed to be decompressed*/
+    uint32_t evict;     /**< Number of glyphs dropped to make room for a new one*/
+    uint32_t mem_used;  /**< RAM used by the cached glyphs [bytes]*/
+    uint16_t entry_cnt; /**< Number of cached glyphs*/
+} lv_font_fmt_txt_glyph_cache_stats_t;
+
+struct _lv_font_fmt_txt_glyph_cache_t;
+struct _lv_font_fmt_txt_kern_cache_t;
+
 /*Describe store additional data for fonts */
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -190,6 +202,27 @@ typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
 
+    /* Get the bitmap of a glyph (as stored in the font) if `glyph_bitmap` is NULL.
+     * E.g. to read the bitmaps from a file on demand.
+     * The returned data needs to be valid only until the next call.*/
+    const uint8_t * (*get_bitmap_cb)(const lv_font_t * font, uint32_t gid);
+
+    /* The decompressed bitmaps of the recently used glyphs of compressed fonts.
+     * Allocated on the first use.*/
+    struct _lv_font_fmt_txt_glyph_cache_t * glyph_cache;
+
+    /* Glyph ids of the letters of the Basic Multilingual Plane in 256 pages of 256 letters.
+     * Built from the cmaps on the first use, page by page.*/
+    const uint16_t ** cmap_pages;
+
+    /* The recently used kerning values of the fonts with kerning pairs.
+     * Allocated on the first use.*/
+    struct _lv_font_fmt_txt_kern_cache_t * kern_cache;
+
+    /* The widths of the printable ASCII letters.
+     * Built on the first use.*/
+    lv_font_ascii_widths_t * ascii_widths;
+
 } lv_font_fmt_txt_dsc_t;
 
 /**********************
@@ -220,6 +253,26 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Get the widths of the printable ASCII letters of a font. Built on the first call.
+ * @param font pointer to a font in LittlevGL's native format
+ * @return pointer to the widths or NULL if they don't fit into the table or out of memory
+ */
+const lv_font_ascii_widths_t * lv_font_fmt_txt_get_ascii_widths(const lv_font_t * font);
+
+/**
+ * Free the decompressed glyphs, the glyph id lookup table, the kerning values and the ASCII widths cached for a font.
+ * @param font pointer to a font in LittlevGL's native format
+ */
+void lv_font_fmt_txt_glyph_cache_clean(const lv_font_t * font);
+
+/**
+ * Get the statistics of the decompressed glyph cache of a font.
+ * @param font pointer to a font in LittlevGL's native format
+ * @param stats store the statistics here (all zero if the font has no cache yet)
+ */
+void lv_font_fmt_txt_glyph_cache_get_stats(const lv_font_t * font, lv_font_fmt_txt_glyph_cache_stats_t * stats);
+
 /**********************
  *      MACROS
  **********************/
@@ -12,10 +12,18 @@
 
 #include "../lvgl.h"
 #include "../lv_misc/lv_fs.h"
+#include "../lv_misc/lv_lru.h"
 #include "lv_font_loader.h"
 
 #if LV_USE_FILESYSTEM
 
+/*********************
+ *      DEFINES
+ *********************/
+#define LAZY_PAGE_CNT   (LV_FONT_LAZY_CACHE_SIZE / LV_FONT_LAZY_PAGE_SIZE > 2 ? \
+                         LV_FONT_LAZY_CACHE_SIZE / LV_FONT_LAZY_PAGE_SIZE : 2)
+#define LAZY_PAGE_NONE  UINT32_MAX
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -62,11 +70,42 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+typedef struct {
+    lv_lru_entry_t lru;
+    uint8_t * data;     /*NULL: unused page*/
+    uint32_t index;     /*Index of the page in the glyph table or `LAZY_PAGE_NONE`*/
+} lazy_page_t;
+
+/*Font descriptor of the fonts loaded with `lv_font_load_lazy()`*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;  /*Has to be the first to use it as `lv_font_fmt_txt_dsc_t`*/
+    lv_fs_file_t file;          /*The font file kept open to read the glyph bitmaps*/
+    uint32_t glyph_start;       /*Position of the glyph table in the file*/
+    uint32_t glyph_length;      /*Size of the glyph table*/
+    uint32_t glyph_cnt;
+    uint8_t header_bits;        /*Size of the glyph header in front of each bitmap [bit]*/
+    uint32_t * glyph_end;       /*End of each glyph record if they are not in glyph id order, else NULL*/
+    const uint8_t * map;        /*The glyph table mapped into the memory or NULL if the pages are used*/
+    lazy_page_t pages[LAZY_PAGE_CNT];
+    lv_lru_t page_cache;        /*Keeps the least recently used `pages`*/
+    uint8_t * buf;              /*Bitmaps spanning more pages or not starting on byte boundary*/
+    uint32_t buf_size;
+} font_lazy_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_font_t * font_load(const char * font_name, bool lazy);
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
 static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static const uint8_t * lazy_get_bitmap(const lv_font_t * font, uint32_t gid);
+static const uint8_t * lazy_read(font_lazy_t * lazy, uint32_t ofs, uint32_t len);
+static uint8_t * lazy_page_get(font_lazy_t * lazy, uint32_t index);
+static uint32_t lazy_page_size(const void * entry);
+static void lazy_page_free(void * entry);
+static bool lazy_buf_reserve(font_lazy_t * lazy, uint32_t size);
+static int32_t find_glyph_ends(const uint32_t * glyph_offset, uint32_t * glyph_end, uint32_t loca_count,
+                               uint32_t glyph_length);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -87,36 +126,24 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
  */
 lv_font_t * lv_font_load(const char * font_name)
 {
-    bool success = false;
-
-    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
-    memset(font, 0, sizeof(lv_font_t));
-
-    lv_fs_file_t file;
-    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
-
-    if(res == LV_FS_RES_OK) {
-        success = lvgl_load_font(&file, font);
-
-        if(!success) {
-            LV_LOG_WARN("Error loading font file: %s\n", font_name);
-            /*
-            * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
-            * `lv_font_free` should free them correctly.
-            */
-            lv_font_free(font);
-            font = NULL;
-        }
-
-        lv_fs_close(&file);
-    }
+    return font_load(font_name, false);
+}
 
-    return font;
+/**
+ * Loads a `lv_font_t` object from a binary font file but leave the glyph bitmaps in the file.
+ * The file is kept open and the bitmaps are read on demand in `LV_FONT_LAZY_PAGE_SIZE` pages.
+ * The last used pages are cached up to `LV_FONT_LAZY_CACHE_SIZE` bytes.
+ * If the file system can map the file into the memory the bitmaps are used directly from there.
+ * @param font_name filename where the font file is located
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name)
+{
+    return font_load(font_name, true);
 }
 
 /**
- * Frees the memory allocated by the `lv_font_load()` function
+ * Frees the memory allocated by the `lv_font_load()` or `lv_font_load_lazy()` function
  * @param font lv_font_t object created by the lv_font_load function
  */
 void lv_font_free(lv_font_t * font)
@@ -126,6 +153,9 @@ void lv_font_free(lv_font_t * font)
 
         if(NULL != dsc) {
 
+            lv_font_fmt_txt_glyph_cache_clean(font);
+            lv_font_fallback_cache_clean();
+
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
                     (lv_font_fmt_txt_kern_pair_t *) dsc->kern_dsc;
@@ -177,6 +207,16 @@ void lv_font_free(lv_font_t * font)
             if(NULL != dsc->glyph_dsc) {
                 lv_mem_free((void *) dsc->glyph_dsc);
             }
+
+            if(dsc->get_bitmap_cb == lazy_get_bitmap) {
+                font_lazy_t * lazy = (font_lazy_t *) dsc;
+                for(uint32_t i = 0; i < LAZY_PAGE_CNT; i++) {
+                    if(lazy->pages[i].data) lv_mem_free(lazy->pages[i].data);
+                }
+                if(lazy->buf) lv_mem_free(lazy->buf);
+                if(lazy->glyph_end) lv_mem_free(lazy->glyph_end);
+                if(lazy->file.file_d) lv_fs_close(&lazy->file);
+            }
             lv_mem_free(dsc);
         }
         lv_mem_free(font);
@@ -187,6 +227,57 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
+static lv_font_t * font_load(const char * font_name, bool lazy)
+{
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    LV_ASSERT_MEM(font);
+    if(font == NULL) return NULL;
+    memset(font, 0, sizeof(lv_font_t));
+
+    lv_fs_file_t file;
+    lv_fs_file_t * fp = &file;
+    memset(&file, 0, sizeof(file));
+
+    /*The lazy fonts keep the file open in their descriptor*/
+    if(lazy) {
+        font_lazy_t * lazy_dsc = lv_mem_alloc(sizeof(font_lazy_t));
+        LV_ASSERT_MEM(lazy_dsc);
+        if(lazy_dsc == NULL) {
+            lv_mem_free(font);
+            return NULL;
+        }
+        memset(lazy_dsc, 0, sizeof(font_lazy_t));
+        lazy_dsc->dsc.get_bitmap_cb = lazy_get_bitmap;
+        font->dsc = lazy_dsc;
+        fp = &lazy_dsc->file;
+    }
+
+    lv_fs_res_t res = lv_fs_open(fp, font_name, LV_FS_MODE_RD);
+
+    if(res == LV_FS_RES_OK) {
+        bool success = lvgl_load_font(fp, font);
+
+        if(!success) {
+            LV_LOG_WARN("Error loading font file: %s\n", font_name);
+            /*
+            * When `lvgl_load_font` fails it can leak some pointers.
+            * All non-null pointers can be assumed as allocated and
+            * `lv_font_free` should free them correctly.
+            */
+            lv_font_free(font);
+            font = NULL;
+        }
+
+        if(!lazy) lv_fs_close(&file);
+    }
+    else if(lazy) {
+        lv_font_free(font);
+        font = NULL;
+    }
+
+    return font;
+}
+
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 {
     bit_iterator_t it;
@@ -341,13 +432,19 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
 }
 
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t * glyph_end, uint32_t loca_count,
+                          font_header_bin_t * header)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
         return -1;
     }
 
+    int32_t in_order = find_glyph_ends(glyph_offset, glyph_end, loca_count, glyph_length);
+    if(in_order < 0) {
+        return -1;
+    }
+
     lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)
                                               lv_mem_alloc(loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
 
@@ -355,6 +452,9 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
 
     font_dsc->glyph_dsc = glyph_dsc;
 
+    /*The lazy fonts store the position of the glyph records and read the bitmaps later*/
+    font_lazy_t * lazy = font_dsc->get_bitmap_cb == lazy_get_bitmap ? (font_lazy_t *) font_dsc : NULL;
+
     int cur_bmp_size = 0;
 
     for(unsigned int i = 0; i < loca_count; ++i) {
@@ -402,8 +502,7 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
 
         int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
+        int bmp_size = glyph_end[i] - glyph_offset[i] - nbits / 8;
 
         if(i == 0) {
             gdsc->adv_w = 0;
@@ -413,12 +512,43 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             gdsc->ofs_y = 0;
         }
 
+        if(lazy) {
+            gdsc->bitmap_index = glyph_offset[i];
+            continue;
+        }
+
         gdsc->bitmap_index = cur_bmp_size;
         if(gdsc->box_w * gdsc->box_h != 0) {
             cur_bmp_size += bmp_size;
         }
     }
 
+    if(lazy) {
+        lazy->glyph_start = start;
+        lazy->glyph_length = glyph_length;
+        lazy->glyph_cnt = loca_count;
+        lazy->header_bits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+
+        for(uint32_t i = 0; i < LAZY_PAGE_CNT; i++) lazy->pages[i].index = LAZY_PAGE_NONE;
+        lv_lru_t page_cache = _LV_LRU_INIT(lazy->pages, LAZY_PAGE_CNT * LV_FONT_LAZY_PAGE_SIZE,
+                                           lazy_page_size, lazy_page_free);
+        lazy->page_cache = page_cache;
+
+        /*Keep the ends of the records if they can't be found from the next glyph's offset*/
+        if(!in_order) {
+            lazy->glyph_end = lv_mem_alloc(loca_count * sizeof(uint32_t));
+            LV_ASSERT_MEM(lazy->glyph_end);
+            if(lazy->glyph_end == NULL) return -1;
+            _lv_memcpy(lazy->glyph_end, glyph_end, loca_count * sizeof(uint32_t));
+        }
+
+        /*Use the bitmaps directly from the file if it can be mapped*/
+        const void * map;
+        if(lv_fs_map(fp, start, glyph_length, &map) == LV_FS_RES_OK) lazy->map = map;
+
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *) lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -443,8 +573,7 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
             continue;
         }
 
-        int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
-        int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
+        int bmp_size = glyph_end[i] - glyph_offset[i] - nbits / 8;
 
         if(nbits % 8 == 0) {  /* Fast path */
             if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
@@ -458,7 +587,8 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
                     return -1;
                 }
             }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
+            /*The last bits of the record are the highest bits of the last byte*/
+            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res) << (nbits % 8);
             if(res != LV_FS_RES_OK) {
                 return -1;
             }
@@ -483,12 +613,13 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  */
 static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
-
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
-
-    font->dsc = font_dsc;
+    /*The lazy fonts already have a descriptor*/
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+    if(font_dsc == NULL) {
+        font_dsc = lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+        memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+        font->dsc = font_dsc;
+    }
 
     /* header */
     int32_t header_length = read_label(fp, 0, "head");
@@ -533,7 +664,8 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     }
 
     bool failed = false;
-    uint32_t * glyph_offset = lv_mem_alloc(sizeof(uint32_t) * (loca_count + 1));
+    /*The end of the glyph records are stored after their offsets*/
+    uint32_t * glyph_offset = lv_mem_alloc(sizeof(uint32_t) * (loca_count * 2 + 1));
 
     if(font_header.index_to_loc_format == 0) {
         for(unsigned int i = 0; i < loca_count; ++i) {
@@ -563,7 +695,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     /* glyph */
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+                               fp, font_dsc, glyph_start, glyph_offset, &glyph_offset[loca_count], loca_count, &font_header);
 
     lv_mem_free(glyph_offset);
 
@@ -681,4 +813,208 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
     return kern_length;
 }
 
+/**
+ * Get the bitmap of a glyph of a lazy font.
+ * Reads the glyph record from the file (or the mapping) and shifts it to byte boundary if required.
+ * @param font pointer to a font loaded by `lv_font_load_lazy()`
+ * @param gid id of the glyph
+ * @return pointer to the bitmap, valid until the next call, or NULL on error
+ */
+static const uint8_t * lazy_get_bitmap(const lv_font_t * font, uint32_t gid)
+{
+    font_lazy_t * lazy = (font_lazy_t *) font->dsc;
+    if(gid >= lazy->glyph_cnt) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = lazy->dsc.glyph_dsc;
+    uint32_t ofs = gdsc[gid].bitmap_index + lazy->header_bits / 8;
+    uint32_t end;
+    if(lazy->glyph_end) end = lazy->glyph_end[gid];
+    else end = gid + 1 < lazy->glyph_cnt ? gdsc[gid + 1].bitmap_index : lazy->glyph_length;
+    if(end <= ofs || end > lazy->glyph_length) return NULL;
+
+    uint32_t len = end - ofs;
+    const uint8_t * bitmap = lazy_read(lazy, ofs, len);
+    if(bitmap == NULL) return NULL;
+
+    uint8_t shift = lazy->header_bits % 8;
+    if(shift == 0) return bitmap;
+
+    /*The bitmap starts after the header's last bits. Shift it to start on byte boundary.
+     *It works in place too if the bitmap is already in `buf`.*/
+    if(bitmap != lazy->buf) {
+        if(!lazy_buf_reserve(lazy, len)) return NULL;
+    }
+
+    uint32_t k;
+    for(k = 0; k < len - 1; k++) {
+        lazy->buf[k] = (uint8_t)((bitmap[k] << shift) | (bitmap[k + 1] >> (8 - shift)));
+    }
+    lazy->buf[k] = (uint8_t)(bitmap[k] << shift);
+
+    return lazy->buf;
+}
+
+/**
+ * Get `len` bytes from the `ofs` position of the glyph table.
+ * @param lazy pointer to a lazy font descriptor
+ * @param ofs offset in the glyph table
+ * @param len number of bytes to get
+ * @return pointer to the data (in the mapping, a page or `buf`) or NULL on error
+ */
+static const uint8_t * lazy_read(font_lazy_t * lazy, uint32_t ofs, uint32_t len)
+{
+    if(lazy->map) return &lazy->map[ofs];
+
+    uint32_t page_ofs = ofs % LV_FONT_LAZY_PAGE_SIZE;
+    if(page_ofs + len <= LV_FONT_LAZY_PAGE_SIZE) {
+        uint8_t * page = lazy_page_get(lazy, ofs / LV_FONT_LAZY_PAGE_SIZE);
+        return page ? &page[page_ofs] : NULL;
+    }
+
+    /*Collect the parts from the pages*/
+    if(!lazy_buf_reserve(lazy, len)) return NULL;
+
+    uint32_t done = 0;
+    while(done < len) {
+        uint32_t pos = ofs + done;
+        uint8_t * page = lazy_page_get(lazy, pos / LV_FONT_LAZY_PAGE_SIZE);
+        if(page == NULL) return NULL;
+
+        page_ofs = pos % LV_FONT_LAZY_PAGE_SIZE;
+        uint32_t n = LV_MATH_MIN(LV_FONT_LAZY_PAGE_SIZE - page_ofs, len - done);
+        _lv_memcpy(&lazy->buf[done], &page[page_ofs], n);
+        done += n;
+    }
+
+    return lazy->buf;
+}
+
+/**
+ * Get a page of the glyph table. Read it from the file into the least recently used page if not cached.
+ * @param lazy pointer to a lazy font descriptor
+ * @param index index of the page
+ * @return pointer to the page's data or NULL on error
+ */
+static uint8_t * lazy_page_get(font_lazy_t * lazy, uint32_t index)
+{
+    uint32_t i;
+    for(i = 0; i < LAZY_PAGE_CNT; i++) {
+        lazy_page_t * p = &lazy->pages[i];
+        if(p->data && p->index == index) {
+            _lv_lru_use(&lazy->page_cache, p);
+            return p->data;
+        }
+    }
+
+    lazy_page_t * page = _lv_lru_get_free(&lazy->page_cache, LV_FONT_LAZY_PAGE_SIZE);
+    if(page == NULL) return NULL;
+
+    page->data = lv_mem_alloc(LV_FONT_LAZY_PAGE_SIZE);
+    LV_ASSERT_MEM(page->data);
+    if(page->data == NULL) return NULL;
+
+    /*The last page might be shorter. It's fine as only the bytes of the glyph table are used.*/
+    uint32_t rn;
+    if(lv_fs_seek(&lazy->file, lazy->glyph_start + index * LV_FONT_LAZY_PAGE_SIZE) != LV_FS_RES_OK ||
+       lv_fs_read(&lazy->file, page->data, LV_FONT_LAZY_PAGE_SIZE, &rn) != LV_FS_RES_OK ||
+       rn == 0) {
+        LV_LOG_WARN("lazy font: couldn't read page %d", index);
+        lazy_page_free(page);
+        return NULL;
+    }
+
+    page->index = index;
+    _lv_lru_add(&lazy->page_cache, page);
+
+    return page->data;
+}
+
+/**
+ * Get the RAM used by a page of a lazy font
+ * @param entry pointer to a `lazy_page_t`
+ * @return `LV_FONT_LAZY_PAGE_SIZE` or 0 if the page is unused
+ */
+static uint32_t lazy_page_size(const void * entry)
+{
+    const lazy_page_t * page = entry;
+    return page->data ? LV_FONT_LAZY_PAGE_SIZE : 0;
+}
+
+/**
+ * Free a page of a lazy font
+ * @param entry pointer to a `lazy_page_t`
+ */
+static void lazy_page_free(void * entry)
+{
+    lazy_page_t * page = entry;
+    lv_mem_free(page->data);
+    page->data = NULL;
+    page->index = LAZY_PAGE_NONE;
+}
+
+static bool lazy_buf_reserve(font_lazy_t * lazy, uint32_t size)
+{
+    if(lazy->buf_size >= size) return true;
+
+    uint8_t * buf = lv_mem_realloc(lazy->buf, size);
+    LV_ASSERT_MEM(buf);
+    if(buf == NULL) return false;
+
+    lazy->buf = buf;
+    lazy->buf_size = size;
+    return true;
+}
+
+/**
+ * Find the end of each glyph record. The records might be in any order in the glyph table,
+ * e.g. grouped by how often the glyphs are used to need less pages for a text.
+ * @param glyph_offset offset of the records
+ * @param glyph_end store the end of the records here
+ * @param loca_count number of records
+ * @param glyph_length size of the glyph table
+ * @return 1: the records are in glyph id order, 0: they are not, -1: out of memory
+ */
+static int32_t find_glyph_ends(const uint32_t * glyph_offset, uint32_t * glyph_end, uint32_t loca_count,
+                               uint32_t glyph_length)
+{
+    uint32_t i;
+    for(i = 0; i + 1 < loca_count && glyph_offset[i] < glyph_offset[i + 1]; i++) {
+        glyph_end[i] = glyph_offset[i + 1];
+    }
+
+    if(i + 1 >= loca_count) {
+        if(loca_count > 0) glyph_end[loca_count - 1] = glyph_length;
+        return 1;
+    }
+
+    /*Sort the glyph ids by offset (Shell sort) and take the next larger offset as the end*/
+    uint32_t * order = lv_mem_alloc(loca_count * sizeof(uint32_t));
+    LV_ASSERT_MEM(order);
+    if(order == NULL) return -1;
+
+    for(i = 0; i < loca_count; i++) order[i] = i;
+
+    uint32_t gap;
+    for(gap = loca_count / 2; gap > 0; gap /= 2) {
+        for(i = gap; i < loca_count; i++) {
+            uint32_t id = order[i];
+            uint32_t j;
+            for(j = i; j >= gap && glyph_offset[order[j - gap]] > glyph_offset[id]; j -= gap) {
+                order[j] = order[j - gap];
+            }
+            order[j] = id;
+        }
+    }
+
+    uint32_t end = glyph_length;
+    for(i = loca_count; i > 0; i--) {
+        uint32_t id = order[i - 1];
+        if(i < loca_count && glyph_offset[order[i]] > glyph_offset[id]) end = glyph_offset[order[i]];
+        glyph_end[id] = end;
+    }
+
+    lv_mem_free(order);
+    return 0;
+}
+
 #endif /*LV_USE_FILESYSTEM*/
@@ -29,6 +29,7 @@ extern "C" {
 #if LV_USE_FILESYSTEM
 
 lv_font_t * lv_font_load(const char * fontName);
+lv_font_t * lv_font_load_lazy(const char * fontName);
 void lv_font_free(lv_font_t * font);
 
 #endif
@@ -313,6 +313,27 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Get a pointer to a part of a file without copying it (e.g. from a memory mapped file).
+ * The data remains valid until the file is closed. The read write pointer is not changed.
+ * @param file_p pointer to a lv_fs_file_t variable opened for reading
+ * @param pos index of the first byte
+ * @param len number of bytes
+ * @param ptr store the pointer to the data here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum.
+ *         LV_FS_RES_NOT_IMP: the driver can't map the file, use `lv_fs_read` instead
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, uint32_t pos, uint32_t len, const void ** ptr)
+{
+    if(ptr == NULL) return LV_FS_RES_INV_PARAM;
+    *ptr = NULL;
+
+    if(file_p->drv == NULL) return LV_FS_RES_INV_PARAM;
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    return file_p->drv->map_cb(file_p->drv, file_p->file_d, pos, len, ptr);
+}
+
 /**
  * Rename a file
  * @param oldname path to the file
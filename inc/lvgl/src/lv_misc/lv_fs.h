@@ -75,6 +75,7 @@ typedef struct _lv_fs_drv_t {
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
     lv_fs_res_t (*trunc_cb)(struct _lv_fs_drv_t * drv, void * file_p);
     lv_fs_res_t (*size_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len, const void ** ptr);
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 
@@ -211,6 +212,18 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p);
  */
 lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Get a pointer to a part of a file without copying it (e.g. from a memory mapped file).
+ * The data remains valid until the file is closed. The read write pointer is not changed.
+ * @param file_p pointer to a lv_fs_file_t variable opened for reading
+ * @param pos index of the first byte
+ * @param len number of bytes
+ * @param ptr store the pointer to the data here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum.
+ *         LV_FS_RES_NOT_IMP: the driver can't map the file, use `lv_fs_read` instead
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, uint32_t pos, uint32_t len, const void ** ptr);
+
 /**
  * Rename a file
  * @param oldname path to the file
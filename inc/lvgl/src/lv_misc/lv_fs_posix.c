@@ -0,0 +1,582 @@
+/**
+ * @file lv_fs_posix.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_posix.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+
+#include "lv_debug.h"
+#include "lv_mem.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <dirent_port.h>
+    #define ftruncate _chsize
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+#endif
+
+#if LV_FS_POSIX_MMAP
+    #include <sys/mman.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef O_BINARY
+    #define O_BINARY 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    int fd;
+    lv_fs_mode_t mode;
+    uint32_t pos;           /*Position of the read write pointer*/
+    uint32_t fd_pos;        /*Position of `fd`'s own pointer*/
+    uint32_t size;          /*Size of the file if opened for reading*/
+#if LV_FS_POSIX_CACHE_SIZE
+    uint8_t * buf;          /*Read-ahead buffer of files opened for reading*/
+    uint32_t buf_pos;       /*Position of `buf[0]` in the file*/
+    uint32_t buf_len;       /*Number of valid bytes in `buf`*/
+#endif
+#if LV_FS_POSIX_MMAP
+    void * map;             /*The whole file if mapped by `lv_fs_map()`*/
+#endif
+#if LV_FS_POSIX_HANDLE_CACHE
+    char * path;            /*Path of files opened for reading to find them in the handle cache*/
+#endif
+} posix_file_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t fs_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_remove(lv_fs_drv_t * drv, const char * path);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_trunc(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+#if LV_FS_POSIX_MMAP
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len, const void ** ptr);
+#endif
+static lv_fs_res_t fs_rename(lv_fs_drv_t * drv, const char * oldname, const char * newname);
+static lv_fs_res_t fs_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path);
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn);
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * rddir_p);
+
+static bool posix_path(char * buf, const char * path);
+static long posix_read(posix_file_t * f, void * buf, uint32_t btr);
+static void posix_release(posix_file_t * f);
+static lv_fs_res_t posix_res(int err);
+#if LV_FS_POSIX_HANDLE_CACHE
+    static void handle_cache_drop(const char * path);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_FS_POSIX_HANDLE_CACHE
+    /*The closed files kept open, the most recently closed first. `path == NULL`: empty entry*/
+    static posix_file_t handle_cache[LV_FS_POSIX_HANDLE_CACHE];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register a file system driver with `LV_FS_POSIX_LETTER` for the files under `LV_FS_POSIX_PATH`.
+ * Small reads are served from a read-ahead buffer of `LV_FS_POSIX_CACHE_SIZE` bytes per file.
+ * The last `LV_FS_POSIX_HANDLE_CACHE` files closed after reading are kept open (with their buffer)
+ * so opening them again costs no system call.
+ * With `LV_FS_POSIX_MMAP` `lv_fs_map()` maps the files into the memory.
+ */
+void lv_fs_posix_init(void)
+{
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = LV_FS_POSIX_LETTER;
+    drv.file_size = sizeof(posix_file_t);
+    drv.rddir_size = sizeof(DIR *);
+    drv.open_cb = fs_open;
+    drv.close_cb = fs_close;
+    drv.remove_cb = fs_remove;
+    drv.read_cb = fs_read;
+    drv.write_cb = fs_write;
+    drv.seek_cb = fs_seek;
+    drv.tell_cb = fs_tell;
+    drv.trunc_cb = fs_trunc;
+    drv.size_cb = fs_size;
+#if LV_FS_POSIX_MMAP
+    drv.map_cb = fs_map;
+#endif
+    drv.rename_cb = fs_rename;
+    drv.dir_open_cb = fs_dir_open;
+    drv.dir_read_cb = fs_dir_read;
+    drv.dir_close_cb = fs_dir_close;
+
+    lv_fs_drv_register(&drv);
+}
+
+/**
+ * Close the files kept open after `lv_fs_close()`.
+ * Call it if the files might have been changed by other means than `lv_fs`.
+ */
+void lv_fs_posix_cache_clean(void)
+{
+#if LV_FS_POSIX_HANDLE_CACHE
+    handle_cache_drop(NULL);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_fs_res_t fs_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    char real_path[LV_FS_MAX_PATH_LENGTH];
+    if(posix_path(real_path, path) == false) return LV_FS_RES_INV_PARAM;
+
+    _lv_memset_00(f, sizeof(posix_file_t));
+
+#if LV_FS_POSIX_HANDLE_CACHE
+    if(mode == LV_FS_MODE_RD) {
+        uint32_t i;
+        for(i = 0; i < LV_FS_POSIX_HANDLE_CACHE && handle_cache[i].path; i++) {
+            if(strcmp(handle_cache[i].path, real_path) == 0) {
+                *f = handle_cache[i];
+                f->pos = 0;
+                for(; i < LV_FS_POSIX_HANDLE_CACHE - 1; i++) handle_cache[i] = handle_cache[i + 1];
+                handle_cache[LV_FS_POSIX_HANDLE_CACHE - 1].path = NULL;
+                return LV_FS_RES_OK;
+            }
+        }
+    }
+    else {
+        /*The kept open files would see the changes only partially through their buffer*/
+        handle_cache_drop(real_path);
+    }
+#endif
+
+    int flags;
+    if(mode == LV_FS_MODE_WR) flags = O_WRONLY | O_CREAT;
+    else if(mode == LV_FS_MODE_RD) flags = O_RDONLY;
+    else flags = O_RDWR | O_CREAT;
+
+    f->fd = open(real_path, flags | O_BINARY, 0666);
+    if(f->fd < 0) return posix_res(errno);
+    f->mode = mode;
+
+    if(mode == LV_FS_MODE_RD) {
+        struct stat st;
+        if(fstat(f->fd, &st) != 0) {
+            lv_fs_res_t res = posix_res(errno);
+            close(f->fd);
+            return res;
+        }
+        f->size = st.st_size;
+
+        /*Without a buffer the reads are simply not buffered*/
+#if LV_FS_POSIX_CACHE_SIZE
+        f->buf = lv_mem_alloc(LV_FS_POSIX_CACHE_SIZE);
+#endif
+#if LV_FS_POSIX_HANDLE_CACHE
+        size_t len = strlen(real_path) + 1;
+        f->path = lv_mem_alloc(len);
+        if(f->path) _lv_memcpy(f->path, real_path, len);
+#endif
+    }
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+
+#if LV_FS_POSIX_HANDLE_CACHE
+    if(f->path) {
+        if(handle_cache[LV_FS_POSIX_HANDLE_CACHE - 1].path) posix_release(&handle_cache[LV_FS_POSIX_HANDLE_CACHE - 1]);
+        uint32_t i;
+        for(i = LV_FS_POSIX_HANDLE_CACHE - 1; i > 0; i--) handle_cache[i] = handle_cache[i - 1];
+        handle_cache[0] = *f;
+        return LV_FS_RES_OK;
+    }
+#endif
+
+    posix_release(f);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_remove(lv_fs_drv_t * drv, const char * path)
+{
+    LV_UNUSED(drv);
+
+    char real_path[LV_FS_MAX_PATH_LENGTH];
+    if(posix_path(real_path, path) == false) return LV_FS_RES_INV_PARAM;
+
+#if LV_FS_POSIX_HANDLE_CACHE
+    handle_cache_drop(real_path);
+#endif
+
+    if(remove(real_path) != 0) return posix_res(errno);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    uint8_t * out = buf;
+    *br = 0;
+
+#if LV_FS_POSIX_MMAP
+    if(f->map) {
+        if(f->pos >= f->size) return LV_FS_RES_OK;
+        if(btr > f->size - f->pos) btr = f->size - f->pos;
+        _lv_memcpy(out, (uint8_t *)f->map + f->pos, btr);
+        f->pos += btr;
+        *br = btr;
+        return LV_FS_RES_OK;
+    }
+#endif
+
+    while(btr > 0) {
+#if LV_FS_POSIX_CACHE_SIZE
+        if(f->buf) {
+            if(f->pos >= f->buf_pos && f->pos < f->buf_pos + f->buf_len) {
+                uint32_t n = f->buf_pos + f->buf_len - f->pos;
+                if(n > btr) n = btr;
+                _lv_memcpy(out, &f->buf[f->pos - f->buf_pos], n);
+                out += n;
+                btr -= n;
+                f->pos += n;
+                *br += n;
+                continue;
+            }
+
+            /*Read ahead for small reads. The large ones go directly to the caller's buffer*/
+            if(btr < LV_FS_POSIX_CACHE_SIZE) {
+                long n = posix_read(f, f->buf, LV_FS_POSIX_CACHE_SIZE);
+                if(n < 0) return posix_res(errno);
+                f->buf_pos = f->pos;
+                f->buf_len = n;
+                if(n == 0) break;
+                continue;
+            }
+        }
+#endif
+
+        long n = posix_read(f, out, btr);
+        if(n < 0) return posix_res(errno);
+        if(n == 0) break;
+        out += n;
+        btr -= n;
+        f->pos += n;
+        *br += n;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    *bw = 0;
+
+    if(f->fd_pos != f->pos) {
+        if(lseek(f->fd, f->pos, SEEK_SET) < 0) return posix_res(errno);
+        f->fd_pos = f->pos;
+    }
+
+    long n = write(f->fd, buf, btw);
+    if(n < 0) return posix_res(errno);
+
+    f->pos += n;
+    f->fd_pos = f->pos;
+    *bw = n;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    LV_UNUSED(drv);
+
+    /*`fd` is moved only by the next read or write*/
+    posix_file_t * f = file_p;
+    f->pos = pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    *pos_p = f->pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_trunc(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    if(f->mode == LV_FS_MODE_RD) return LV_FS_RES_DENIED;
+
+    if(ftruncate(f->fd, f->pos) != 0) return posix_res(errno);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    if(f->mode == LV_FS_MODE_RD) {
+        *size_p = f->size;
+        return LV_FS_RES_OK;
+    }
+
+    struct stat st;
+    if(fstat(f->fd, &st) != 0) return posix_res(errno);
+    *size_p = st.st_size;
+    return LV_FS_RES_OK;
+}
+
+#if LV_FS_POSIX_MMAP
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len, const void ** ptr)
+{
+    LV_UNUSED(drv);
+
+    posix_file_t * f = file_p;
+    if(f->mode != LV_FS_MODE_RD || f->size == 0) return LV_FS_RES_NOT_IMP;
+    if(pos > f->size || len > f->size - pos) return LV_FS_RES_INV_PARAM;
+
+    if(f->map == NULL) {
+        void * map = mmap(NULL, f->size, PROT_READ, MAP_PRIVATE, f->fd, 0);
+        if(map == MAP_FAILED) return LV_FS_RES_NOT_IMP;
+        f->map = map;
+
+        /*The reads are served from the mapping from now on*/
+#if LV_FS_POSIX_CACHE_SIZE
+        lv_mem_free(f->buf);
+        f->buf = NULL;
+        f->buf_len = 0;
+#endif
+    }
+
+    *ptr = (uint8_t *)f->map + pos;
+    return LV_FS_RES_OK;
+}
+#endif
+
+static lv_fs_res_t fs_rename(lv_fs_drv_t * drv, const char * oldname, const char * newname)
+{
+    LV_UNUSED(drv);
+
+    char old_path[LV_FS_MAX_PATH_LENGTH];
+    char new_path[LV_FS_MAX_PATH_LENGTH];
+    if(posix_path(old_path, oldname) == false || posix_path(new_path, newname) == false) return LV_FS_RES_INV_PARAM;
+
+#if LV_FS_POSIX_HANDLE_CACHE
+    handle_cache_drop(old_path);
+    handle_cache_drop(new_path);
+#endif
+
+    if(rename(old_path, new_path) != 0) return posix_res(errno);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path)
+{
+    LV_UNUSED(drv);
+
+    char real_path[LV_FS_MAX_PATH_LENGTH];
+    if(posix_path(real_path, path) == false) return LV_FS_RES_INV_PARAM;
+
+    DIR * d = opendir(real_path);
+    if(d == NULL) return posix_res(errno);
+
+    *(DIR **)rddir_p = d;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn)
+{
+    LV_UNUSED(drv);
+
+    DIR * d = *(DIR **)rddir_p;
+    struct dirent * entry;
+
+    do {
+        entry = readdir(d);
+        if(entry == NULL) {
+            fn[0] = '\0';
+            return LV_FS_RES_OK;
+        }
+    } while(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0);
+
+    /*The name of the directories begin with '/'*/
+    size_t i = 0;
+    if(entry->d_type == DT_DIR) fn[i++] = '/';
+    size_t len = strlen(entry->d_name);
+    if(len > LV_FS_MAX_FN_LENGTH - 1 - i) len = LV_FS_MAX_FN_LENGTH - 1 - i;
+    _lv_memcpy(&fn[i], entry->d_name, len);
+    fn[i + len] = '\0';
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * rddir_p)
+{
+    LV_UNUSED(drv);
+
+    DIR * d = *(DIR **)rddir_p;
+    if(closedir(d) != 0) return posix_res(errno);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Prepend `LV_FS_POSIX_PATH` to a path
+ * @param buf store the result here (`LV_FS_MAX_PATH_LENGTH` bytes)
+ * @param path the path without the driver letter
+ * @return false: the path is too long
+ */
+static bool posix_path(char * buf, const char * path)
+{
+    size_t prefix_len = strlen(LV_FS_POSIX_PATH);
+    size_t len = strlen(path);
+    if(prefix_len + len >= LV_FS_MAX_PATH_LENGTH) return false;
+
+    _lv_memcpy(buf, LV_FS_POSIX_PATH, prefix_len);
+    _lv_memcpy(&buf[prefix_len], path, len + 1);
+    return true;
+}
+
+/**
+ * Read from the read write pointer of a file without moving it
+ * @param f pointer to a file
+ * @param buf store the bytes here
+ * @param btr number of bytes to read
+ * @return number of bytes read or -1 on error
+ */
+static long posix_read(posix_file_t * f, void * buf, uint32_t btr)
+{
+    if(f->fd_pos != f->pos) {
+        if(lseek(f->fd, f->pos, SEEK_SET) < 0) return -1;
+        f->fd_pos = f->pos;
+    }
+
+    long n = read(f->fd, buf, btr);
+    if(n > 0) f->fd_pos += n;
+    return n;
+}
+
+/**
+ * Close a file and free its resources
+ * @param f pointer to a file
+ */
+static void posix_release(posix_file_t * f)
+{
+#if LV_FS_POSIX_HANDLE_CACHE
+    lv_mem_free(f->path);
+    f->path = NULL;
+#endif
+#if LV_FS_POSIX_MMAP
+    if(f->map) munmap(f->map, f->size);
+    f->map = NULL;
+#endif
+#if LV_FS_POSIX_CACHE_SIZE
+    lv_mem_free(f->buf);
+    f->buf = NULL;
+#endif
+    close(f->fd);
+    f->fd = -1;
+}
+
+#if LV_FS_POSIX_HANDLE_CACHE
+/**
+ * Close the kept open files of a path
+ * @param path path of the file or NULL to close all
+ */
+static void handle_cache_drop(const char * path)
+{
+    uint32_t i = 0;
+    while(i < LV_FS_POSIX_HANDLE_CACHE && handle_cache[i].path) {
+        if(path && strcmp(handle_cache[i].path, path)) {
+            i++;
+            continue;
+        }
+
+        posix_release(&handle_cache[i]);
+        uint32_t j;
+        for(j = i; j < LV_FS_POSIX_HANDLE_CACHE - 1; j++) handle_cache[j] = handle_cache[j + 1];
+        handle_cache[LV_FS_POSIX_HANDLE_CACHE - 1].path = NULL;
+    }
+}
+#endif
+
+/**
+ * Convert an `errno` to `lv_fs_res_t`
+ * @param err the error code
+ * @return the matching result
+ */
+static lv_fs_res_t posix_res(int err)
+{
+    switch(err) {
+        case ENOENT:
+        case ENOTDIR:
+            return LV_FS_RES_NOT_EX;
+        case EACCES:
+        case EPERM:
+        case EROFS:
+            return LV_FS_RES_DENIED;
+        case ENOSPC:
+            return LV_FS_RES_FULL;
+        case ENOMEM:
+            return LV_FS_RES_OUT_OF_MEM;
+        case EBUSY:
+            return LV_FS_RES_BUSY;
+        case EIO:
+            return LV_FS_RES_HW_ERR;
+        case EINVAL:
+        case ENAMETOOLONG:
+            return LV_FS_RES_INV_PARAM;
+        default:
+            return LV_FS_RES_FS_ERR;
+    }
+}
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_POSIX*/
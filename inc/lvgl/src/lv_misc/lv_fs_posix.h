@@ -0,0 +1,59 @@
+/**
+ * @file lv_fs_posix.h
+ *
+ */
+
+#ifndef LV_FS_POSIX_H
+#define LV_FS_POSIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_POSIX
+
+#include "lv_fs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register a file system driver with `LV_FS_POSIX_LETTER` for the files under `LV_FS_POSIX_PATH`.
+ * Small reads are served from a read-ahead buffer of `LV_FS_POSIX_CACHE_SIZE` bytes per file.
+ * The last `LV_FS_POSIX_HANDLE_CACHE` files closed after reading are kept open (with their buffer)
+ * so opening them again costs no system call.
+ * With `LV_FS_POSIX_MMAP` `lv_fs_map()` maps the files into the memory.
+ */
+void lv_fs_posix_init(void);
+
+/**
+ * Close the files kept open after `lv_fs_close()`.
+ * Call it if the files might have been changed by other means than `lv_fs`.
+ */
+void lv_fs_posix_cache_clean(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_POSIX*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FS_POSIX_H*/
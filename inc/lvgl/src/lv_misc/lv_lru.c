@@ -0,0 +1,107 @@
+/**
+ * @file lv_lru.c
+ * Keep the least recently used entries of a fixed array of buffers within a RAM budget.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_lru.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Mark an entry as the most recently used
+ * @param lru pointer to a cache
+ * @param entry pointer to an entry of the cache
+ */
+void _lv_lru_use(lv_lru_t * lru, void * entry)
+{
+    lru->time++;
+    ((lv_lru_entry_t *)entry)->life = lru->time;
+}
+
+/**
+ * Get an unused entry for a new buffer.
+ * Free the least recently used entries until there is an unused entry and enough RAM for the buffer.
+ * @param lru pointer to a cache
+ * @param size size of the new buffer in bytes
+ * @return an unused entry or NULL if `size` is larger than the budget
+ */
+void * _lv_lru_get_free(lv_lru_t * lru, uint32_t size)
+{
+    if(size > lru->budget) return NULL;
+
+    while(true) {
+        lv_lru_entry_t * lru_e = NULL;
+        lv_lru_entry_t * free_e = NULL;
+        uint8_t * p = lru->entries;
+        uint32_t i;
+        for(i = 0; i < lru->entry_num; i++, p += lru->entry_size) {
+            lv_lru_entry_t * e = (lv_lru_entry_t *)p;
+            if(lru->size_cb(e) == 0) {
+                if(free_e == NULL) free_e = e;
+            }
+            else if(lru_e == NULL || lru->time - e->life > lru->time - lru_e->life) {
+                lru_e = e;
+            }
+        }
+
+        if(free_e && lru->used + size <= lru->budget) return free_e;
+
+        if(lru_e == NULL) return NULL;
+
+        lru->used -= lru->size_cb(lru_e);
+        lru->free_cb(lru_e);
+    }
+}
+
+/**
+ * Add an entry got with `_lv_lru_get_free` to the cache after its buffer is allocated
+ * @param lru pointer to a cache
+ * @param entry pointer to the entry
+ */
+void _lv_lru_add(lv_lru_t * lru, void * entry)
+{
+    lru->used += lru->size_cb(entry);
+    _lv_lru_use(lru, entry);
+}
+
+/**
+ * Free an entry out of the LRU order, e.g. because its source has changed
+ * @param lru pointer to a cache
+ * @param entry pointer to an entry of the cache
+ */
+void _lv_lru_drop(lv_lru_t * lru, void * entry)
+{
+    lru->used -= lru->size_cb(entry);
+    lru->free_cb(entry);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
@@ -0,0 +1,101 @@
+/**
+ * @file lv_lru.h
+ * Keep the least recently used entries of a fixed array of buffers within a RAM budget.
+ */
+
+#ifndef LV_LRU_H
+#define LV_LRU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The first member of the entries of an `lv_lru_t`*/
+typedef struct {
+    uint32_t life;      /*The last time (`lv_lru_t`'s `time`) the entry was used*/
+} lv_lru_entry_t;
+
+/** Get the bytes allocated for an entry. 0: unused entry*/
+typedef uint32_t (*lv_lru_size_cb_t)(const void * entry);
+
+/** Free the buffers of an entry and mark it unused*/
+typedef void (*lv_lru_free_cb_t)(void * entry);
+
+/** Description of a cache. Initialize it with `_LV_LRU_INIT`*/
+typedef struct {
+    void * entries;             /*Array of the entries*/
+    uint32_t entry_size;
+    uint32_t entry_num;
+    uint32_t budget;            /*The bytes the entries can use together*/
+    lv_lru_size_cb_t size_cb;
+    lv_lru_free_cb_t free_cb;
+    uint32_t used;              /*The bytes used by the entries*/
+    uint32_t time;              /*Incremented on every use to find the least recently used entry*/
+} lv_lru_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Mark an entry as the most recently used
+ * @param lru pointer to a cache
+ * @param entry pointer to an entry of the cache
+ */
+void _lv_lru_use(lv_lru_t * lru, void * entry);
+
+/**
+ * Get an unused entry for a new buffer.
+ * Free the least recently used entries until there is an unused entry and enough RAM for the buffer.
+ * @param lru pointer to a cache
+ * @param size size of the new buffer in bytes
+ * @return an unused entry or NULL if `size` is larger than the budget
+ */
+void * _lv_lru_get_free(lv_lru_t * lru, uint32_t size);
+
+/**
+ * Add an entry got with `_lv_lru_get_free` to the cache after its buffer is allocated
+ * @param lru pointer to a cache
+ * @param entry pointer to the entry
+ */
+void _lv_lru_add(lv_lru_t * lru, void * entry);
+
+/**
+ * Free an entry out of the LRU order, e.g. because its source has changed
+ * @param lru pointer to a cache
+ * @param entry pointer to an entry of the cache
+ */
+void _lv_lru_drop(lv_lru_t * lru, void * entry);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**
+ * Initializer of an `lv_lru_t`
+ * @param entries an array whose elements start with `lv_lru_entry_t`
+ * @param budget the bytes the entries can use together
+ * @param size_cb an `lv_lru_size_cb_t`
+ * @param free_cb an `lv_lru_free_cb_t`
+ */
+#define _LV_LRU_INIT(entries, budget, size_cb, free_cb) \
+    {(entries), sizeof((entries)[0]), sizeof(entries) / sizeof((entries)[0]), (budget), (size_cb), (free_cb), 0, 0}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_LRU_H*/
@@ -1,9 +1,11 @@
 CSRCS += lv_area.c
 CSRCS += lv_task.c
 CSRCS += lv_fs.c
+CSRCS += lv_fs_posix.c
 CSRCS += lv_anim.c
 CSRCS += lv_mem.c
 CSRCS += lv_ll.c
+CSRCS += lv_lru.c
 CSRCS += lv_color.c
 CSRCS += lv_txt.c
 CSRCS += lv_txt_ap.c
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include <stdarg.h>
+#include <string.h>
 #include "lv_txt.h"
 #include "lv_txt_ap.h"
 #include "lv_math.h"
@@ -26,6 +27,12 @@
  *  STATIC PROTOTYPES
  **********************/
 static inline bool is_break_char(uint32_t letter);
+static inline uint32_t txt_next(const char * txt, uint32_t * i);
+static inline lv_coord_t txt_glyph_width(const lv_font_t * font, const lv_font_ascii_widths_t * ascii_widths,
+                                         uint32_t letter, uint32_t letter_next);
+#if LV_FONT_ASCII_WIDTHS
+    static uint32_t ascii_run_len(const char * txt, uint32_t max_len, bool recolor);
+#endif
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -189,13 +196,14 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
     uint32_t word_len = 0;   /* Number of characters in the transversed word */
     uint32_t break_index = NO_BREAK_FOUND; /* only used for "long" words */
     uint32_t break_letter_count = 0; /* Number of characters up to the long word break point */
+    const lv_font_ascii_widths_t * ascii_widths = _lv_font_get_ascii_widths(font);
 
-    letter = _lv_txt_encoded_next(txt, &i_next);
+    letter = txt_next(txt, &i_next);
     i_next_next = i_next;
 
     /* Obtain the full word, regardless if it fits or not in max_width */
     while(txt[i] != '\0') {
-        letter_next = _lv_txt_encoded_next(txt, &i_next_next);
+        letter_next = txt_next(txt, &i_next_next);
         word_len++;
 
         /*Handle the recolor command*/
@@ -208,7 +216,7 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
             }
         }
 
-        letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+        letter_w = txt_glyph_width(font, ascii_widths, letter, letter_next);
         cur_w += letter_w;
 
         if(letter_w > 0) {
@@ -364,7 +372,26 @@ lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t
     lv_txt_cmd_state_t cmd_state = LV_TXT_CMD_STATE_WAIT;
 
     if(length != 0) {
+#if LV_FONT_ASCII_WIDTHS
+        const lv_font_ascii_widths_t * ascii_widths = _lv_font_get_ascii_widths(font);
+#endif
         while(i < length) {
+#if LV_FONT_ASCII_WIDTHS
+            /*Measure the runs of printable ASCII letters from the width table of the font.
+             *Outside of the color parameters only the command character needs the slow path.*/
+            if(ascii_widths && cmd_state != LV_TXT_CMD_STATE_PAR) {
+                uint32_t run_end = i + ascii_run_len(&txt[i], length - i, (flag & LV_TXT_FLAG_RECOLOR) != 0);
+                for(; i < run_end; i++) {
+                    int32_t char_width = _lv_font_get_ascii_width(ascii_widths, (uint8_t)txt[i], (uint8_t)txt[i + 1]);
+                    if(char_width < 0) break;   /*Kerned with a letter which is not in the table*/
+                    if(char_width > 0) {
+                        width += char_width;
+                        width += letter_space;
+                    }
+                }
+                if(i >= length) break;
+            }
+#endif
             uint32_t letter      = _lv_txt_encoded_next(txt, &i);
             uint32_t letter_next = _lv_txt_encoded_next(&txt[i], NULL);
             if((flag & LV_TXT_FLAG_RECOLOR) != 0) {
@@ -910,3 +937,78 @@ static inline bool is_break_char(uint32_t letter)
 
     return ret;
 }
+
+/**
+ * Decode the next letter of a text. The printable ASCII letters are their own code
+ * so only the other letters go through the decoder of the text encoding.
+ * @param txt pointer to a text
+ * @param i start byte index in 'txt' where to start. After the call it will point to the next letter
+ * @return the decoded letter
+ */
+static inline uint32_t txt_next(const char * txt, uint32_t * i)
+{
+    uint8_t c = (uint8_t)txt[*i];
+    if((uint32_t)c - LV_FONT_ASCII_FIRST < LV_FONT_ASCII_CNT) {
+        (*i)++;
+        return c;
+    }
+
+    return _lv_txt_encoded_next(txt, i);
+}
+
+/**
+ * Get the width of a glyph with kerning. Take it from the ASCII width table of the font if possible.
+ * @param font pointer to a font
+ * @param ascii_widths the ASCII widths of `font` or NULL
+ * @param letter an UNICODE letter
+ * @param letter_next the next letter after `letter`. Used for kerning
+ * @return the width of the glyph
+ */
+static inline lv_coord_t txt_glyph_width(const lv_font_t * font, const lv_font_ascii_widths_t * ascii_widths,
+                                         uint32_t letter, uint32_t letter_next)
+{
+    if(ascii_widths) {
+        int32_t w = _lv_font_get_ascii_width(ascii_widths, letter, letter_next);
+        if(w >= 0) return w;
+    }
+
+    return lv_font_get_glyph_width(font, letter, letter_next);
+}
+
+#if LV_FONT_ASCII_WIDTHS
+/**
+ * Get the number of printable ASCII letters at the beginning of a text.
+ * Checks 4 bytes at once while at least 4 bytes are left.
+ * @param txt pointer to a text
+ * @param max_len check at most this many bytes
+ * @param recolor true: stop at the command character of recoloring too
+ * @return the length of the run [bytes]
+ */
+static uint32_t ascii_run_len(const char * txt, uint32_t max_len, bool recolor)
+{
+    uint32_t cmd = (uint8_t)LV_TXT_COLOR_CMD[0] * 0x01010101U;
+    uint32_t i = 0;
+
+    while(i + 4 <= max_len) {
+        uint32_t v;
+        memcpy(&v, &txt[i], sizeof(v));
+        /*A byte is not printable if it's less than 0x20 or it's at least 0x7F.
+         *A borrow or carry between the bytes is possible only after such a byte.*/
+        if(((v - 0x20202020U) | (v + 0x01010101U) | v) & 0x80808080U) break;
+        if(recolor) {
+            uint32_t x = v ^ cmd;
+            if((x - 0x01010101U) & ~x & 0x80808080U) break;
+        }
+        i += 4;
+    }
+
+    while(i < max_len) {
+        uint8_t c = (uint8_t)txt[i];
+        if((uint32_t)c - LV_FONT_ASCII_FIRST >= LV_FONT_ASCII_CNT) break;
+        if(recolor && c == (uint8_t)LV_TXT_COLOR_CMD[0]) break;
+        i++;
+    }
+
+    return i;
+}
+#endif
@@ -233,12 +233,42 @@ void lv_arc_set_angles(lv_obj_t * arc, uint16_t start, uint16_t end)
     if(start > 360) start -= 360;
     if(end > (start + 360)) end = start + 360;
 
-    inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end, LV_ARC_PART_INDIC);
+    /*Normalize the angles to [0..360) and get the length of the arcs*/
+    int32_t start_old = ext->arc_angle_start % 360;
+    int32_t end_old = ext->arc_angle_end % 360;
+    int32_t start_new = start % 360;
+    int32_t end_new = end % 360;
+    int32_t len_old = ext->arc_angle_end - ext->arc_angle_start;
+    int32_t len_new = end - start;
+    if(len_old < 0) len_old += 360;
+    if(len_new < 0) len_new += 360;
+
+    /*Get the shortest moves of the start and end angles (positive: clockwise)*/
+    int32_t start_diff = start_new - start_old;
+    int32_t end_diff = end_new - end_old;
+    if(start_diff > 180) start_diff -= 360;
+    else if(start_diff < -180) start_diff += 360;
+    if(end_diff > 180) end_diff -= 360;
+    else if(end_diff < -180) end_diff += 360;
+
+    /* If the arc just grows, shrinks or rotates a little (e.g. in every step of a spinner's animation)
+     * only the areas swept by the start and end angles have changed*/
+    if(len_old > 0 && len_old < 360 && len_new > 0 && len_new < 360 &&
+       LV_MATH_ABS(start_diff) < 180 && LV_MATH_ABS(end_diff) < 180 &&
+       len_new == len_old + end_diff - start_diff) {
+        if(start_diff > 0) inv_arc_area(arc, start_old, start_new, LV_ARC_PART_INDIC);
+        else if(start_diff < 0) inv_arc_area(arc, start_new, start_old, LV_ARC_PART_INDIC);
+
+        if(end_diff > 0) inv_arc_area(arc, end_old, end_new, LV_ARC_PART_INDIC);
+        else if(end_diff < 0) inv_arc_area(arc, end_new, end_old, LV_ARC_PART_INDIC);
+    }
+    else {
+        inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end, LV_ARC_PART_INDIC);
+        inv_arc_area(arc, start, end, LV_ARC_PART_INDIC);
+    }
 
     ext->arc_angle_start = start;
     ext->arc_angle_end = end;
-
-    inv_arc_area(arc, ext->arc_angle_start, ext->arc_angle_end, LV_ARC_PART_INDIC);
 }
 
 /**
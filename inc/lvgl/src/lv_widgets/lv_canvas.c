@@ -11,6 +11,7 @@
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_img_cache.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_themes/lv_theme.h"
 
@@ -147,6 +148,7 @@ void lv_canvas_set_buffer(lv_obj_t * canvas, void * buf, lv_coord_t w, lv_coord_
     ext->dsc.header.h  = h;
     ext->dsc.data      = buf;
 
+    lv_img_cache_invalidate_src(&ext->dsc);
     lv_img_set_src(canvas, &ext->dsc);
 }
 
@@ -164,6 +166,7 @@ void lv_canvas_set_px(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_color_t
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_px_color(&ext->dsc, x, y, c);
+    lv_img_cache_invalidate_src(&ext->dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -184,6 +187,7 @@ void lv_canvas_set_palette(lv_obj_t * canvas, uint8_t id, lv_color_t c)
     lv_canvas_ext_t * ext = lv_obj_get_ext_attr(canvas);
 
     lv_img_buf_set_palette(&ext->dsc, id, c);
+    lv_img_cache_invalidate_src(&ext->dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -256,6 +260,8 @@ void lv_canvas_copy_buf(lv_obj_t * canvas, const void * to_copy, lv_coord_t x, l
         px += ext->dsc.header.w * px_size;
         to_copy8 += w * px_size;
     }
+
+    lv_img_cache_invalidate_src(&ext->dsc);
 }
 
 /**
@@ -361,6 +367,7 @@ void lv_canvas_transform(lv_obj_t * canvas, lv_img_dsc_t * img, int16_t angle, u
         }
     }
 
+    lv_img_cache_invalidate_src(&ext_dst->dsc);
     lv_obj_invalidate(canvas);
 #else
     LV_UNUSED(canvas);
@@ -505,6 +512,7 @@ void lv_canvas_blur_hor(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
             if(has_alpha) asum += opa;
         }
     }
+    lv_img_cache_invalidate_src(&ext->dsc);
     lv_obj_invalidate(canvas);
 
     _lv_mem_buf_release(line_buf);
@@ -644,6 +652,7 @@ void lv_canvas_blur_ver(lv_obj_t * canvas, const lv_area_t * area, uint16_t r)
         }
     }
 
+    lv_img_cache_invalidate_src(&ext->dsc);
     lv_obj_invalidate(canvas);
 
     _lv_mem_buf_release(col_buf);
@@ -681,6 +690,7 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
         }
     }
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -751,6 +761,7 @@ void lv_canvas_draw_rect(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -831,6 +842,7 @@ void lv_canvas_draw_text(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -895,6 +907,7 @@ void lv_canvas_draw_img(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, const voi
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -958,6 +971,7 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t points[], uint32_t
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -1019,6 +1033,7 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t points[], uint32
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
@@ -1083,6 +1098,7 @@ void lv_canvas_draw_arc(lv_obj_t * canvas, lv_coord_t x, lv_coord_t y, lv_coord_
 
     _lv_refr_set_disp_refreshing(refr_ori);
 
+    lv_img_cache_invalidate_src(dsc);
     lv_obj_invalidate(canvas);
 }
 
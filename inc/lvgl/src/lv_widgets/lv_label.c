@@ -30,8 +30,6 @@
 #endif
 
 #define LV_LABEL_DOT_END_INV 0xFFFF
-#define LV_LABEL_HINT_HEIGHT_LIMIT                                                                                     \
-    1024 /*Enable "hint" to buffer info about labels larger than this. (Speed up their drawing)*/
 
 /**********************
  *      TYPEDEFS
@@ -53,6 +51,17 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+static lv_txt_flag_t get_txt_flag(const lv_obj_t * label, const lv_area_t * txt_coords, lv_coord_t * max_w);
+static const lv_draw_label_hint_t * get_line_table(const lv_obj_t * label, const lv_font_t * font,
+                                                   lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
+static uint32_t get_next_line(const lv_draw_label_hint_t * hint, uint32_t line_id, const char * txt, uint32_t line_start,
+                              const lv_font_t * font, lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag);
+static lv_coord_t get_line_width(const lv_draw_label_hint_t * hint, uint32_t line_id, const char * txt, uint32_t length,
+                                 const lv_font_t * font, lv_style_int_t letter_space, lv_txt_flag_t flag);
+static void get_txt_size(const lv_obj_t * label, lv_point_t * size, const lv_draw_label_dsc_t * dsc);
+#if LV_USE_BIDI
+    static bool get_bidi_lines(const lv_obj_t * label, const lv_draw_label_hint_t * hint);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -107,9 +116,7 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->offset.y = 0;
 
 #if LV_LABEL_LONG_TXT_HINT
-    ext->hint.line_start = -1;
-    ext->hint.coord_y    = 0;
-    ext->hint.y          = 0;
+    _lv_memset_00(&ext->hint, sizeof(ext->hint));
 #endif
 
 #if LV_LABEL_TEXT_SEL
@@ -134,6 +141,7 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
         lv_label_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
         lv_label_set_long_mode(new_label, lv_label_get_long_mode(copy));
         lv_label_set_recolor(new_label, lv_label_get_recolor(copy));
+        lv_label_set_cache(new_label, lv_label_get_cache(copy));
         lv_label_set_align(new_label, lv_label_get_align(copy));
         if(copy_ext->static_txt == 0)
             lv_label_set_text(new_label, lv_label_get_text(copy));
@@ -372,6 +380,30 @@ void lv_label_set_recolor(lv_obj_t * label, bool en)
                                   be hidden or revealed*/
 }
 
+/**
+ * Enable pre-rendering the text. It's rendered once into a coverage map and
+ * the redraws only blend the map with the text color.
+ * Useful for labels whose text rarely changes. Scrolling, recolored or selected texts are drawn normally.
+ * The maps share `LV_LABEL_CACHE_SIZE` bytes.
+ * @param label pointer to a label object
+ * @param en true: enable pre-rendering, false: disable
+ */
+void lv_label_set_cache(lv_obj_t * label, bool en)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_LONG_TXT_HINT && LV_LABEL_CACHE_SIZE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->hint.cache_en == en) return;
+
+    _lv_draw_label_hint_invalidate(&ext->hint);
+    ext->hint.cache_en = en == false ? 0 : 1;
+#else
+    (void)label;    /*Unused*/
+    (void)en;       /*Unused*/
+#endif
+}
+
 /**
  * Set the label's animation speed in LV_LABEL_LONG_SROLL/SROLL_CIRC modes
  * @param label pointer to a label object
@@ -496,6 +528,24 @@ bool lv_label_get_recolor(const lv_obj_t * label)
     return ext->recolor == 0 ? false : true;
 }
 
+/**
+ * Get whether the text is pre-rendered
+ * @param label pointer to a label object
+ * @return true: pre-rendering is enabled, false: disabled
+ */
+bool lv_label_get_cache(const lv_obj_t * label)
+{
+    LV_ASSERT_OBJ(label, LV_OBJX_NAME);
+
+#if LV_LABEL_LONG_TXT_HINT && LV_LABEL_CACHE_SIZE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    return ext->hint.cache_en == 0 ? false : true;
+#else
+    (void)label;    /*Unused*/
+    return false;
+#endif
+}
+
 /**
  * Get the label's animation speed in LV_LABEL_LONG_ROLL and SCROLL modes
  * @param label pointer to a label object
@@ -548,34 +598,29 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
 
-    lv_label_ext_t * ext     = lv_obj_get_ext_attr(label);
     uint32_t line_start      = 0;
     uint32_t new_line_start  = 0;
-    lv_coord_t max_w         = lv_area_get_width(&txt_coords);
+    lv_coord_t max_w;
     const lv_font_t * font   = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
     lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
     lv_style_int_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
     lv_coord_t letter_height    = lv_font_get_line_height(font);
     lv_coord_t y             = 0;
-    lv_txt_flag_t flag       = LV_TXT_FLAG_NONE;
-
-    if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
-    if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
-    if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
-
-    if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
-    if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
+    lv_txt_flag_t flag       = get_txt_flag(label, &txt_coords, &max_w);
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
+    const lv_draw_label_hint_t * hint = get_line_table(label, font, letter_space, max_w, flag);
+    uint32_t line_id = 0;
 
     /*Search the line of the index letter */;
     while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+        new_line_start += get_next_line(hint, line_id, txt, line_start, font, letter_space, max_w, flag);
         if(byte_id < new_line_start || txt[new_line_start] == '\0')
             break; /*The line of 'index' letter begins at 'line_start'*/
 
         y += letter_height + line_space;
         line_start = new_line_start;
+        line_id++;
     }
 
     /*If the last character is line break then go to the next line*/
@@ -583,6 +628,7 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
         if((txt[byte_id - 1] == '\n' || txt[byte_id - 1] == '\r') && txt[byte_id] == '\0') {
             y += letter_height + line_space;
             line_start = byte_id;
+            line_id++;
         }
     }
 
@@ -595,6 +641,24 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
         visual_byte_pos = byte_id - line_start;
         bidi_txt =  &txt[line_start];
     }
+    else if(get_bidi_lines(label, hint)) {
+        visual_byte_pos = byte_id - line_start;
+        bidi_txt = &txt[line_start];
+        if(hint->bidi_txt) {
+            /*Find the visual position of the letter. In RTL runs its left side is the end of the next visual letter*/
+            uint32_t line_char_id = _lv_txt_encoded_get_char_id(&txt[line_start], byte_id - line_start);
+            bidi_txt = &hint->bidi_txt[line_start];
+            uint32_t i;
+            for(i = 0; i < new_line_start - line_start; i++) {
+                uint16_t bidi_pos = hint->bidi_pos[line_start + i];
+                if((bidi_pos & ~LV_DRAW_LABEL_BIDI_POS_RTL) == line_char_id) {
+                    visual_byte_pos = i;
+                    if(bidi_pos & LV_DRAW_LABEL_BIDI_POS_RTL) _lv_txt_encoded_next(bidi_txt, &visual_byte_pos);
+                    break;
+                }
+            }
+        }
+    }
     else {
         uint32_t line_char_id = _lv_txt_encoded_get_char_id(&txt[line_start], byte_id - line_start);
 
@@ -615,15 +679,15 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
     lv_coord_t x = _lv_txt_get_width(bidi_txt, visual_byte_pos, font, letter_space, flag);
     if(char_id != line_start) x += letter_space;
 
-    if(align == LV_LABEL_ALIGN_CENTER) {
+    if(flag & LV_TXT_FLAG_CENTER) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        line_w = get_line_width(hint, line_id, bidi_txt, new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
 
     }
-    else if(align == LV_LABEL_ALIGN_RIGHT) {
+    else if(flag & LV_TXT_FLAG_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        line_w = get_line_width(hint, line_id, bidi_txt, new_line_start - line_start, font, letter_space, flag);
 
         x += lv_area_get_width(&txt_coords) - line_w;
     }
@@ -654,30 +718,24 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
     const char * txt         = lv_label_get_text(label);
-    lv_label_ext_t * ext     = lv_obj_get_ext_attr(label);
     uint32_t line_start      = 0;
     uint32_t new_line_start  = 0;
-    lv_coord_t max_w         = lv_area_get_width(&txt_coords);
+    lv_coord_t max_w;
     const lv_font_t * font   = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
     lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
     lv_style_int_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
     lv_coord_t letter_height    = lv_font_get_line_height(font);
     lv_coord_t y             = 0;
-    lv_txt_flag_t flag       = LV_TXT_FLAG_NONE;
+    lv_txt_flag_t flag       = get_txt_flag(label, &txt_coords, &max_w);
     uint32_t logical_pos;
-    char * bidi_txt;
+    const char * bidi_txt;
 
-    if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
-    if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
-    if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
-
-    lv_label_align_t align = lv_label_get_align(label);
-    if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
-    if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
+    const lv_draw_label_hint_t * hint = get_line_table(label, font, letter_space, max_w, flag);
+    uint32_t line_id = 0;
 
     /*Search the line of the index letter */;
     while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+        new_line_start += get_next_line(hint, line_id, txt, line_start, font, letter_space, max_w, flag);
 
         if(pos.y <= y + letter_height) {
             /*The line is found (stored in 'line_start')*/
@@ -691,27 +749,36 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
         y += letter_height + line_space;
 
         line_start = new_line_start;
+        line_id++;
     }
 
 #if LV_USE_BIDI
-    bidi_txt = _lv_mem_buf_get(new_line_start - line_start + 1);
+    char * bidi_buf = NULL;
     uint32_t txt_len = new_line_start - line_start;
     if(new_line_start > 0 && txt[new_line_start - 1] == '\0' && txt_len > 0) txt_len--;
-    _lv_bidi_process_paragraph(txt + line_start, bidi_txt, txt_len, lv_obj_get_base_dir(label), NULL, 0);
+    bool bidi_hint = get_bidi_lines(label, hint);
+    if(bidi_hint) {
+        bidi_txt = hint->bidi_txt ? &hint->bidi_txt[line_start] : &txt[line_start];
+    }
+    else {
+        bidi_buf = _lv_mem_buf_get(new_line_start - line_start + 1);
+        _lv_bidi_process_paragraph(txt + line_start, bidi_buf, txt_len, lv_obj_get_base_dir(label), NULL, 0);
+        bidi_txt = bidi_buf;
+    }
 #else
-    bidi_txt = (char *)txt + line_start;
+    bidi_txt = txt + line_start;
 #endif
 
     /*Calculate the x coordinate*/
     lv_coord_t x = 0;
-    if(align == LV_LABEL_ALIGN_CENTER) {
+    if(flag & LV_TXT_FLAG_CENTER) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        line_w = get_line_width(hint, line_id, bidi_txt, new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
     }
-    else if(align == LV_LABEL_ALIGN_RIGHT) {
+    else if(flag & LV_TXT_FLAG_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+        line_w = get_line_width(hint, line_id, bidi_txt, new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) - line_w;
     }
 
@@ -725,11 +792,11 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
             /* Get the current letter.*/
             uint32_t letter = _lv_txt_encoded_next(bidi_txt, &i);
 
-            /*Get the next letter too for kerning*/
-            uint32_t letter_next = _lv_txt_encoded_next(&bidi_txt[i], NULL);
+            /*Get the next letter too for kerning. Nothing follows the closing '\0' of the last line*/
+            uint32_t letter_next = letter != '\0' ? _lv_txt_encoded_next(&bidi_txt[i], NULL) : 0;
 
             /*Handle the recolor command*/
-            if((flag & LV_TXT_FLAG_RECOLOR) != 0) {
+            if((flag & LV_TXT_FLAG_RECOLOR) != 0 && letter != '\0') {
                 if(_lv_txt_is_cmd(&cmd_state, bidi_txt[i]) != false) {
                     continue; /*Skip the letter is it is part of a command*/
                 }
@@ -754,13 +821,21 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     if(txt[line_start + cid] == '\0') {
         logical_pos = i;
     }
+    else if(bidi_hint) {
+        logical_pos = cid;
+        if(hint->bidi_pos) {
+            uint16_t bidi_pos = hint->bidi_pos[line_start + i];
+            logical_pos = bidi_pos & ~LV_DRAW_LABEL_BIDI_POS_RTL;
+            if(bidi_pos & LV_DRAW_LABEL_BIDI_POS_RTL) logical_pos++;
+        }
+    }
     else {
         bool is_rtl;
         logical_pos = _lv_bidi_get_logical_pos(&txt[line_start], NULL,
                                                txt_len, lv_obj_get_base_dir(label), cid, &is_rtl);
         if(is_rtl) logical_pos++;
-        _lv_mem_buf_release(bidi_txt);
     }
+    if(bidi_buf) _lv_mem_buf_release(bidi_buf);
 #else
     logical_pos = _lv_txt_encoded_get_char_id(bidi_txt, i);
 #endif
@@ -819,44 +894,41 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
     lv_area_t txt_coords;
     get_txt_coords(label, &txt_coords);
     const char * txt         = lv_label_get_text(label);
-    lv_label_ext_t * ext     = lv_obj_get_ext_attr(label);
     uint32_t line_start      = 0;
     uint32_t new_line_start  = 0;
-    lv_coord_t max_w         = lv_area_get_width(&txt_coords);
+    lv_coord_t max_w;
     const lv_font_t * font   = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
     lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
     lv_style_int_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
     lv_coord_t letter_height    = lv_font_get_line_height(font);
     lv_coord_t y             = 0;
-    lv_txt_flag_t flag       = LV_TXT_FLAG_NONE;
-    lv_label_align_t align = lv_label_get_align(label);
+    lv_txt_flag_t flag       = get_txt_flag(label, &txt_coords, &max_w);
 
-    if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
-    if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
-    if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
-    if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
+    const lv_draw_label_hint_t * hint = get_line_table(label, font, letter_space, max_w, flag);
+    uint32_t line_id = 0;
 
     /*Search the line of the index letter */;
     while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+        new_line_start += get_next_line(hint, line_id, txt, line_start, font, letter_space, max_w, flag);
 
         if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
         y += letter_height + line_space;
 
         line_start = new_line_start;
+        line_id++;
     }
 
     /*Calculate the x coordinate*/
     lv_coord_t x      = 0;
     lv_coord_t last_x = 0;
-    if(align == LV_LABEL_ALIGN_CENTER) {
+    if(flag & LV_TXT_FLAG_CENTER) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
+        line_w = get_line_width(hint, line_id, &txt[line_start], new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
     }
-    else if(align == LV_LABEL_ALIGN_RIGHT) {
+    else if(flag & LV_TXT_FLAG_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
+        line_w = get_line_width(hint, line_id, &txt[line_start], new_line_start - line_start, font, letter_space, flag);
         x += lv_area_get_width(&txt_coords) - line_w;
     }
 
@@ -996,7 +1068,7 @@ void lv_label_refr_text(lv_obj_t * label)
 
     if(ext->text == NULL) return;
 #if LV_LABEL_LONG_TXT_HINT
-    ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
+    _lv_draw_label_hint_invalidate(&ext->hint); /*The line table is invalid if the text changes*/
 #endif
 
     lv_area_t txt_coords;
@@ -1006,6 +1078,9 @@ void lv_label_refr_text(lv_obj_t * label)
     lv_style_int_t line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
     lv_style_int_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
 
+    /*Read the glyphs of the fonts loaded from files now to not wait for them while drawing*/
+    lv_font_prefetch(font, ext->text);
+
     /*Calc. the height and longest line*/
     lv_point_t size;
     lv_txt_flag_t flag = LV_TXT_FLAG_NONE;
@@ -1256,6 +1331,11 @@ void lv_label_refr_text(lv_obj_t * label)
         /*Do nothing*/
     }
 
+#if LV_LABEL_LONG_TXT_HINT
+    /*The dots might have been written into the text*/
+    if(ext->long_mode == LV_LABEL_LONG_DOT) _lv_draw_label_hint_invalidate(&ext->hint);
+#endif
+
     lv_obj_invalidate(label);
 }
 
@@ -1303,15 +1383,6 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         bool is_common = _lv_area_intersect(&txt_clip, clip_area, &txt_coords);
         if(!is_common) return LV_DESIGN_RES_OK;
 
-        lv_label_align_t align = lv_label_get_align(label);
-
-        lv_txt_flag_t flag = LV_TXT_FLAG_NONE;
-        if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
-        if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
-        if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
-        if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
-        if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
-
         lv_draw_label_dsc_t label_draw_dsc;
         lv_draw_label_dsc_init(&label_draw_dsc);
 
@@ -1319,26 +1390,11 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         label_draw_dsc.sel_end = lv_label_get_text_sel_end(label);
         label_draw_dsc.ofs_x = ext->offset.x;
         label_draw_dsc.ofs_y = ext->offset.y;
-        label_draw_dsc.flag = flag;
+        label_draw_dsc.flag = get_txt_flag(label, &txt_coords, NULL);
         lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_draw_dsc);
 
-        /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
-         * (In addition they will result misalignment is this case)*/
-        if((ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) &&
-           (ext->align == LV_LABEL_ALIGN_CENTER || ext->align == LV_LABEL_ALIGN_RIGHT)) {
-            lv_point_t size;
-            _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                             LV_COORD_MAX, flag);
-            if(size.x > lv_area_get_width(&txt_coords)) {
-                label_draw_dsc.flag &= ~LV_TXT_FLAG_RIGHT;
-                label_draw_dsc.flag &= ~LV_TXT_FLAG_CENTER;
-            }
-        }
 #if LV_LABEL_LONG_TXT_HINT
         lv_draw_label_hint_t * hint = &ext->hint;
-        if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
-            hint = NULL;
-
 #else
         /*Just for compatibility*/
         lv_draw_label_hint_t * hint = NULL;
@@ -1348,8 +1404,7 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
 
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
             lv_point_t size;
-            _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                             LV_COORD_MAX, flag);
+            get_txt_size(label, &size, &label_draw_dsc);
 
             /*Draw the text again next to the original to make an circular effect */
             if(size.x > lv_area_get_width(&txt_coords)) {
@@ -1403,6 +1458,9 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LONG_TXT_HINT
+        _lv_draw_label_hint_invalidate(&ext->hint);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
@@ -1538,4 +1596,172 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+
+/**
+ * Get the text flags a label is drawn with.
+ * The letter queries use them too to find the same lines as the drawing and reuse its line table.
+ * @param label pointer to a label object
+ * @param txt_coords the area of the text from `get_txt_coords`
+ * @param max_w store the max. width of the lines here (can be NULL)
+ * @return the flags from the 'txt_flag_t' enum
+ */
+static lv_txt_flag_t get_txt_flag(const lv_obj_t * label, const lv_area_t * txt_coords, lv_coord_t * max_w)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    lv_label_align_t align = lv_label_get_align(label);
+
+    lv_txt_flag_t flag = LV_TXT_FLAG_NONE;
+    if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
+    if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
+    if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
+    if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
+    if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
+
+    /*The width `lv_draw_label` wraps the lines at*/
+    if(max_w) *max_w = (flag & LV_TXT_FLAG_EXPAND) ? LV_COORD_MAX : lv_area_get_width(txt_coords);
+
+    /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
+     * (In addition they will result misalignment is this case)*/
+    if((ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) &&
+       (flag & (LV_TXT_FLAG_CENTER | LV_TXT_FLAG_RIGHT))) {
+        lv_draw_label_dsc_t dsc;
+        lv_draw_label_dsc_init(&dsc);
+        dsc.font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+        dsc.letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
+        dsc.line_space = lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN);
+        dsc.flag = flag;
+
+        lv_point_t size;
+        get_txt_size(label, &size, &dsc);
+        if(size.x > lv_area_get_width(txt_coords)) {
+            flag &= ~LV_TXT_FLAG_RIGHT;
+            flag &= ~LV_TXT_FLAG_CENTER;
+        }
+    }
+
+    return flag;
+}
+
+/**
+ * Get the line table of a label's text
+ * @param label pointer to a label object
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w max. width of the lines
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return pointer to the up to date line table or NULL if it's not available
+ */
+static const lv_draw_label_hint_t * get_line_table(const lv_obj_t * label, const lv_font_t * font,
+                                                   lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+#if LV_LABEL_LONG_TXT_HINT
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->text == NULL) return NULL;
+    if(_lv_draw_label_hint_update(&ext->hint, ext->text, font, letter_space, max_w, flag) == false) return NULL;
+
+    return &ext->hint;
+#else
+    (void)label;        /*Unused*/
+    (void)font;         /*Unused*/
+    (void)letter_space; /*Unused*/
+    (void)max_w;        /*Unused*/
+    (void)flag;         /*Unused*/
+    return NULL;
+#endif
+}
+
+/**
+ * Get the length of a line. Read it from the line table if available else measure the text.
+ * @param hint the line table from `get_line_table` or NULL
+ * @param line_id index of the line
+ * @param txt the text
+ * @param line_start byte index of the start of the line
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w max. width of the lines
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return length of the line in bytes
+ */
+static uint32_t get_next_line(const lv_draw_label_hint_t * hint, uint32_t line_id, const char * txt, uint32_t line_start,
+                              const lv_font_t * font, lv_style_int_t letter_space, lv_coord_t max_w, lv_txt_flag_t flag)
+{
+    if(hint && line_id < hint->line_cnt) return hint->lines[line_id + 1].start - line_start;
+
+    return _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+}
+
+/**
+ * Get the width of a line. Read it from the line table if available else measure the text.
+ * @param hint the line table from `get_line_table` or NULL
+ * @param line_id index of the line
+ * @param txt start of the line
+ * @param length length of the line in bytes
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return width of the line
+ */
+static lv_coord_t get_line_width(const lv_draw_label_hint_t * hint, uint32_t line_id, const char * txt, uint32_t length,
+                                 const lv_font_t * font, lv_style_int_t letter_space, lv_txt_flag_t flag)
+{
+    if(hint && line_id <= hint->line_cnt) return hint->lines[line_id].width;
+
+    return _lv_txt_get_width(txt, length, font, letter_space, flag);
+}
+
+#if LV_USE_BIDI
+/**
+ * Get the lines of a label's text in visual order
+ * @param label pointer to a label object
+ * @param hint the line table from `get_line_table` or NULL
+ * @return true: `bidi_txt` and `bidi_pos` of `hint` can be used
+ */
+static bool get_bidi_lines(const lv_obj_t * label, const lv_draw_label_hint_t * hint)
+{
+#if LV_LABEL_LONG_TXT_HINT
+    if(hint == NULL) return false;
+
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    return _lv_draw_label_hint_update_bidi(&ext->hint, lv_obj_get_base_dir(label));
+#else
+    (void)label;    /*Unused*/
+    (void)hint;     /*Unused*/
+    return false;
+#endif
+}
+#endif
+
+/**
+ * Get the size of a label's text without limiting its width. Use the line table if possible.
+ * @param label pointer to a label object
+ * @param size store the result here
+ * @param dsc the draw descriptor of the label
+ */
+static void get_txt_size(const lv_obj_t * label, lv_point_t * size, const lv_draw_label_dsc_t * dsc)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+
+    /*Without wrapping the table has the same lines as an unlimited width would give*/
+    const lv_draw_label_hint_t * hint = NULL;
+    if(dsc->flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) {
+        hint = get_line_table(label, dsc->font, dsc->letter_space, LV_COORD_MAX, dsc->flag);
+    }
+
+    if(hint == NULL) {
+        _lv_txt_get_size(size, ext->text, dsc->font, dsc->letter_space, dsc->line_space, LV_COORD_MAX, dsc->flag);
+        return;
+    }
+
+    lv_coord_t letter_height = lv_font_get_line_height(dsc->font);
+    uint32_t line_cnt = hint->line_cnt;
+
+    /*One line taller if the last character is '\n' or '\r'*/
+    uint32_t end = hint->lines[line_cnt].start;
+    if(end != 0 && (ext->text[end - 1] == '\n' || ext->text[end - 1] == '\r')) line_cnt++;
+
+    size->x = hint->max_line_w;
+    if(line_cnt == 0) size->y = letter_height;
+    else size->y = (lv_coord_t)(line_cnt * (letter_height + dsc->line_space) - dsc->line_space);
+}
+
 #endif
@@ -81,7 +81,7 @@ typedef struct {
     lv_point_t offset; /*Text draw position offset*/
 
 #if LV_LABEL_LONG_TXT_HINT
-    lv_draw_label_hint_t hint; /*Used to buffer info about large text*/
+    lv_draw_label_hint_t hint; /*Line table of the text to not measure it on every redraw*/
 #endif
 
 #if LV_LABEL_TEXT_SEL
@@ -166,6 +166,16 @@ void lv_label_set_align(lv_obj_t * label, lv_label_align_t align);
  */
 void lv_label_set_recolor(lv_obj_t * label, bool en);
 
+/**
+ * Enable pre-rendering the text. It's rendered once into a coverage map and
+ * the redraws only blend the map with the text color.
+ * Useful for labels whose text rarely changes. Scrolling, recolored or selected texts are drawn normally.
+ * The maps share `LV_LABEL_CACHE_SIZE` bytes.
+ * @param label pointer to a label object
+ * @param en true: enable pre-rendering, false: disable
+ */
+void lv_label_set_cache(lv_obj_t * label, bool en);
+
 /**
  * Set the label's animation speed in LV_LABEL_LONG_SROLL/SROLL_CIRC modes
  * @param label pointer to a label object
@@ -218,6 +228,13 @@ lv_label_align_t lv_label_get_align(const lv_obj_t * label);
  */
 bool lv_label_get_recolor(const lv_obj_t * label);
 
+/**
+ * Get whether the text is pre-rendered
+ * @param label pointer to a label object
+ * @return true: pre-rendering is enabled, false: disabled
+ */
+bool lv_label_get_cache(const lv_obj_t * label);
+
 /**
  * Get the label's animation speed in LV_LABEL_LONG_ROLL and SCROLL modes
  * @param label pointer to a label object
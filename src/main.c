@@ -322,6 +322,7 @@ static int filepicker_add_entries(void *p)
 				 c->w - (lv_obj_get_width_margin(img) * 4));
 		lv_label_set_text(label, c->namelist[c->entries_added]->d_name);
 		lv_label_set_long_mode(label, LV_LABEL_LONG_CROP);
+		lv_label_set_cache(label, true);
 		lv_obj_set_click(label, false);
 
 		lv_obj_set_event_cb(list_btn, event_cb);
@@ -539,6 +540,7 @@ static void recreate_filepicker(void *p)
 		lv_obj_set_width(label, c->w - (lv_obj_get_width_margin(img) * 4));
 		lv_label_set_text(label, c->namelist[c->entries_added]->d_name);
 		lv_label_set_long_mode(label, LV_LABEL_LONG_CROP);
+		lv_label_set_cache(label, true);
 		lv_obj_set_click(label, false);
 
 		lv_obj_set_event_cb(list_btn, event_cb);
@@ -641,6 +643,7 @@ static void create_bottom_ui(struct ui_ctx *ui)
 			btn = lv_btn_create(toolbar, NULL);
 			btn_lbl = lv_label_create(btn, NULL);
 			lv_label_set_text(btn_lbl, LV_SYMBOL_UP);
+			lv_label_set_cache(btn_lbl, true);
 			lv_obj_set_size(btn, toolbar_h, toolbar_h);
 			lv_obj_set_event_cb(btn, btnev_updir);
 			lv_obj_set_user_data(btn, ui);
@@ -648,6 +651,7 @@ static void create_bottom_ui(struct ui_ctx *ui)
 			btn = lv_btn_create(toolbar, NULL);
 			btn_lbl = lv_label_create(btn, NULL);
 			lv_label_set_text(btn_lbl, LV_SYMBOL_PLUS);
+			lv_label_set_cache(btn_lbl, true);
 			lv_obj_set_size(btn, toolbar_h, toolbar_h);
 			//lv_obj_set_event_cb(btn, btnev_updir);
 			lv_obj_set_user_data(btn, ui);
@@ -655,6 +659,7 @@ static void create_bottom_ui(struct ui_ctx *ui)
 			btn = lv_btn_create(toolbar, NULL);
 			btn_lbl = lv_label_create(btn, NULL);
 			lv_label_set_text(btn_lbl, LV_SYMBOL_PLAY);
+			lv_label_set_cache(btn_lbl, true);
 			lv_obj_set_size(btn, toolbar_h, toolbar_h);
 			//lv_obj_set_event_cb(btn, btnev_updir);
 			lv_obj_set_user_data(btn, ui);
@@ -690,6 +695,7 @@ static void create_bottom_ui(struct ui_ctx *ui)
 		lv_obj_align(quit_btn, tab_system, LV_ALIGN_IN_TOP_MID, 0, 0);
 		quit_lbl = lv_label_create(quit_btn, NULL);
 		lv_label_set_text(quit_lbl, "Quit");
+		lv_label_set_cache(quit_lbl, true);
 	}
 
 	return;
@@ -0,0 +1,425 @@
+/**
+ * Copyright (c) 2021 Mahyar Koshkouei
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ * THIS SOFTWARE IS PROVIDED 'AS-IS', WITHOUT ANY EXPRESS OR IMPLIED WARRANTY.
+ * IN NO EVENT WILL THE AUTHORS BE HELD LIABLE FOR ANY DAMAGES ARISING FROM THE
+ * USE OF THIS SOFTWARE.
+ */
+
+/**
+ * Reorders the glyph records of an LVGL binary font (as made by lv_font_conv
+ * with --format bin) so that the glyphs used most often in a sample text come
+ * first, packed into as few pages as possible. Fonts loaded with
+ * lv_font_load_lazy() read the glyphs in LV_FONT_LAZY_PAGE_SIZE pages, so a
+ * screen of common CJK text then needs a handful of pages instead of one page
+ * per letter. A record never straddles a page boundary unless it is larger
+ * than a page. The glyph ids, cmaps and kerning are unchanged.
+ *
+ * Usage: font_freq_sort [-p page_size] input.bin sample.txt output.bin
+ */
+
+#include <lvgl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Offset of index_to_loc_format in the "head" table. */
+#define HEAD_LOC_FORMAT	(8 + 26)
+#define MAX_LETTER	0x110000
+
+struct table {
+	const uint8_t *data;	/* Including the length and the label. */
+	uint32_t len;
+};
+
+struct glyph {
+	uint32_t ofs;
+	uint32_t len;
+	uint32_t count;		/* Use of the glyph in the sample text. */
+	uint32_t id;
+};
+
+static uint32_t rd_le16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t rd_le32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wr_le32(uint8_t *p, uint32_t v)
+{
+	p[0] = v & 0xFF;
+	p[1] = (v >> 8) & 0xFF;
+	p[2] = (v >> 16) & 0xFF;
+	p[3] = v >> 24;
+}
+
+static uint8_t *read_file(const char *path, size_t *len)
+{
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long sz;
+
+	if (f == NULL)
+		return NULL;
+
+	if (fseek(f, 0, SEEK_END) == 0 && (sz = ftell(f)) >= 0 &&
+	    fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(sz + 1);
+		if (data != NULL && fread(data, 1, sz, f) != (size_t)sz) {
+			free(data);
+			data = NULL;
+		}
+		*len = sz;
+	}
+
+	fclose(f);
+	return data;
+}
+
+static int get_table(const uint8_t *font, size_t font_len, size_t *pos,
+		     const char *label, struct table *t)
+{
+	if (*pos + 8 > font_len)
+		return -1;
+
+	t->data = font + *pos;
+	t->len = rd_le32(t->data);
+	if (memcmp(t->data + 4, label, 4) != 0 || t->len < 8 ||
+	    t->len > font_len - *pos) {
+		fprintf(stderr, "Bad '%s' table\n", label);
+		return -1;
+	}
+
+	*pos += t->len;
+	return 0;
+}
+
+/**
+ * Get the glyph id of a letter from the cmaps like lv_font_fmt_txt.c.
+ * Returns 0 if the font has no glyph for the letter.
+ */
+static uint32_t cmap_lookup(const struct table *cmap, uint32_t letter)
+{
+	const uint8_t *sub = cmap->data + 12;
+	uint32_t cnt = rd_le32(cmap->data + 8);
+	uint32_t i;
+
+	for (i = 0; i < cnt; i++, sub += 16) {
+		const uint8_t *data = cmap->data + rd_le32(sub);
+		uint32_t start = rd_le32(sub + 4);
+		uint32_t range = rd_le16(sub + 8);
+		uint32_t gid_start = rd_le16(sub + 10);
+		uint32_t entries = rd_le16(sub + 12);
+		uint32_t rcp = letter - start;
+		uint32_t k;
+
+		if (letter < start || rcp >= range)
+			continue;
+
+		switch (sub[14]) {
+		case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+			return gid_start + rcp;
+		case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+			return rcp < entries ? gid_start + data[rcp] : 0;
+		case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+		case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+			for (k = 0; k < entries; k++) {
+				if (rd_le16(data + k * 2) != rcp)
+					continue;
+				if (sub[14] == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY)
+					return gid_start + k;
+				return gid_start +
+				       rd_le16(data + entries * 2 + k * 2);
+			}
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* Decode the next UTF-8 letter. Invalid bytes are taken as Latin-1. */
+static uint32_t utf8_next(const uint8_t *s, size_t len, size_t *i)
+{
+	uint32_t c = s[(*i)++];
+	unsigned n = 0;
+
+	if ((c & 0xE0) == 0xC0) {
+		n = 1;
+		c &= 0x1F;
+	} else if ((c & 0xF0) == 0xE0) {
+		n = 2;
+		c &= 0x0F;
+	} else if ((c & 0xF8) == 0xF0) {
+		n = 3;
+		c &= 0x07;
+	}
+
+	if (*i + n > len)
+		return s[*i - 1];
+
+	while (n--) {
+		if ((s[*i] & 0xC0) != 0x80)
+			return s[*i - 1];
+		c = (c << 6) | (s[(*i)++] & 0x3F);
+	}
+
+	return c;
+}
+
+static int cmp_ofs(const void *a, const void *b)
+{
+	const struct glyph *ga = a, *gb = b;
+
+	return ga->ofs < gb->ofs ? -1 : ga->ofs > gb->ofs;
+}
+
+/* The most used glyphs first, then the unused ones in glyph id order. */
+static int cmp_count(const void *a, const void *b)
+{
+	const struct glyph *ga = a, *gb = b;
+
+	if (ga->count != gb->count)
+		return ga->count > gb->count ? -1 : 1;
+
+	return ga->id < gb->id ? -1 : ga->id > gb->id;
+}
+
+/* Number of pages holding the used glyphs. */
+static uint32_t count_pages(const struct glyph *g, uint32_t n,
+			    uint32_t page_size)
+{
+	uint32_t pages = 0;
+	uint32_t last = UINT32_MAX;
+	uint32_t i;
+
+	/* The glyphs are sorted by offset. */
+	for (i = 0; i < n; i++) {
+		uint32_t first, end;
+
+		if (g[i].count == 0 || g[i].len == 0)
+			continue;
+
+		first = g[i].ofs / page_size;
+		end = (g[i].ofs + g[i].len - 1) / page_size;
+		pages += end - first + 1 - (first == last);
+		last = end;
+	}
+
+	return pages;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t page_size = LV_FONT_LAZY_PAGE_SIZE;
+	struct table head, cmap, loca, glyf;
+	uint32_t *counts;
+	struct glyph *g;
+	uint8_t *font, *sample, *out;
+	size_t font_len, sample_len, pos = 0, i;
+	uint32_t n, loc_format, glyf_len, loca_len, used = 0;
+	uint32_t pages_before, pages_after, k;
+	int argi = 1;
+	FILE *f;
+
+	if (argc == 6 && strcmp(argv[1], "-p") == 0) {
+		page_size = strtoul(argv[2], NULL, 0);
+		argi = 3;
+	}
+
+	if (argc - argi != 3 || page_size == 0) {
+		fprintf(stderr,
+			"Usage: %s [-p page_size] input.bin sample.txt output.bin\n",
+			argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	font = read_file(argv[argi], &font_len);
+	sample = read_file(argv[argi + 1], &sample_len);
+	if (font == NULL || sample == NULL) {
+		fprintf(stderr, "Unable to read '%s'\n",
+			font == NULL ? argv[argi] : argv[argi + 1]);
+		return EXIT_FAILURE;
+	}
+
+	if (get_table(font, font_len, &pos, "head", &head) != 0 ||
+	    head.len <= HEAD_LOC_FORMAT ||
+	    get_table(font, font_len, &pos, "cmap", &cmap) != 0 ||
+	    get_table(font, font_len, &pos, "loca", &loca) != 0 ||
+	    get_table(font, font_len, &pos, "glyf", &glyf) != 0)
+		return EXIT_FAILURE;
+
+	/* The kerning and anything after it is copied as is. */
+	loc_format = head.data[HEAD_LOC_FORMAT];
+	n = rd_le32(loca.data + 8);
+	if (loc_format > 1 || 12 + (uint64_t)n * (loc_format ? 4 : 2) > loca.len) {
+		fprintf(stderr, "Bad 'loca' table\n");
+		return EXIT_FAILURE;
+	}
+
+	g = calloc(n + 1, sizeof(*g));
+	counts = calloc(MAX_LETTER, sizeof(*counts));
+	if (g == NULL || counts == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return EXIT_FAILURE;
+	}
+
+	for (k = 0; k < n; k++) {
+		g[k].id = k;
+		g[k].ofs = loc_format ? rd_le32(loca.data + 12 + k * 4) :
+					rd_le16(loca.data + 12 + k * 2);
+		if (g[k].ofs < 8 || g[k].ofs > glyf.len) {
+			fprintf(stderr, "Bad offset of glyph %u\n", k);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* A record ends where the next one starts in the file. */
+	qsort(g, n, sizeof(*g), cmp_ofs);
+	for (k = 0; k < n; k++) {
+		uint32_t end = glyf.len;
+		uint32_t j;
+
+		for (j = k + 1; j < n; j++) {
+			if (g[j].ofs > g[k].ofs) {
+				end = g[j].ofs;
+				break;
+			}
+		}
+		g[k].len = end - g[k].ofs;
+	}
+
+	/* Count the glyphs of the sample text. */
+	for (i = 0; i < sample_len;) {
+		uint32_t c = utf8_next(sample, sample_len, &i);
+
+		if (c < MAX_LETTER)
+			counts[c]++;
+	}
+
+	{
+		uint32_t *gid_counts = calloc(n, sizeof(*gid_counts));
+		uint32_t c;
+
+		if (gid_counts == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			return EXIT_FAILURE;
+		}
+
+		for (c = 0; c < MAX_LETTER; c++) {
+			uint32_t gid;
+
+			if (counts[c] == 0)
+				continue;
+			gid = cmap_lookup(&cmap, c);
+			if (gid != 0 && gid < n)
+				gid_counts[gid] += counts[c];
+		}
+
+		for (k = 0; k < n; k++) {
+			g[k].count = gid_counts[g[k].id];
+			if (g[k].count)
+				used++;
+		}
+
+		free(gid_counts);
+	}
+
+	pages_before = count_pages(g, n, page_size);
+
+	/* Lay out the records in the new order. */
+	qsort(g, n, sizeof(*g), cmp_count);
+	out = malloc(font_len + (size_t)n * (page_size + 4) + 16);
+	if (out == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return EXIT_FAILURE;
+	}
+
+	{
+		uint8_t *glyf_out = out + head.len + cmap.len;
+		uint32_t ofs = 8;
+		uint32_t *new_ofs = calloc(n, sizeof(*new_ofs));
+
+		if (new_ofs == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			return EXIT_FAILURE;
+		}
+
+		/* Place the glyph table after the largest possible loca. */
+		glyf_out += 12 + n * 4;
+		for (k = 0; k < n; k++) {
+			uint32_t in_page = ofs % page_size;
+
+			if (g[k].len <= page_size &&
+			    in_page + g[k].len > page_size) {
+				memset(glyf_out + ofs, 0, page_size - in_page);
+				ofs += page_size - in_page;
+			}
+
+			memcpy(glyf_out + ofs, glyf.data + g[k].ofs, g[k].len);
+			new_ofs[g[k].id] = ofs;
+			g[k].ofs = ofs;
+			ofs += g[k].len;
+		}
+		glyf_len = ofs;
+
+		loc_format = glyf_len > 0xFFFF ? 1 : loc_format;
+		loca_len = 12 + n * (loc_format ? 4 : 2);
+
+		/* head and cmap are unchanged, except the loca format. */
+		memcpy(out, head.data, head.len);
+		out[HEAD_LOC_FORMAT] = loc_format;
+		memcpy(out + head.len, cmap.data, cmap.len);
+
+		pos = head.len + cmap.len;
+		wr_le32(out + pos, loca_len);
+		memcpy(out + pos + 4, "loca", 4);
+		wr_le32(out + pos + 8, n);
+		for (k = 0; k < n; k++) {
+			if (loc_format) {
+				wr_le32(out + pos + 12 + k * 4, new_ofs[k]);
+			} else {
+				out[pos + 12 + k * 2] = new_ofs[k] & 0xFF;
+				out[pos + 13 + k * 2] = new_ofs[k] >> 8;
+			}
+		}
+		pos += loca_len;
+
+		memmove(out + pos, glyf_out, glyf_len);
+		wr_le32(out + pos, glyf_len);
+		memcpy(out + pos + 4, "glyf", 4);
+		pos += glyf_len;
+
+		i = (glyf.data + glyf.len) - font;
+		memcpy(out + pos, font + i, font_len - i);
+		pos += font_len - i;
+
+		free(new_ofs);
+	}
+
+	qsort(g, n, sizeof(*g), cmp_ofs);
+	pages_after = count_pages(g, n, page_size);
+
+	f = fopen(argv[argi + 2], "wb");
+	if (f == NULL || fwrite(out, 1, pos, f) != pos || fclose(f) != 0) {
+		fprintf(stderr, "Unable to write '%s'\n", argv[argi + 2]);
+		return EXIT_FAILURE;
+	}
+
+	printf("%s: %u glyphs, %u used by the sample, %u -> %u pages of %u bytes, %zu -> %zu bytes\n",
+	       argv[argi], n, used, pages_before, pages_after, page_size,
+	       font_len, pos);
+
+	free(out);
+	free(counts);
+	free(g);
+	free(sample);
+	free(font);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,335 @@
+/**
+ * Copyright (c) 2021 Mahyar Koshkouei
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted.
+ * THIS SOFTWARE IS PROVIDED 'AS-IS', WITHOUT ANY EXPRESS OR IMPLIED WARRANTY.
+ * IN NO EVENT WILL THE AUTHORS BE HELD LIABLE FOR ANY DAMAGES ARISING FROM THE
+ * USE OF THIS SOFTWARE.
+ */
+
+/**
+ * Converts a PNG image to the RLE image format of lv_img_rle.h, either as a
+ * "*.rle" file or as a C array with an lv_img_dsc_t to compile into the
+ * application. The image is decoded with the PNG decoder of LVGL, so the
+ * tool must be built with the same lv_conf.h as the application.
+ *
+ * Usage: img_rle_conv input.png output.rle|output.c
+ */
+
+#include <ctype.h>
+#include <lvgl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !LV_USE_PNG || !LV_USE_RLE
+# error "img_rle_conv requires LV_USE_PNG and LV_USE_RLE in lv_conf.h"
+#endif
+
+/* Shortest runs worth a run packet. */
+#define MIN_RUN_COLOR	2
+#define MIN_RUN_ALPHA	3
+#define MAX_PACKET	(LV_IMG_RLE_RUN)
+
+struct out_buf {
+	uint8_t *data;
+	size_t len;
+	size_t cap;
+};
+
+static void out_put(struct out_buf *o, const void *src, size_t len)
+{
+	if (o->len + len > o->cap) {
+		o->cap = (o->len + len) * 2;
+		o->data = realloc(o->data, o->cap);
+		if (o->data == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	memcpy(o->data + o->len, src, len);
+	o->len += len;
+}
+
+static void out_u8(struct out_buf *o, uint8_t v)
+{
+	out_put(o, &v, 1);
+}
+
+static void out_le16(struct out_buf *o, uint16_t v)
+{
+	out_u8(o, v & 0xFF);
+	out_u8(o, v >> 8);
+}
+
+static void out_le32_at(struct out_buf *o, size_t at, uint32_t v)
+{
+	o->data[at + 0] = v & 0xFF;
+	o->data[at + 1] = (v >> 8) & 0xFF;
+	o->data[at + 2] = (v >> 16) & 0xFF;
+	o->data[at + 3] = v >> 24;
+}
+
+/**
+ * Encode a plane of a row as packets. Values shorter than `min_run` are kept
+ * in literal packets.
+ */
+static void encode_plane(struct out_buf *o, const uint8_t *v, unsigned n,
+			 unsigned size, unsigned min_run)
+{
+	unsigned lit = 0;
+	unsigned i = 0;
+
+	while (i < n) {
+		unsigned run = 1;
+
+		while (i + run < n && run < MAX_PACKET &&
+		       memcmp(v + (i + run) * size, v + i * size, size) == 0)
+			run++;
+
+		if (run < min_run) {
+			i++;
+			if (i - lit == MAX_PACKET) {
+				out_u8(o, MAX_PACKET - 1);
+				out_put(o, v + lit * size, MAX_PACKET * size);
+				lit = i;
+			}
+			continue;
+		}
+
+		if (lit < i) {
+			out_u8(o, i - lit - 1);
+			out_put(o, v + lit * size, (i - lit) * size);
+		}
+
+		out_u8(o, LV_IMG_RLE_RUN | (run - 1));
+		out_put(o, v + i * size, size);
+		i += run;
+		lit = i;
+	}
+
+	if (lit < n) {
+		out_u8(o, n - lit - 1);
+		out_put(o, v + lit * size, (n - lit) * size);
+	}
+}
+
+static void encode_image(struct out_buf *o, const lv_img_decoder_dsc_t *dsc)
+{
+	const unsigned w = dsc->header.w;
+	const unsigned h = dsc->header.h;
+	const uint8_t *img = dsc->img_data;
+	unsigned px_size = sizeof(lv_color_t);
+	uint8_t has_alpha = 0;
+	lv_color_t *colors;
+	uint8_t *opas;
+	size_t table;
+
+	if (dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+		unsigned i;
+
+		px_size = LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+		/* Drop the alpha plane of fully opaque images. */
+		for (i = 0; i < w * h; i++) {
+			if (img[i * px_size + px_size - 1] != LV_OPA_COVER) {
+				has_alpha = 1;
+				break;
+			}
+		}
+	}
+
+	out_put(o, LV_IMG_RLE_MAGIC, 4);
+	out_le16(o, w);
+	out_le16(o, h);
+	out_u8(o, LV_COLOR_DEPTH);
+	out_u8(o, (has_alpha ? LV_IMG_RLE_FLAG_ALPHA : 0) |
+		  (LV_COLOR_16_SWAP ? LV_IMG_RLE_FLAG_SWAP : 0));
+	out_le16(o, 0);
+
+	table = o->len;
+	for (unsigned y = 0; y <= h; y++)
+		out_put(o, "\0\0\0\0", 4);
+
+	colors = malloc(w * sizeof(lv_color_t));
+	opas = malloc(w);
+	if (colors == NULL || opas == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (unsigned y = 0; y < h; y++) {
+		const uint8_t *row = img + (size_t)y * w * px_size;
+
+		out_le32_at(o, table + y * 4, o->len);
+
+		for (unsigned x = 0; x < w; x++) {
+			memcpy(&colors[x], row + x * px_size,
+			       sizeof(lv_color_t));
+			opas[x] = has_alpha ? row[x * px_size + px_size - 1] :
+					      LV_OPA_COVER;
+#if LV_COLOR_DEPTH == 32
+			colors[x].ch.alpha = 0xFF;
+#endif
+			/* The color of invisible pixels doesn't matter, so
+			 * continue the previous run. */
+			if (opas[x] == LV_OPA_TRANSP && x > 0)
+				colors[x] = colors[x - 1];
+		}
+
+		encode_plane(o, (const uint8_t *)colors, w,
+			     sizeof(lv_color_t), MIN_RUN_COLOR);
+		if (has_alpha)
+			encode_plane(o, opas, w, 1, MIN_RUN_ALPHA);
+	}
+
+	out_le32_at(o, table + h * 4, o->len);
+
+	free(colors);
+	free(opas);
+}
+
+static int write_c_array(const char *path, const struct out_buf *o,
+			 const lv_img_header_t *header)
+{
+	char name[64];
+	const char *base = strrchr(path, '/');
+	unsigned n = 0;
+	FILE *f;
+
+	base = base != NULL ? base + 1 : path;
+	for (; *base != '\0' && *base != '.' && n < sizeof(name) - 1; base++)
+		name[n++] = isalnum((unsigned char)*base) ? *base : '_';
+	name[n] = '\0';
+
+	f = fopen(path, "w");
+	if (f == NULL)
+		return -1;
+
+	fprintf(f, "#include <lvgl.h>\n\n");
+	fprintf(f, "/* RLE image for LV_COLOR_DEPTH %d, LV_COLOR_16_SWAP %d. */\n",
+		LV_COLOR_DEPTH, LV_COLOR_16_SWAP);
+	fprintf(f, "static const uint8_t %s_map[] = {", name);
+	for (size_t i = 0; i < o->len; i++)
+		fprintf(f, "%s0x%02x,", i % 16 ? " " : "\n\t", o->data[i]);
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "const lv_img_dsc_t %s = {\n", name);
+	fprintf(f, "\t.header.always_zero = 0,\n");
+	fprintf(f, "\t.header.w = %u,\n", (unsigned)header->w);
+	fprintf(f, "\t.header.h = %u,\n", (unsigned)header->h);
+	fprintf(f, "\t.header.cf = %s,\n",
+		o->data[9] & LV_IMG_RLE_FLAG_ALPHA ? "LV_IMG_CF_RAW_ALPHA" :
+						     "LV_IMG_CF_RAW");
+	fprintf(f, "\t.data_size = %zu,\n", o->len);
+	fprintf(f, "\t.data = %s_map,\n", name);
+	fprintf(f, "};\n");
+
+	return fclose(f) == 0 ? 0 : -1;
+}
+
+static int write_bin(const char *path, const struct out_buf *o)
+{
+	FILE *f = fopen(path, "wb");
+	size_t wr;
+
+	if (f == NULL)
+		return -1;
+
+	wr = fwrite(o->data, 1, o->len, f);
+	if (fclose(f) != 0 || wr != o->len)
+		return -1;
+
+	return 0;
+}
+
+static uint8_t *read_file(const char *path, size_t *len)
+{
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long sz;
+
+	if (f == NULL)
+		return NULL;
+
+	if (fseek(f, 0, SEEK_END) == 0 && (sz = ftell(f)) > 0 &&
+	    fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(sz);
+		if (data != NULL && fread(data, 1, sz, f) != (size_t)sz) {
+			free(data);
+			data = NULL;
+		}
+		*len = sz;
+	}
+
+	fclose(f);
+	return data;
+}
+
+int main(int argc, char *argv[])
+{
+	lv_img_decoder_dsc_t dsc;
+	lv_img_dsc_t src;
+	struct out_buf o = { 0 };
+	const char *ext;
+	size_t in_len;
+	uint8_t *in;
+	uint32_t raw_size;
+	int ret;
+
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s input.png output.rle|output.c\n",
+			argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	in = read_file(argv[1], &in_len);
+	if (in == NULL) {
+		fprintf(stderr, "Unable to read '%s'\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	lv_init();
+	/* Let the PNG decoder decode the whole image. */
+	lv_img_cache_set_mem_size(0);
+
+	memset(&src, 0, sizeof(src));
+	src.header.cf = LV_IMG_CF_RAW_ALPHA;
+	src.data = in;
+	src.data_size = in_len;
+
+	if (lv_img_decoder_open(&dsc, &src, LV_COLOR_BLACK) != LV_RES_OK ||
+	    dsc.img_data == NULL ||
+	    (dsc.header.cf != LV_IMG_CF_TRUE_COLOR &&
+	     dsc.header.cf != LV_IMG_CF_TRUE_COLOR_ALPHA)) {
+		fprintf(stderr, "Unable to decode '%s'\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	encode_image(&o, &dsc);
+	raw_size = lv_img_buf_get_img_size(dsc.header.w, dsc.header.h,
+					   dsc.header.cf);
+
+	ext = strrchr(argv[2], '.');
+	if (ext != NULL && strcmp(ext, ".c") == 0)
+		ret = write_c_array(argv[2], &o, &dsc.header);
+	else
+		ret = write_bin(argv[2], &o);
+
+	if (ret != 0) {
+		fprintf(stderr, "Unable to write '%s'\n", argv[2]);
+		return EXIT_FAILURE;
+	}
+
+	printf("%s: %ux%u, %zu bytes PNG, %u bytes decoded, %zu bytes RLE (%u%%)\n",
+	       argv[1], (unsigned)dsc.header.w, (unsigned)dsc.header.h, in_len,
+	       (unsigned)raw_size, o.len,
+	       (unsigned)(o.len * 100 / raw_size));
+
+	lv_img_decoder_close(&dsc);
+	free(o.data);
+	free(in);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,6 @@
+/**
+ * Defines the font of lv_conf.h for the host tools. The application defines it
+ * by including the header in its sources.
+ */
+
+#include <noto_sans_14_common.h>